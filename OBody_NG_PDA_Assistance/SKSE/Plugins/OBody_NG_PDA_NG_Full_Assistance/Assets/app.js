@@ -10088,6 +10088,33 @@ window.addEventListener('DOMContentLoaded', () => {
         currentPollingPlugin = null;
     }
 
+    // Act2_Manager.json lists each faction once in faction_dictionary and actors reference it by id
+    function expandFactionReferences(data) {
+        const dictionary = {};
+        (data?.faction_dictionary || []).forEach(entry => {
+            dictionary[entry.id] = entry;
+        });
+
+        const expand = actor => {
+            if (!actor || !Array.isArray(actor.factions)) return;
+            actor.factions = actor.factions.map(ref => {
+                const entry = dictionary[ref.id];
+                if (!entry) return ref;
+                return {
+                    name: entry.name,
+                    editor_id: entry.editor_id,
+                    form_id: entry.form_id,
+                    rank: ref.rank,
+                    is_member: true
+                };
+            });
+        };
+
+        expand(data?.player);
+        (data?.npcs || []).forEach(expand);
+        return data;
+    }
+
     function loadAct2Json() {
         const viewer = document.getElementById('act2Display');
         if (!viewer) return Promise.resolve();
@@ -10099,7 +10126,7 @@ window.addEventListener('DOMContentLoaded', () => {
             .then(response => response.json())
             .then(data => {
                 if (data.status === 'success') {
-                    const jsonData = JSON.parse(data.content || '{}');
+                    const jsonData = expandFactionReferences(JSON.parse(data.content || '{}'));
                     displayAct2Data(jsonData);
                     const act2Search = document.getElementById('act2Search');
                     if (act2Search) {
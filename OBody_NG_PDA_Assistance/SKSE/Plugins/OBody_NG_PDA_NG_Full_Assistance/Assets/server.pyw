@@ -19,11 +19,13 @@ import zipfile
 import mimetypes
 import urllib.request
 import ctypes
+import mmap
+import struct
 
 ASSETS_DIR = Path(__file__).resolve().parent
 LOG_DIR = ASSETS_DIR / 'log'
 SERVER_ERRORS_LOG = LOG_DIR / 'server_errors.log'
-SKYRIM_SWITCH_LOG = LOG_DIR / 'SkyrimSwitch.log'
+SKYRIM_SWITCH_HEARTBEAT = LOG_DIR / 'SkyrimSwitch.heartbeat'
 
 class ThreadedTCPServer(socketserver.ThreadingMixIn, socketserver.TCPServer):
     pass
@@ -851,7 +853,11 @@ _port_from_json = _get_port_from_port_json()
 ensure_port_master_json(_port_from_json if _port_from_json is not None else PORT)
 shutdown_flag = False
 game_log_active = False
-MAX_LOG_LINES = 1000000
+
+# Bloque de heartbeat que el plugin ACT2 actualiza en memoria (HeartbeatBlock en plugin.cpp)
+HEARTBEAT_FORMAT = struct.Struct('<8sIIQqIIII')
+HEARTBEAT_MAGIC = b'OBPDAHB1'
+HEARTBEAT_MIN_TIMEOUT = 6
 
 # Variables globales para monitorear tiempos de start
 npc_tracking_start_time = None
@@ -1643,95 +1649,102 @@ except Exception as e:
 restore_from_manager_mcm_if_requested()
 create_backup_folders()
 
-def count_log_lines(file_path):
+def open_heartbeat(file_path):
+    """Mapea el heartbeat en solo lectura; None mientras el plugin no lo haya creado"""
     try:
-        with open(file_path, 'r', encoding='utf-8', errors='ignore') as f:
-            return sum(1 for _ in f)
-    except Exception as e:
-        log_error(f"ERROR counting lines: {e}")
-        return 0
+        with open(file_path, 'rb') as f:
+            if os.fstat(f.fileno()).st_size < HEARTBEAT_FORMAT.size:
+                return None
+            return mmap.mmap(f.fileno(), HEARTBEAT_FORMAT.size, access=mmap.ACCESS_READ)
+    except (OSError, ValueError):
+        return None
+
+def read_heartbeat(view):
+    """Devuelve (sequence, unix_time_ms, game_state, health, interval_ms) o None si el bloque no es valido.
+    El contador es impar mientras el plugin escribe; se reintenta hasta leer el mismo valor par dos veces."""
+    for _ in range(10):
+        magic, _version, _size, sequence, unix_time_ms, game_state, health, _pid, interval_ms = HEARTBEAT_FORMAT.unpack_from(view, 0)
+        if magic != HEARTBEAT_MAGIC:
+            return None
+        if sequence % 2 == 0 and HEARTBEAT_FORMAT.unpack_from(view, 0)[3] == sequence:
+            return sequence, unix_time_ms, game_state, health, interval_ms
+        time.sleep(0.001)
+    return None
 
 def check_game_log():
     global shutdown_flag, game_log_active
     
     try:
         log_error("=== DEAD MAN SWITCH THREAD STARTED ===")
-        log_file = SKYRIM_SWITCH_LOG
-        log_error(f"Looking for: {log_file.absolute()}")
+        heartbeat_file = SKYRIM_SWITCH_HEARTBEAT
+        log_error(f"Looking for: {heartbeat_file.absolute()}")
         
-        # FASE 1: Esperar indefinidamente hasta que el log EXISTA
+        # FASE 1: Esperar indefinidamente hasta que el heartbeat EXISTA
+        view = None
         while not shutdown_flag:
-            if not log_file.exists():
+            view = open_heartbeat(heartbeat_file)
+            if view is None:
                 time.sleep(5)
                 continue
             else:
-                log_error("File exists - Starting monitoring")
+                log_error("Heartbeat mapped - Starting monitoring")
                 break
         
-        # FASE 2: Monitorear indefinidamente hasta detectar ACTIVIDAD
-        log_error("Waiting for log activity...")
-        last_modified = 0
+        # FASE 2: Monitorear indefinidamente hasta que el contador se MUEVA
+        # (un bloque de una sesion anterior se queda quieto)
+        log_error("Waiting for heartbeat activity...")
+        last_sequence = None
+        beat = None
         
         while not shutdown_flag:
             try:
-                current_modified = log_file.stat().st_mtime
+                beat = read_heartbeat(view)
                 
-                if last_modified == 0:
-                    last_modified = current_modified
-                    time.sleep(5)
-                    continue
-                
-                if current_modified != last_modified:
-                    log_error(f"ACTIVITY DETECTED! File modified at {datetime.fromtimestamp(current_modified)}")
+                if beat is None:
+                    pass
+                elif last_sequence is None:
+                    last_sequence = beat[0]
+                elif beat[0] != last_sequence:
+                    log_error(f"ACTIVITY DETECTED! Heartbeat {beat[0]} at {datetime.fromtimestamp(beat[1] / 1000)}")
                     break
-                else:
-                    time.sleep(5)
+                time.sleep(1)
                     
             except Exception as e:
                 log_error(f"ERROR checking for activity: {e}")
                 time.sleep(5)
         
+        if shutdown_flag:
+            return
+        
         # FASE 3: Dead Man Switch ACTIVADO - monitoreo activo
         log_error("*** DEAD MAN SWITCH ACTIVATED ***")
         game_log_active = True
-        last_modified = log_file.stat().st_mtime
+        last_sequence = beat[0]
+        interval_ms = beat[4]
         last_update_time = time.time()
-        last_line_count = count_log_lines(log_file)
-        log_error(f"Active monitoring started - {last_line_count} lines")
+        log_error(f"Active monitoring started - sequence {last_sequence}, game state {beat[2]}, interval {interval_ms} ms")
         
         while not shutdown_flag:
             time.sleep(1)
             
             try:
-                current_modified = log_file.stat().st_mtime
-                current_lines = count_log_lines(log_file)
-                
-                if current_lines > MAX_LOG_LINES:
-                    log_error(f"CRITICAL: Log exceeded {MAX_LOG_LINES} lines ({current_lines})")
-                    log_error("SHUTTING DOWN SERVER")
-                    shutdown_flag = True
-                    os._exit(0)
-                
-                if current_lines - last_line_count > 10000:
-                    log_error(f"CRITICAL: Abnormal growth {current_lines - last_line_count} lines/sec")
-                    log_error("SHUTTING DOWN SERVER")
-                    shutdown_flag = True
-                    os._exit(0)
+                beat = read_heartbeat(view)
+                closed = False
                 
-                if current_modified != last_modified:
-                    last_modified = current_modified
+                if beat is not None and beat[0] != last_sequence:
+                    last_sequence = beat[0]
+                    interval_ms = beat[4]
                     last_update_time = time.time()
-                    last_line_count = current_lines
-                    # log_error("SKYRIM IS ACTIVE")  # Removido para reducir logs excesivos
                 else:
                     elapsed = time.time() - last_update_time
-
-                    if elapsed > 6:
-                        log_error("SKYRIM HAS CLOSED - WAITING 3 SECONDS BEFORE SHUTTING DOWN SERVER")
-                        time.sleep(3)
-                        log_error("SHUTTING DOWN SERVER NOW")
-                        shutdown_flag = True
-                        os._exit(0)
+                    closed = elapsed > max(HEARTBEAT_MIN_TIMEOUT, 3 * interval_ms / 1000)
+                
+                if closed:
+                    log_error("SKYRIM HAS CLOSED - WAITING 3 SECONDS BEFORE SHUTTING DOWN SERVER")
+                    time.sleep(3)
+                    log_error("SHUTTING DOWN SERVER NOW")
+                    shutdown_flag = True
+                    os._exit(0)
                         
             except Exception as e:
                 log_error(f"ERROR in monitoring loop: {e}")
@@ -3837,8 +3850,16 @@ EnableSave = false
             faction_ids = set()
             name_by_editor = {}
 
+            # Actors reference factions by id into the shared faction_dictionary block
+            faction_dictionary = {}
+            for entry in manager_data.get('faction_dictionary', []):
+                faction_dictionary[entry.get('id')] = entry
+
+            def resolve_faction(faction):
+                return faction_dictionary.get(faction.get('id'), faction)
+
             player = manager_data.get('player', {})
-            player_factions = player.get('factions', [])
+            player_factions = [resolve_faction(f) for f in player.get('factions', [])]
             for faction in player_factions:
                 editor_id = str(faction.get('editor_id', '')).strip()
                 name = str(faction.get('name', '')).strip()
@@ -3848,7 +3869,7 @@ EnableSave = false
                         name_by_editor[editor_id] = name
 
             for npc in manager_data.get('npcs', []):
-                npc_factions = npc.get('factions', [])
+                npc_factions = [resolve_faction(f) for f in npc.get('factions', [])]
                 for faction in npc_factions:
                     editor_id = str(faction.get('editor_id', '')).strip()
                     name = str(faction.get('name', '')).strip()
@@ -7,22 +7,62 @@
 #include <shellapi.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <charconv>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
 #include <ctime>
+#include <cwctype>
 #include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <numeric>
+#include <optional>
+#include <queue>
 #include <sstream>
+#include <stdexcept>
+#include <stop_token>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 #include <set>
 
+#include "Act2ManagerConfig.h"
+#include "CatalogDiff.h"
+#include "DistanceRings.h"
+#include "EquipmentSlots.h"
+#include "FactionDictionary.h"
+#include "FileWatchService.h"
+#include "FormCatalog.h"
+#include "FrameBudgetScheduler.h"
+#include "Heartbeat.h"
+#include "IniDocument.h"
+#include "LiveEquipmentTable.h"
+#include "NPCFilter.h"
+#include "ParallelForPool.h"
+#include "PluginFilterList.h"
+#include "SpatialGridIndex.h"
+#include "TaskScheduler.h"
+#include "WorkerThread.h"
+
 #pragma comment(lib, "shell32.lib")
 
 namespace fs = std::filesystem;
@@ -53,24 +93,6 @@ struct OBodyPDAPathsResult {
           scriptFound(false) {}
 };
 
-struct FactionData {
-    std::string name;
-    std::string editorID;
-    RE::FormID formID;
-    int rank;
-    bool isMember;
-};
-
-struct EquippedItemData {
-    bool equipped;
-    std::string name;
-    RE::FormID formID;
-    std::string pluginName;
-    int slot;
-    
-    EquippedItemData() : equipped(false), formID(0), slot(-1) {}
-};
-
 struct NPCData {
     std::string name;
     std::string editorID;
@@ -79,48 +101,14 @@ struct NPCData {
     std::string gender;
     bool isVampire;
     bool isWerewolf;
+    std::uint32_t actorFlags;
     RE::FormID refID;
     RE::FormID baseID;
     RE::FormID formID;
-    std::vector<FactionData> factions;
+    RE::FormID cellID;
+    FactionMembership factions;
     float distanceFromPlayer;
-    std::unordered_map<std::string, EquippedItemData> equippedItems;
-};
-
-struct NPCTrackingConfig {
-    bool start;
-    int radio;
-    std::time_t lastModified;
-};
-
-struct OutfitItemData {
-    std::string name;
-    RE::FormID formID;
-};
-
-struct PluginItemData {
-    std::string name;
-    RE::FormID formID;
-};
-
-struct PluginOutfitData {
-    std::string name;
-    RE::FormID formID;
-    std::vector<OutfitItemData> items;
-};
-
-struct PluginOutfitsData {
-    std::string pluginName;
-    std::vector<PluginItemData> armors;
-    std::vector<PluginOutfitData> outfits;
-    std::vector<PluginItemData> weapons;
-};
-
-struct PluginOutfitsConfig {
-    bool start;
-    bool pluginList;
-    std::time_t lastModified;
-    std::time_t lastPluginListModified;
+    EquippedItems equippedItems;
 };
 
 struct PluginCountData {
@@ -149,12 +137,6 @@ struct PluginNPCCountData {
     int npcCount;
 };
 
-struct PluginNPCsConfig {
-    bool startNPCs;
-    bool pluginListNPCs;
-    std::time_t lastModified;
-};
-
 struct PluginLectorData {
     std::string pluginName;
     std::string idString;
@@ -167,6 +149,12 @@ struct PluginLectorData {
     PluginLectorData() : hasNPCs(false), hasArmors(false), hasOutfits(false), hasWeapons(false) {}
 };
 
+// MCM.ini values, staged here so the atomics below only change once per load
+struct PDASettings {
+    bool startupSound;
+    bool topNotifications;
+};
+
 static std::ofstream g_advancedLog;
 static std::deque<std::string> g_logLines;
 static std::string g_documentsPath;
@@ -176,7 +164,6 @@ static std::mutex g_logMutex;
 static std::atomic<bool> g_isShuttingDown(false);
 static std::atomic<bool> g_processActive(false);
 static std::atomic<bool> g_monitoringActive(false);
-static std::thread g_monitorThread;
 static int g_monitorCycles = 0;
 static std::unordered_set<std::string> g_processedLines;
 static size_t g_lastFileSize = 0;
@@ -189,47 +176,75 @@ static bool g_activationMessageShown = false;
 
 static std::atomic<bool> g_startupSoundEnabled(true);
 static std::atomic<bool> g_topNotificationsVisible(true);
-static std::time_t g_lastIniCheckTime = 0;
+static PDASettings g_pdaSettings = {true, true};
+static std::mutex g_pdaSettingsMutex;
 static fs::path g_iniPath;
-static std::thread g_iniMonitorThread;
 static std::atomic<bool> g_monitoringIni(false);
 
 static bool g_usingDllPath = false;
 static fs::path g_dllDirectory;
 static fs::path g_scriptsDirectory;
 
-static NPCTrackingConfig g_npcTrackingConfig;
+static NPCTrackingConfig g_npcTrackingConfig = {false, 3000, 0, false, 2000, 128.0f, 0, "", ""};
 static fs::path g_npcTrackingIniPath;
 static fs::path g_npcTrackingJsonPath;
-static std::thread g_npcTrackingThread;
+static fs::path g_npcTrackingStreamPath;
 static std::atomic<bool> g_monitoringNPCTracking(false);
 static std::mutex g_npcTrackingMutex;
-static std::time_t g_lastNPCIniCheckTime = 0;
+static std::atomic<bool> g_npcTrackingIniChanged(false);
 
-static std::thread g_skyrimSwitchThread;
 static std::atomic<bool> g_monitoringSkyrimSwitch(false);
-static std::deque<std::string> g_skyrimSwitchLines;
-static std::mutex g_skyrimSwitchMutex;
-static fs::path g_skyrimSwitchLogPath;
+static fs::path g_skyrimSwitchPath;
 
 static PluginOutfitsConfig g_pluginOutfitsConfig;
 static fs::path g_pluginOutfitsJsonPath;
 static fs::path g_pluginListJsonPath;
 static fs::path g_pluginFilterIniPath;
-static std::unordered_map<std::string, bool> g_pluginFilterMap;
 static std::mutex g_pluginFilterMutex;
 
 static PluginNPCsConfig g_pluginNPCsConfig;
 static fs::path g_npcCountJsonPath;
 static fs::path g_npcListJsonPath;
 static fs::path g_npcFilterIniPath;
-static std::unordered_map<std::string, bool> g_npcFilterMap;
 static std::mutex g_npcFilterMutex;
 
 // ===== NEW GLOBALS FOR PLUGIN LECTOR SYSTEM =====
 static fs::path g_pluginsLectorLogPath;
 static fs::path g_pluginsLectorJsonPath;
 
+// ===== MAIN THREAD SCHEDULER GLOBALS =====
+static SchedulerConfig g_schedulerConfig = {0.5};
+static std::thread::id g_mainThreadId;
+
+// ===== CATALOG DIFF GLOBALS =====
+static fs::path g_catalogSnapshotPath;
+static fs::path g_catalogDiffJsonPath;
+static std::atomic<bool> g_catalogDiffStarted(false);
+
+// ===== FACTION DICTIONARY GLOBALS =====
+static fs::path g_factionCsvPath;
+
+// ===== ACTOR PREDICATE GLOBALS =====
+static fs::path g_actorPredicatesIniPath;
+
+// ===== SIGHTING HISTORY GLOBALS =====
+static HistoryConfig g_historyConfig = {true, 60, "none", ""};
+static FilterConfig g_filterConfig = {"any", "", "", false, 0.0f};
+static fs::path g_historyLogPath;
+static fs::path g_historyJsonPath;
+
+// ===== HEARTBEAT GLOBALS =====
+static HeartbeatRegion g_skyrimSwitchHeartbeat;
+static std::atomic<HeartbeatGameState> g_heartbeatGameState(HeartbeatGameState::kStarting);
+
+// ===== CONFIG SNAPSHOT GLOBALS =====
+// The config globals above are the loader's staging copies, only touched under
+// g_npcTrackingMutex; everything else reads the last published snapshot
+static Act2ManagerConfigSnapshot g_act2ManagerConfig(Act2ManagerConfig{
+    g_npcTrackingConfig, g_pluginOutfitsConfig, g_pluginNPCsConfig, g_schedulerConfig, g_historyConfig, g_filterConfig});
+
+class FormCatalog;
+
 void StartMonitoringThread();
 void StopMonitoringThread();
 bool LoadPDASettings();
@@ -246,31 +261,32 @@ bool SaveNPCTrackingConfig();
 void StartNPCTrackingMonitoring();
 void StopNPCTrackingMonitoring();
 void ExecuteNPCTracking();
-void ExportNPCDataToJSON(const std::vector<NPCData>& npcList, const NPCData& playerData);
-std::vector<NPCData> ScanNPCsAroundPlayer(float radius);
+struct FactionQueryResult;
+void ExportNPCDataToJSON(const std::vector<NPCData>& npcList, const NPCData& playerData, const std::vector<DistanceRing>& rings,
+                         const FactionQueryResult& factionQuery);
+std::vector<NPCData> ScanNPCsAroundPlayer(float radius, size_t maxResults = 0, std::vector<DistanceRing>* rings = nullptr);
 NPCData CapturePlayerData();
-NPCData CaptureNPCData(RE::Actor* actor, RE::NiPoint3 playerPos);
-std::vector<FactionData> GetActorFactions(RE::Actor* actor);
-bool IsDLCInstalled(const std::string& dlcName);
-bool IsActorVampire(RE::Actor* actor);
-bool IsActorWerewolf(RE::Actor* actor);
-std::string GetPluginNameFromFormID(RE::FormID formID);
+FactionMembership GetActorFactions(RE::Actor* actor);
+void BuildFactionDictionary();
+void BuildActorPredicates();
+void ApplyActorFlags(NPCData& npcData, std::uint32_t flags);
 void StartSkyrimSwitchMonitoring();
 void StopSkyrimSwitchMonitoring();
-void SkyrimSwitchThreadFunction();
-EquippedItemData GetEquippedItemInSlot(RE::Actor* actor, int slot);
-std::unordered_map<std::string, EquippedItemData> GetAllEquippedItems(RE::Actor* actor);
+void WriteSkyrimSwitchHeartbeat();
+std::uint32_t CurrentHeartbeatHealth();
+EquippedItemData MakeEquippedItemData(RE::TESForm* equippedForm, int slot);
+std::string EscapeJSONString(std::string_view text);
+EquippedItems GetAllEquippedItems(RE::Actor* actor);
 bool LoadPluginOutfitsConfig();
 bool SavePluginOutfitsConfig();
 void ExecutePluginOutfitsScanning();
 void ExecutePluginListScanning();
-std::vector<PluginOutfitsData> ScanAllPluginsForItems();
-std::vector<PluginOutfitsData> ScanFilteredPluginsForItems();
-void ExportPluginOutfitsToJSON(const std::vector<PluginOutfitsData>& pluginData);
+std::unique_ptr<FormCatalog> ScanAllPluginsForItems();
+std::unique_ptr<FormCatalog> ScanFilteredPluginsForItems();
+void ExportPluginOutfitsToJSON(FormCatalog& catalog);
 std::vector<PluginCountData> ScanAllPluginsForCounts();
 void ExportPluginListToJSON(const std::vector<PluginCountData>& pluginCounts);
 bool LoadPluginFilterList();
-std::vector<OutfitItemData> GetOutfitItems(RE::BGSOutfit* outfit);
 std::vector<PluginNPCCountData> ScanAllPluginsForNPCCount();
 std::vector<PluginNPCListData> ScanFilteredPluginsForNPCList();
 void ExportNPCCountToJSON(const std::vector<PluginNPCCountData>& npcCounts);
@@ -279,6 +295,80 @@ void ExecuteNPCCountScanning();
 void ExecuteNPCListScanning();
 bool LoadNPCFilterList();
 void ExecutePluginLectorScanning();
+bool RunOnMainThreadBudgeted(std::function<bool()> step, const std::string& label);
+
+// ===== FRAME-BUDGETED MAIN THREAD SCHEDULER =====
+// FrameBudgetScheduler.h slices main-thread jobs; in the game its queue is SKSE's task interface.
+
+class SKSETaskQueue : public MainThreadQueue {
+public:
+    bool Post(std::function<void()> task) override {
+        auto* taskInterface = SKSE::GetTaskInterface();
+        if (!taskInterface) return false;
+
+        taskInterface->AddTask(std::move(task));
+        return true;
+    }
+};
+
+static SKSETaskQueue g_skseTaskQueue;
+static FrameBudgetScheduler g_mainThreadScheduler(g_skseTaskQueue);
+
+// Runs the step to completion on the main thread and blocks the calling worker until it
+// is done. Called from the main thread itself, the step simply runs inline.
+bool RunOnMainThreadBudgeted(std::function<bool()> step, const std::string& label) {
+    if (std::this_thread::get_id() == g_mainThreadId) {
+        while (step()) {
+        }
+        return true;
+    }
+
+    auto job = g_mainThreadScheduler.Submit(std::move(step));
+    // Stopping the worker thread that waits here cancels the job straight away
+    const auto stop = WorkerThread::CurrentStopToken();
+    std::stop_callback cancelOnStop(stop, [&job] { job->Cancel(); });
+
+    while (!job->Wait(std::chrono::milliseconds(100))) {
+        if (g_isShuttingDown.load()) {
+            job->Cancel();
+            WriteToAdvancedLog("Main thread job cancelled by shutdown: " + label, __LINE__);
+            return false;
+        }
+    }
+    if (stop.stop_requested() && !job->Succeeded()) {
+        WriteToAdvancedLog("Main thread job cancelled by thread stop: " + label, __LINE__);
+        return false;
+    }
+
+    if (!job->Succeeded()) {
+        WriteToAdvancedLog("ERROR: Main thread job failed (" + label + "): " + job->Error(), __LINE__);
+        return false;
+    }
+
+    auto stats = job->Stats();
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "Main thread job '" << label << "' finished: " << stats.steps << " steps over " << stats.frames
+       << " frames, " << stats.totalMs << " ms on main thread, longest slice " << stats.longestSliceMs << " ms";
+    WriteToAdvancedLog(ss.str(), __LINE__);
+    return true;
+}
+
+template <class T, class Fn>
+bool ForEachFormOnMainThread(Fn&& visit, const std::string& label) {
+    auto* dataHandler = RE::TESDataHandler::GetSingleton();
+    if (!dataHandler) return false;
+
+    auto& forms = dataHandler->GetFormArray<T>();
+    std::uint32_t index = 0;
+
+    return RunOnMainThreadBudgeted([&]() {
+        if (index >= forms.size()) return false;
+        auto* form = forms[index++];
+        if (form) visit(form);
+        return index < forms.size();
+    }, label);
+}
 
 void ShowGameNotification(const std::string& message) {
     if (g_topNotificationsVisible.load()) {
@@ -612,6 +702,11 @@ void WriteToAdvancedLog(const std::string& message, int lineNumber) {
     }
 }
 
+constexpr IniSchema kPDASettingsSchema(std::to_array<IniField>({
+    {"Advanced_Manager", "Startup", &g_pdaSettings.startupSound, "true"},
+    {"Top Notifications", "Visible", &g_pdaSettings.topNotifications, "true"},
+}));
+
 bool LoadPDASettings() {
     try {
         if (g_iniPath.empty()) {
@@ -626,51 +721,18 @@ bool LoadPDASettings() {
             return false;
         }
 
-        std::ifstream iniFile(g_iniPath);
-        if (!iniFile.is_open()) {
+        IniDocument ini;
+        if (!ini.Load(g_iniPath)) {
             logger::error("Could not open INI file");
             return false;
         }
 
-        std::string line;
-        std::string currentSection;
-        bool newStartupSound = g_startupSoundEnabled.load();
-        bool newTopNotifications = g_topNotificationsVisible.load();
-
-        while (std::getline(iniFile, line)) {
-            line.erase(0, line.find_first_not_of(" \t\r\n"));
-            line.erase(line.find_last_not_of(" \t\r\n") + 1);
-
-            if (line.empty() || line[0] == ';' || line[0] == '#') {
-                continue;
-            }
-
-            if (line[0] == '[' && line[line.length() - 1] == ']') {
-                currentSection = line.substr(1, line.length() - 2);
-                continue;
-            }
-
-            size_t equalPos = line.find('=');
-            if (equalPos != std::string::npos) {
-                std::string key = line.substr(0, equalPos);
-                std::string value = line.substr(equalPos + 1);
-
-                key.erase(0, key.find_first_not_of(" \t"));
-                key.erase(key.find_last_not_of(" \t") + 1);
-                value.erase(0, value.find_first_not_of(" \t"));
-                value.erase(value.find_last_not_of(" \t") + 1);
-
-                if (currentSection == "Advanced_Manager" && key == "Startup") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    newStartupSound = (value == "true" || value == "1" || value == "yes");
-                } else if (currentSection == "Top Notifications" && key == "Visible") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    newTopNotifications = (value == "true" || value == "1" || value == "yes");
-                }
-            }
-        }
-
-        iniFile.close();
+        std::unique_lock<std::mutex> settingsLock(g_pdaSettingsMutex);
+        g_pdaSettings = {g_startupSoundEnabled.load(), g_topNotificationsVisible.load()};
+        kPDASettingsSchema.Apply(ini, "MCM.ini");
+        bool newStartupSound = g_pdaSettings.startupSound;
+        bool newTopNotifications = g_pdaSettings.topNotifications;
+        settingsLock.unlock();
 
         bool startupChanged = (newStartupSound != g_startupSoundEnabled.load());
         bool notificationsChanged = (newTopNotifications != g_topNotificationsVisible.load());
@@ -715,35 +777,33 @@ bool ModifyINIValue(const std::string& newValue) {
             return false;
         }
 
-        std::ifstream fileIn(g_iniPath);
-        if (!fileIn.is_open()) {
+        IniDocument ini;
+        if (!ini.Load(g_iniPath)) {
             logger::error("Could not open INI file for reading");
             return false;
         }
 
-        std::string content((std::istreambuf_iterator<char>(fileIn)), 
-                           std::istreambuf_iterator<char>());
-        fileIn.close();
-
-        size_t pos = content.find("Advanced_Manager = ");
-        if (pos != std::string::npos) {
-            size_t lineEnd = content.find('\n', pos);
-            if (lineEnd == std::string::npos) lineEnd = content.length();
-            
-            std::string newLine = "Advanced_Manager = " + newValue;
-            content.replace(pos, lineEnd - pos, newLine);
-        } else {
+        // The key may sit in any section; the first one that has it is edited
+        const IniDocument::Section* target = nullptr;
+        for (const auto& section : ini.Sections()) {
+            if (ini.Get(section.name, "Advanced_Manager")) {
+                target = &section;
+                break;
+            }
+        }
+        if (!target) {
             logger::error("Advanced_Manager entry not found in INI");
             return false;
         }
 
-        std::ofstream fileOut(g_iniPath);
-        if (!fileOut.is_open()) {
-            logger::error("Could not open INI file for writing");
+        if (ini.Set(target->name, "Advanced_Manager", newValue) == IniDocument::EditResult::kUnchanged) {
+            WriteToAdvancedLog("INI already has Advanced_Manager = " + newValue + ", not rewritten", __LINE__);
+            return true;
+        }
+        if (!ini.Save(g_iniPath)) {
+            logger::error("Could not write INI file");
             return false;
         }
-        fileOut << content;
-        fileOut.close();
 
         logger::info("INI modified: Advanced_Manager = {}", newValue);
         WriteToAdvancedLog("INI modified: Advanced_Manager = " + newValue, __LINE__);
@@ -754,45 +814,30 @@ bool ModifyINIValue(const std::string& newValue) {
     }
 }
 
-void IniMonitorThreadFunction() {
-    logger::info("INI monitoring thread started");
-
-    while (g_monitoringIni.load() && !g_isShuttingDown.load()) {
-        try {
-            if (fs::exists(g_iniPath)) {
-                auto currentModTime = fs::last_write_time(g_iniPath);
-                auto currentModTimeT = std::chrono::system_clock::to_time_t(
-                    std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-                        currentModTime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()));
-
-                if (currentModTimeT > g_lastIniCheckTime) {
-                    WriteToAdvancedLog("INI file changed, reloading settings...", __LINE__);
-                    LoadPDASettings();
-                    g_lastIniCheckTime = currentModTimeT;
-                }
-            }
-        } catch (...) {
-        }
+static FileWatchService g_fileWatcher;
+static TaskScheduler g_scheduler;
 
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-    }
+// Runs on the file watcher thread once MCM.ini has settled
+void OnIniFileChanged() {
+    if (!fs::exists(g_iniPath)) return;
+    if (!IniDocument::ContentChanged(g_iniPath)) return;
 
-    logger::info("INI monitoring thread stopped");
+    WriteToAdvancedLog("INI file changed, reloading settings...", __LINE__);
+    LoadPDASettings();
 }
 
 void StartIniMonitoring() {
     if (!g_monitoringIni.load()) {
         g_monitoringIni = true;
-        g_iniMonitorThread = std::thread(IniMonitorThreadFunction);
+        IniDocument::AcknowledgeContent(g_iniPath);
+        g_fileWatcher.Watch(g_iniPath, kFileWatchDebounce, OnIniFileChanged);
     }
 }
 
 void StopIniMonitoring() {
     if (g_monitoringIni.load()) {
         g_monitoringIni = false;
-        if (g_iniMonitorThread.joinable()) {
-            g_iniMonitorThread.join();
-        }
+        g_fileWatcher.Unwatch(g_iniPath);
     }
 }
 
@@ -943,207 +988,444 @@ std::string GetGamePath() {
     }
 }
 
-bool IsDLCInstalled(const std::string& dlcName) {
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (!dataHandler) return false;
+// ===== ACTOR CLASSIFICATION PREDICATES =====
+// Each [section] of Act2_Predicates.ini is one actor flag (vampire, werewolf, follower, ...).
+// The forms a flag refers to are looked up once at kDataLoaded; scans then only compare
+// FormIDs and walk already-resolved faction and keyword pointers, for a whole batch of actors
+// under a single lock. An actor gets a flag when any listed class, race, faction or keyword applies.
+
+constexpr size_t kMaxActorPredicates = 32;
+
+static const char* const kDefaultActorPredicatesIni =
+    "; Actor classification flags, read when game data finishes loading.\n"
+    "; Each [section] is one flag; an actor has it when any listed form applies:\n"
+    ";   class   = actor base class\n"
+    ";   race    = actor race\n"
+    ";   faction = faction membership\n"
+    ";   keyword = keyword on the actor, its base or its race\n"
+    "; Forms are Plugin.esp|0xLocalFormID, several separated by commas. Up to 32 flags.\n"
+    "\n"
+    "[vampire]\n"
+    "class = Skyrim.esm|0x02E00F\n"
+    "faction = Dawnguard.esm|0x0142E6\n"
+    "\n"
+    "[werewolf]\n"
+    "class = Skyrim.esm|0x0A1993, Skyrim.esm|0x0A1994, Skyrim.esm|0x0A1995\n"
+    "faction = Skyrim.esm|0x09A741\n"
+    "\n"
+    "[follower]\n"
+    "faction = Skyrim.esm|0x05C84E\n"
+    "\n"
+    "[undead]\n"
+    "keyword = Skyrim.esm|0x013796\n";
+
+struct ActorPredicate {
+    std::string name;
+    std::vector<std::string> classSpecs;
+    std::vector<std::string> raceSpecs;
+    std::vector<std::string> factionSpecs;
+    std::vector<std::string> keywordSpecs;
+    
+    // Filled by Resolve; FormID lists are sorted
+    std::vector<RE::FormID> classIDs;
+    std::vector<RE::FormID> raceIDs;
+    std::vector<RE::TESFaction*> factions;
+    std::vector<RE::BGSKeyword*> keywords;
+};
+
+// "Plugin.esp|0x123456" -> plugin name and local FormID
+bool ParseFormSpec(const std::string& spec, std::string& plugin, RE::FormID& localID) {
+    size_t separator = spec.find('|');
+    if (separator == std::string::npos) return false;
+    
+    plugin = spec.substr(0, separator);
+    std::string id = spec.substr(separator + 1);
+    plugin.erase(plugin.find_last_not_of(" \t") + 1);
+    id.erase(0, id.find_first_not_of(" \t"));
+    if (id.starts_with("0x") || id.starts_with("0X")) id.erase(0, 2);
     
-    auto* file = dataHandler->LookupModByName(dlcName);
-    return (file != nullptr);
+    auto [end, ec] = std::from_chars(id.data(), id.data() + id.size(), localID, 16);
+    return !plugin.empty() && ec == std::errc() && end == id.data() + id.size();
 }
 
-bool IsActorVampire(RE::Actor* actor) {
-    if (!actor) return false;
-    
-    auto* actorBase = actor->GetActorBase();
-    if (!actorBase) return false;
+class ActorPredicateSet {
+public:
+    // Reads the predicate list; a missing file is created with the built-in defaults
+    bool Load(const fs::path& path) {
+        IniDocument ini;
+        if (!fs::exists(path)) {
+            ini.Parse(kDefaultActorPredicatesIni);
+            if (ini.Save(path)) {
+                WriteToAdvancedLog("Created default Act2_Predicates.ini", __LINE__);
+            }
+        }
+        
+        if (!ini.Load(path)) {
+            WriteToAdvancedLog("WARNING: Could not open Act2_Predicates.ini, using built-in predicates", __LINE__);
+            ini.Parse(kDefaultActorPredicatesIni);
+        }
+        
+        std::vector<ActorPredicate> loaded;
+        const auto& sections = ini.Sections();
+        
+        // Section 0 holds keys before the first header, which belong to no predicate
+        for (size_t s = 1; s < sections.size(); ++s) {
+            std::string name = IniDocument::ToLower(sections[s].name);
+            if (loaded.size() == kMaxActorPredicates) {
+                WriteToAdvancedLog("WARNING: Predicate [" + name + "] ignored, at most 32 flags are supported", __LINE__);
+                break;
+            }
+            loaded.push_back({});
+            loaded.back().name = name;
+            
+            ini.ForEachEntry(sections[s], [&](const IniDocument::Entry& entry) {
+                std::vector<std::string>* specs = nullptr;
+                switch (entry.keyHash) {
+                    case IniHash("class"): specs = &loaded.back().classSpecs; break;
+                    case IniHash("race"): specs = &loaded.back().raceSpecs; break;
+                    case IniHash("faction"): specs = &loaded.back().factionSpecs; break;
+                    case IniHash("keyword"): specs = &loaded.back().keywordSpecs; break;
+                    default: return;
+                }
+                
+                std::string_view values = entry.value;
+                while (!values.empty()) {
+                    size_t comma = values.find(',');
+                    std::string_view value = IniDocument::Trim(values.substr(0, comma));
+                    if (!value.empty()) specs->emplace_back(value);
+                    values.remove_prefix(comma == std::string_view::npos ? values.size() : comma + 1);
+                }
+            });
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        predicates = std::move(loaded);
+        return true;
+    }
     
-    auto* actorClass = actorBase->npcClass;
-    if (actorClass) {
-        RE::FormID classID = actorClass->GetFormID();
-        if (classID == 0x0002E00F) {
-            return true;
+    // Looks every referenced form up once; forms from missing plugins are dropped
+    void Resolve() {
+        auto* dataHandler = RE::TESDataHandler::GetSingleton();
+        if (!dataHandler) return;
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t resolved = 0;
+        size_t missing = 0;
+        
+        for (auto& predicate : predicates) {
+            predicate.classIDs.clear();
+            predicate.raceIDs.clear();
+            
+            for (auto* form : ResolveSpecs<RE::TESClass>(dataHandler, predicate.classSpecs, missing)) {
+                predicate.classIDs.push_back(form->GetFormID());
+            }
+            for (auto* form : ResolveSpecs<RE::TESRace>(dataHandler, predicate.raceSpecs, missing)) {
+                predicate.raceIDs.push_back(form->GetFormID());
+            }
+            predicate.factions = ResolveSpecs<RE::TESFaction>(dataHandler, predicate.factionSpecs, missing);
+            predicate.keywords = ResolveSpecs<RE::BGSKeyword>(dataHandler, predicate.keywordSpecs, missing);
+            resolved += predicate.classIDs.size() + predicate.raceIDs.size() + predicate.factions.size() + predicate.keywords.size();
+            
+            std::sort(predicate.classIDs.begin(), predicate.classIDs.end());
+            std::sort(predicate.raceIDs.begin(), predicate.raceIDs.end());
         }
+        
+        vampireMask = MaskLocked("vampire");
+        werewolfMask = MaskLocked("werewolf");
+        
+        WriteToAdvancedLog("Actor predicates: " + std::to_string(predicates.size()) + " flags, " +
+                          std::to_string(resolved) + " forms resolved, " + std::to_string(missing) + " missing", __LINE__);
     }
     
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (dataHandler && IsDLCInstalled("Dawnguard.esm")) {
-        auto* vampireFaction = dataHandler->LookupForm<RE::TESFaction>(0x020142E6, "Dawnguard.esm");
-        if (vampireFaction && actor->IsInFaction(vampireFaction)) {
-            return true;
+    std::uint32_t Evaluate(RE::Actor* actor) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return EvaluateLocked(actor);
+    }
+    
+    // One flag mask per actor, in input order; null actors get no flags
+    std::vector<std::uint32_t> EvaluateBatch(const std::vector<RE::Actor*>& actors) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::uint32_t> flags;
+        flags.reserve(actors.size());
+        for (auto* actor : actors) {
+            flags.push_back(EvaluateLocked(actor));
         }
+        return flags;
     }
     
-    return false;
-}
-
-bool IsActorWerewolf(RE::Actor* actor) {
-    if (!actor) return false;
+    // Bits of the "vampire" and "werewolf" flags as of the last Resolve(), 0 when not defined
+    std::uint32_t VampireMask() const { return vampireMask.load(std::memory_order_relaxed); }
+    std::uint32_t WerewolfMask() const { return werewolfMask.load(std::memory_order_relaxed); }
     
-    auto* actorBase = actor->GetActorBase();
-    if (!actorBase) return false;
+    std::vector<std::string> Names() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> names;
+        for (const auto& predicate : predicates) names.push_back(predicate.name);
+        return names;
+    }
     
-    auto* actorClass = actorBase->npcClass;
-    if (actorClass) {
-        RE::FormID classID = actorClass->GetFormID();
-        if (classID == 0x000A1993 || classID == 0x000A1994 || classID == 0x000A1995) {
-            return true;
+private:
+    template <class T>
+    static std::vector<T*> ResolveSpecs(RE::TESDataHandler* dataHandler, const std::vector<std::string>& specs, size_t& missing) {
+        std::vector<T*> forms;
+        for (const auto& spec : specs) {
+            std::string plugin;
+            RE::FormID localID = 0;
+            T* form = nullptr;
+            if (ParseFormSpec(spec, plugin, localID)) {
+                form = dataHandler->LookupForm<T>(localID, plugin);
+            }
+            if (form) {
+                forms.push_back(form);
+            } else {
+                missing++;
+                WriteToAdvancedLog("Predicate form not found: " + spec, __LINE__);
+            }
         }
+        return forms;
     }
     
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (dataHandler) {
-        auto* werewolfFaction = dataHandler->LookupForm<RE::TESFaction>(0x0009A741, "Skyrim.esm");
-        if (werewolfFaction && actor->IsInFaction(werewolfFaction)) {
-            return true;
+    // Bit of the named flag, 0 when the config does not define it
+    std::uint32_t MaskLocked(std::string_view name) const {
+        for (size_t i = 0; i < predicates.size(); ++i) {
+            if (predicates[i].name == name) return std::uint32_t{1} << i;
         }
+        return 0;
     }
     
-    return false;
+    std::uint32_t EvaluateLocked(RE::Actor* actor) const {
+        if (!actor) return 0;
+        
+        auto* actorBase = actor->GetActorBase();
+        if (!actorBase) return 0;
+        
+        RE::FormID classID = actorBase->npcClass ? actorBase->npcClass->GetFormID() : 0;
+        auto* race = actor->GetRace();
+        RE::FormID raceID = race ? race->GetFormID() : 0;
+        
+        std::uint32_t flags = 0;
+        for (size_t i = 0; i < predicates.size(); ++i) {
+            const auto& predicate = predicates[i];
+            bool match = std::binary_search(predicate.classIDs.begin(), predicate.classIDs.end(), classID) ||
+                         std::binary_search(predicate.raceIDs.begin(), predicate.raceIDs.end(), raceID);
+            for (size_t f = 0; !match && f < predicate.factions.size(); ++f) {
+                match = actor->IsInFaction(predicate.factions[f]);
+            }
+            for (size_t k = 0; !match && k < predicate.keywords.size(); ++k) {
+                match = actor->HasKeyword(predicate.keywords[k]);
+            }
+            if (match) flags |= std::uint32_t{1} << i;
+        }
+        return flags;
+    }
+    
+    std::mutex mutex;
+    std::vector<ActorPredicate> predicates;
+    std::atomic<std::uint32_t> vampireMask{0};
+    std::atomic<std::uint32_t> werewolfMask{0};
+};
+
+static ActorPredicateSet g_actorPredicates;
+
+void BuildActorPredicates() {
+    if (g_actorPredicatesIniPath.empty()) return;
+    g_actorPredicates.Load(g_actorPredicatesIniPath);
+    g_actorPredicates.Resolve();
 }
 
-std::string GetPluginNameFromFormID(RE::FormID formID) {
-    auto* form = RE::TESForm::LookupByID(formID);
-    if (!form) return "Unknown";
-    
-    auto* file = form->GetFile(0);
-    if (!file) return "Unknown";
-    
-    return file->fileName;
+void ApplyActorFlags(NPCData& npcData, std::uint32_t flags) {
+    npcData.actorFlags = flags;
+    npcData.isVampire = (flags & g_actorPredicates.VampireMask()) != 0;
+    npcData.isWerewolf = (flags & g_actorPredicates.WerewolfMask()) != 0;
 }
 
-std::vector<FactionData> GetActorFactions(RE::Actor* actor) {
-    std::vector<FactionData> factions;
-    
-    if (!actor) return factions;
-    
-    auto* actorBase = actor->GetActorBase();
-    if (!actorBase) return factions;
+// ===== FACTION DICTIONARY =====
+// FactionDictionary.h holds the dictionary and the membership bitsets; reading the factions of
+// loaded forms and actors happens here.
+
+std::uint32_t InternFaction(FactionDictionary& dictionary, RE::TESFaction* faction) {
+    const char* editorID = faction->GetFormEditorID();
+    const char* name = faction->GetName();
+    return dictionary.Intern(faction->GetFormID(), editorID ? editorID : "", name ? name : "");
+}
+
+// Matches every loaded TESFaction to its CSV row by editor ID, or appends it
+size_t ExtendFactionDictionaryFromGame(FactionDictionary& dictionary) {
+    auto* dataHandler = RE::TESDataHandler::GetSingleton();
+    if (!dataHandler) return 0;
+
+    size_t before = dictionary.Size();
+    for (auto* faction : dataHandler->GetFormArray<RE::TESFaction>()) {
+        if (faction) InternFaction(dictionary, faction);
+    }
+    return dictionary.Size() - before;
+}
+
+static FactionDictionary g_factionDictionary;
+
+void BuildFactionDictionary() {
+    auto start = std::chrono::steady_clock::now();
+
+    size_t seeded = 0;
+    if (g_factionDictionary.Size() == 0 && !g_factionCsvPath.empty()) {
+        seeded = g_factionDictionary.SeedFromCSV(g_factionCsvPath);
+        if (seeded == 0) {
+            WriteToAdvancedLog("WARNING: No factions read from " + g_factionCsvPath.string(), __LINE__);
+        }
+    }
+
+    size_t added = ExtendFactionDictionaryFromGame(g_factionDictionary);
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::stringstream ss;
+    ss << "Faction dictionary: " << g_factionDictionary.Size() << " entries (" << seeded << " from CSV, "
+       << added << " added from game data, " << g_factionDictionary.ResolvedCount() << " with FormID) in "
+       << std::fixed << std::setprecision(1) << elapsed << " ms";
+    WriteToAdvancedLog(ss.str(), __LINE__);
+}
+
+FactionMembership GetNPCFactions(RE::TESNPC* actorBase) {
+    FactionMembership factions;
     
-    if (actorBase->factions.empty()) return factions;
+    if (!actorBase || actorBase->factions.empty()) return factions;
     
     for (const auto& factionInfo : actorBase->factions) {
         if (!factionInfo.faction) continue;
         
-        FactionData data;
-        data.name = factionInfo.faction->GetName();
-        
-        const char* editorID = factionInfo.faction->GetFormEditorID();
-        if (editorID && strlen(editorID) > 0) {
-            data.editorID = editorID;
-        } else {
-            data.editorID = "Unknown";
-        }
-        
-        data.formID = factionInfo.faction->GetFormID();
-        data.rank = factionInfo.rank;
-        data.isMember = true;
-        
-        factions.push_back(data);
+        factions.Add(InternFaction(g_factionDictionary, factionInfo.faction), factionInfo.rank);
     }
     
     return factions;
 }
 
-EquippedItemData GetEquippedItemInSlot(RE::Actor* actor, int slot) {
-    EquippedItemData itemData;
-    itemData.slot = slot;
-    
-    if (!actor) return itemData;
-    
-    RE::TESForm* equippedForm = nullptr;
-    
-    if (slot == -1) {
-        equippedForm = actor->GetEquippedObject(true);
-    } else if (slot == -2) {
-        equippedForm = actor->GetEquippedObject(false);
-    } else {
-        auto inv = actor->GetInventory();
-        for (auto& [item, invData] : inv) {
-            if (!item || !item->IsArmor()) continue;
-            
-            auto& [count, entry] = invData;
-            if (!entry || !entry->extraLists) continue;
-            
-            for (auto* xList : *entry->extraLists) {
-                if (xList && xList->HasType(RE::ExtraDataType::kWorn)) {
-                    auto armor = item->As<RE::TESObjectARMO>();
-                    if (armor) {
-                        auto armorSlotMask = armor->GetSlotMask();
-                        
-                        int bitPosition = slot - 30;
-                        
-                        if (bitPosition < 0 || bitPosition >= 32) {
-                            continue;
-                        }
-                        
-                        std::uint32_t slotBit = 1u << bitPosition;
-                        std::uint32_t maskValue = static_cast<std::uint32_t>(armorSlotMask);
-                        
-                        if ((maskValue & slotBit) != 0) {
-                            equippedForm = item;
-                            break;
-                        }
-                    }
-                }
-            }
-            if (equippedForm) break;
+FactionMembership GetActorFactions(RE::Actor* actor) {
+    return actor ? GetNPCFactions(actor->GetActorBase()) : FactionMembership{};
+}
+
+// Indices of the NPCs that belong to at least one faction of the mask
+std::vector<size_t> SelectNPCsByFactions(const std::vector<NPCData>& npcList, const FactionBitset& anyOf) {
+    std::vector<size_t> selected;
+    for (size_t i = 0; i < npcList.size(); ++i) {
+        if (FactionBitsIntersect(npcList[i].factions.bits, anyOf)) selected.push_back(i);
+    }
+    return selected;
+}
+
+// [NPC_tracking] faction_query: the known factions of the list and the scanned NPCs in any of them
+struct FactionQueryResult {
+    FactionMembership factions;
+    std::vector<RE::FormID> refIDs;
+};
+
+FactionQueryResult RunFactionQuery(const std::vector<NPCData>& npcList, const std::vector<std::string>& editorIDs) {
+    FactionQueryResult result;
+    FactionBitset mask = g_factionDictionary.MaskForEditorIDs(editorIDs);
+    for (size_t word = 0; word < mask.size(); ++word) {
+        for (std::uint64_t bits = mask[word]; bits; bits &= bits - 1) {
+            result.factions.Add(static_cast<std::uint32_t>(word * 64 + std::countr_zero(bits)), 0);
         }
     }
+    for (size_t i : SelectNPCsByFactions(npcList, mask)) {
+        result.refIDs.push_back(npcList[i].refID);
+    }
+    return result;
+}
+
+EquippedItemData MakeEquippedItemData(RE::TESForm* equippedForm, int slot) {
+    EquippedItemData itemData;
+    itemData.slot = slot;
     
     if (equippedForm) {
         itemData.equipped = true;
         itemData.name = equippedForm->GetName();
         itemData.formID = equippedForm->GetFormID();
-        itemData.pluginName = GetPluginNameFromFormID(equippedForm->GetFormID());
+        
+        auto* file = equippedForm->GetFile(0);
+        itemData.pluginName = file ? file->fileName : "Unknown";
     }
     
     return itemData;
 }
 
-std::unordered_map<std::string, EquippedItemData> GetAllEquippedItems(RE::Actor* actor) {
-    std::unordered_map<std::string, EquippedItemData> equippedItems;
-    
-    if (!actor) return equippedItems;
-    
-    equippedItems["right_hand"] = GetEquippedItemInSlot(actor, -1);
-    equippedItems["left_hand"] = GetEquippedItemInSlot(actor, -2);
-    
-    equippedItems["head"] = GetEquippedItemInSlot(actor, 30);
-    equippedItems["hair"] = GetEquippedItemInSlot(actor, 31);
-    equippedItems["body"] = GetEquippedItemInSlot(actor, 32);
-    equippedItems["hands"] = GetEquippedItemInSlot(actor, 33);
-    equippedItems["forearms"] = GetEquippedItemInSlot(actor, 34);
-    equippedItems["amulet"] = GetEquippedItemInSlot(actor, 35);
-    equippedItems["ring"] = GetEquippedItemInSlot(actor, 36);
-    equippedItems["feet"] = GetEquippedItemInSlot(actor, 37);
-    equippedItems["calves"] = GetEquippedItemInSlot(actor, 38);
-    equippedItems["shield"] = GetEquippedItemInSlot(actor, 39);
-    equippedItems["tail"] = GetEquippedItemInSlot(actor, 40);
-    equippedItems["long_hair"] = GetEquippedItemInSlot(actor, 41);
-    equippedItems["circlet"] = GetEquippedItemInSlot(actor, 42);
-    equippedItems["ears"] = GetEquippedItemInSlot(actor, 43);
-    equippedItems["face_jewelry"] = GetEquippedItemInSlot(actor, 44);
-    equippedItems["neck"] = GetEquippedItemInSlot(actor, 45);
-    equippedItems["chest_primary"] = GetEquippedItemInSlot(actor, 46);
-    equippedItems["back"] = GetEquippedItemInSlot(actor, 47);
-    equippedItems["misc_fx"] = GetEquippedItemInSlot(actor, 48);
-    equippedItems["pelvis_primary"] = GetEquippedItemInSlot(actor, 49);
-    equippedItems["decapitated_head"] = GetEquippedItemInSlot(actor, 50);
-    equippedItems["decapitate"] = GetEquippedItemInSlot(actor, 51);
-    equippedItems["pelvis_secondary"] = GetEquippedItemInSlot(actor, 52);
-    equippedItems["leg_primary_right"] = GetEquippedItemInSlot(actor, 53);
-    equippedItems["leg_secondary_left"] = GetEquippedItemInSlot(actor, 54);
-    equippedItems["face_alternate"] = GetEquippedItemInSlot(actor, 55);
-    equippedItems["chest_secondary"] = GetEquippedItemInSlot(actor, 56);
-    equippedItems["shoulder"] = GetEquippedItemInSlot(actor, 57);
-    equippedItems["arm_left"] = GetEquippedItemInSlot(actor, 58);
-    equippedItems["arm_right"] = GetEquippedItemInSlot(actor, 59);
-    equippedItems["unnamed_fx"] = GetEquippedItemInSlot(actor, 60);
-    equippedItems["fx01"] = GetEquippedItemInSlot(actor, 61);
+// One inventory walk fills all 32 biped slots (30-61); index 0 is slot 30
+void CollectWornArmorSlots(RE::Actor* actor, std::array<RE::TESObjectARMO*, kBipedSlotCount>& slotTable) {
+    slotTable.fill(nullptr);
+    
+    if (!actor) return;
+    
+    auto inv = actor->GetInventory([](RE::TESBoundObject& object) { return object.IsArmor(); });
+    for (auto& [item, invData] : inv) {
+        if (!item) continue;
+        
+        auto& [count, entry] = invData;
+        if (!entry || !entry->extraLists) continue;
+        
+        auto* armor = item->As<RE::TESObjectARMO>();
+        if (!armor) continue;
+        
+        for (auto* xList : *entry->extraLists) {
+            if (xList && xList->HasType(RE::ExtraDataType::kWorn)) {
+                ClaimBipedSlots(slotTable, armor, static_cast<std::uint32_t>(armor->GetSlotMask()));
+                break;
+            }
+        }
+    }
+}
+
+EquippedFormIDs CaptureEquippedFormIDs(RE::Actor* actor) {
+    EquippedFormIDs ids{};
+    
+    auto* rightHand = actor->GetEquippedObject(true);
+    auto* leftHand = actor->GetEquippedObject(false);
+    ids[static_cast<size_t>(EquipSlot::kRightHand)] = rightHand ? rightHand->GetFormID() : 0;
+    ids[static_cast<size_t>(EquipSlot::kLeftHand)] = leftHand ? leftHand->GetFormID() : 0;
+    
+    std::array<RE::TESObjectARMO*, kBipedSlotCount> slotTable;
+    CollectWornArmorSlots(actor, slotTable);
+    for (size_t i = 0; i < kBipedSlotCount; ++i) {
+        ids[kFirstBipedEquipSlot + i] = slotTable[i] ? slotTable[i]->GetFormID() : 0;
+    }
     
+    return ids;
+}
+
+// ===== LIVE EQUIPMENT TABLE =====
+// LiveEquipmentTable.h keeps worn armor per actor from TESEquipEvent; misses fall back to a capture here.
+
+static LiveEquipmentTable g_liveEquipment;
+
+// Table read for known actors, full inventory capture (which seeds the table) otherwise
+EquippedFormIDs ReadEquippedFormIDs(RE::Actor* actor) {
+    EquippedFormIDs ids{};
+    if (!g_liveEquipment.Lookup(actor->GetFormID(), ids)) {
+        ids = CaptureEquippedFormIDs(actor);
+        g_liveEquipment.Seed(actor->GetFormID(), ids);
+        return ids;
+    }
+
+    auto* rightHand = actor->GetEquippedObject(true);
+    auto* leftHand = actor->GetEquippedObject(false);
+    ids[static_cast<size_t>(EquipSlot::kRightHand)] = rightHand ? rightHand->GetFormID() : 0;
+    ids[static_cast<size_t>(EquipSlot::kLeftHand)] = leftHand ? leftHand->GetFormID() : 0;
+    return ids;
+}
+
+// Names and plugins of already captured FormIDs; only reads base forms, so it is safe off the main thread
+EquippedItems ResolveEquippedItems(const EquippedFormIDs& ids) {
+    EquippedItems equippedItems;
+    for (size_t i = 0; i < kEquipSlotCount; ++i) {
+        equippedItems[i].slot = kEquipSlotTable[i].slot;
+        if (ids[i] == 0) continue;
+        equippedItems[i] = MakeEquippedItemData(RE::TESForm::LookupByID(ids[i]), kEquipSlotTable[i].slot);
+    }
     return equippedItems;
 }
 
+EquippedItems GetAllEquippedItems(RE::Actor* actor) {
+    if (!actor) return ResolveEquippedItems(EquippedFormIDs{});
+    return ResolveEquippedItems(ReadEquippedFormIDs(actor));
+}
+
 OBodyPDAPathsResult DetectAllOBodyPDAPaths() {
     OBodyPDAPathsResult result;
     
@@ -1306,151 +1588,72 @@ OBodyPDAPathsResult DetectAllOBodyPDAPaths() {
     return result;
 }
 
-// ===== MODIFIED PLUGIN FILTER LOADING WITH SUPPORT FOR BRACKET NAMES AND UNICODE =====
+// Act2_Manager.ini; row order is also the order default and saved files are written in
+constexpr IniSchema kAct2ManagerSchema(std::to_array<IniField>({
+    {"NPC_tracking", "start", &g_npcTrackingConfig.start, "false"},
+    {"NPC_tracking", "radio", &g_npcTrackingConfig.radio, "3000"},
+    {"NPC_tracking", "continuous", &g_npcTrackingConfig.continuous, "false"},
+    {"NPC_tracking", "interval_ms", &g_npcTrackingConfig.intervalMs, "2000", 100, 60000},
+    {"NPC_tracking", "distance_threshold", &g_npcTrackingConfig.distanceThreshold, "128", 0},
+    {"NPC_tracking", "max_results", &g_npcTrackingConfig.maxResults, "0", 0},
+    {"NPC_tracking", "rings", &g_npcTrackingConfig.rings, ""},
+    {"NPC_tracking", "faction_query", &g_npcTrackingConfig.factionQuery, ""},
+    {"Plugin_Outfits", "start", &g_pluginOutfitsConfig.start, "false"},
+    {"Plugin_Outfits", "Plugin_list", &g_pluginOutfitsConfig.pluginList, "false"},
+    {"Plugin_NPCs", "startNPCs", &g_pluginNPCsConfig.startNPCs, "false"},
+    {"Plugin_NPCs", "Plugin_listNPCs", &g_pluginNPCsConfig.pluginListNPCs, "false"},
+    {"Scheduler", "frame_budget_ms", &g_schedulerConfig.frameBudgetMs, "0.5", 0.05, 16},
+    {"History", "record", &g_historyConfig.record, "true"},
+    {"History", "flush_interval_s", &g_historyConfig.flushIntervalS, "60", 5, 3600},
+    {.section = "History", .key = "query", .target = &g_historyConfig.query, .defaultValue = "none",
+     .choices = "none|last_seen|cell|equipment_changes", .lowerCase = true},
+    {"History", "target", &g_historyConfig.target, ""},
+    {.section = "Filter", .key = "sex", .target = &g_filterConfig.sex, .defaultValue = "any",
+     .choices = "any|male|female", .lowerCase = true},
+    {"Filter", "races", &g_filterConfig.races, ""},
+    {"Filter", "plugins", &g_filterConfig.plugins, ""},
+    {"Filter", "exclude_vanilla", &g_filterConfig.excludeVanilla, "false"},
+    {"Filter", "max_distance", &g_filterConfig.maxDistance, "0", 0},
+}));
+
+// ===== CONFIG SNAPSHOTS =====
+// Act2_Manager.ini is read-copy-update (see Act2ManagerConfig.h). The loader and the flag
+// resets edit the staging globals under g_npcTrackingMutex and then publish a copy of them.
+
+// Caller holds g_npcTrackingMutex
+void PublishAct2ManagerConfig() {
+    g_act2ManagerConfig.Publish(Act2ManagerConfig{g_npcTrackingConfig, g_pluginOutfitsConfig, g_pluginNPCsConfig,
+                                                  g_schedulerConfig, g_historyConfig, g_filterConfig});
+}
 
-bool LoadPluginFilterList() {
-    std::lock_guard<std::mutex> lock(g_pluginFilterMutex);
-    
-    g_pluginFilterMap.clear();
-    
-    if (!fs::exists(g_pluginFilterIniPath)) {
-        WriteToAdvancedLog("Act2_Plugins.ini not found, will scan all plugins", __LINE__);
-        return false;
-    }
-    
-    std::ifstream iniFile(g_pluginFilterIniPath);
-    if (!iniFile.is_open()) {
-        WriteToAdvancedLog("ERROR: Could not open Act2_Plugins.ini", __LINE__);
-        return false;
-    }
-    
-    std::string line;
-    int loadedCount = 0;
-    
-    while (std::getline(iniFile, line)) {
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        
-        if (line.empty() || line[0] == ';' || line[0] == '#') {
-            continue;
-        }
-        
-        if (line[0] == '[' && line[line.length() - 1] == ']' && line.find('=') == std::string::npos) {
-            continue;
-        }
-        
-        size_t equalPos = line.find('=');
-        if (equalPos != std::string::npos) {
-            std::string pluginName = line.substr(0, equalPos);
-            std::string value = line.substr(equalPos + 1);
-            
-            pluginName.erase(0, pluginName.find_first_not_of(" \t"));
-            pluginName.erase(pluginName.find_last_not_of(" \t") + 1);
-            value.erase(0, value.find_first_not_of(" \t"));
-            value.erase(value.find_last_not_of(" \t") + 1);
-            
-            std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-            bool enabled = (value == "true" || value == "1" || value == "yes");
-            
-            g_pluginFilterMap[pluginName] = enabled;
-            loadedCount++;
-        }
-    }
-    
-    iniFile.close();
-    
-    WriteToAdvancedLog("Loaded plugin filter list: " + std::to_string(loadedCount) + " entries", __LINE__);
-    return true;
+std::shared_ptr<const Act2ManagerConfig> GetAct2ManagerConfig() {
+    return g_act2ManagerConfig.Get();
 }
 
-// ===== NPC FILTER LOADING WITH SUPPORT FOR BRACKET NAMES AND UNICODE =====
-
-bool LoadNPCFilterList() {
-    std::lock_guard<std::mutex> lock(g_npcFilterMutex);
-    
-    g_npcFilterMap.clear();
-    
-    if (!fs::exists(g_npcFilterIniPath)) {
-        WriteToAdvancedLog("Act2_NPCs.ini not found, will scan all plugins", __LINE__);
-        return false;
-    }
-    
-    std::ifstream iniFile(g_npcFilterIniPath);
-    if (!iniFile.is_open()) {
-        WriteToAdvancedLog("ERROR: Could not open Act2_NPCs.ini", __LINE__);
-        return false;
-    }
-    
-    std::string line;
-    int loadedCount = 0;
-    
-    while (std::getline(iniFile, line)) {
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        
-        if (line.empty() || line[0] == ';' || line[0] == '#') {
-            continue;
-        }
-        
-        if (line[0] == '[' && line[line.length() - 1] == ']' && line.find('=') == std::string::npos) {
-            continue;
-        }
-        
-        size_t equalPos = line.find('=');
-        if (equalPos != std::string::npos) {
-            std::string pluginName = line.substr(0, equalPos);
-            std::string value = line.substr(equalPos + 1);
-            
-            pluginName.erase(0, pluginName.find_first_not_of(" \t"));
-            pluginName.erase(pluginName.find_last_not_of(" \t") + 1);
-            value.erase(0, value.find_first_not_of(" \t"));
-            value.erase(value.find_last_not_of(" \t") + 1);
-            
-            std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-            bool enabled = (value == "true" || value == "1" || value == "yes");
-            
-            g_npcFilterMap[pluginName] = enabled;
-            loadedCount++;
-        }
-    }
-    
-    iniFile.close();
-    
-    WriteToAdvancedLog("Loaded NPC filter list: " + std::to_string(loadedCount) + " entries", __LINE__);
-    return true;
+template <class Fn>
+void UpdateAct2ManagerConfig(Fn&& edit) {
+    std::lock_guard<std::mutex> lock(g_npcTrackingMutex);
+    edit();
+    PublishAct2ManagerConfig();
 }
 
 bool LoadNPCTrackingConfig() {
     std::lock_guard<std::mutex> lock(g_npcTrackingMutex);
     
     if (!fs::exists(g_npcTrackingIniPath)) {
-        std::ofstream iniFile(g_npcTrackingIniPath);
-        if (iniFile.is_open()) {
-            iniFile << "[NPC_tracking]\n";
-            iniFile << "start = false\n";
-            iniFile << "radio = 3000\n";
-            iniFile << "\n";
-            iniFile << "[Plugin_Outfits]\n";
-            iniFile << "start = false\n";
-            iniFile << "Plugin_list = false\n";
-            iniFile << "\n";
-            iniFile << "[Plugin_NPCs]\n";
-            iniFile << "startNPCs = false\n";
-            iniFile << "Plugin_listNPCs = false\n";
-            iniFile.close();
-            
-            g_npcTrackingConfig.start = false;
-            g_npcTrackingConfig.radio = 3000;
+        // Goes through IniDocument::Save like every later edit, with its rename retries and logging
+        std::stringstream defaults;
+        kAct2ManagerSchema.Write(defaults, true);
+        IniDocument ini;
+        ini.Parse(defaults.str());
+        if (ini.Save(g_npcTrackingIniPath)) {
+            kAct2ManagerSchema.ApplyDefaults();
             g_npcTrackingConfig.lastModified = 0;
-            
-            g_pluginOutfitsConfig.start = false;
-            g_pluginOutfitsConfig.pluginList = false;
             g_pluginOutfitsConfig.lastModified = 0;
             g_pluginOutfitsConfig.lastPluginListModified = 0;
-            
-            g_pluginNPCsConfig.startNPCs = false;
-            g_pluginNPCsConfig.pluginListNPCs = false;
             g_pluginNPCsConfig.lastModified = 0;
+            g_mainThreadScheduler.SetFrameBudget(std::chrono::microseconds(500));
+            PublishAct2ManagerConfig();
             
             WriteToAdvancedLog("Created default Act2_Manager.ini", __LINE__);
             return true;
@@ -1458,95 +1661,39 @@ bool LoadNPCTrackingConfig() {
         return false;
     }
     
-    std::ifstream iniFile(g_npcTrackingIniPath);
-    if (!iniFile.is_open()) {
+    IniDocument ini;
+    if (!ini.Load(g_npcTrackingIniPath)) {
         WriteToAdvancedLog("ERROR: Could not open Act2_Manager.ini", __LINE__);
         return false;
     }
     
-    std::string line;
-    std::string currentSection;
-    
-    while (std::getline(iniFile, line)) {
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        
-        if (line.empty() || line[0] == ';' || line[0] == '#') {
-            continue;
-        }
-        
-        if (line[0] == '[' && line[line.length() - 1] == ']') {
-            currentSection = line.substr(1, line.length() - 2);
-            continue;
-        }
-        
-        size_t equalPos = line.find('=');
-        if (equalPos != std::string::npos) {
-            std::string key = line.substr(0, equalPos);
-            std::string value = line.substr(equalPos + 1);
-            
-            key.erase(0, key.find_first_not_of(" \t"));
-            key.erase(key.find_last_not_of(" \t") + 1);
-            value.erase(0, value.find_first_not_of(" \t"));
-            value.erase(value.find_last_not_of(" \t") + 1);
-            
-            if (currentSection == "NPC_tracking") {
-                if (key == "start") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    g_npcTrackingConfig.start = (value == "true" || value == "1" || value == "yes");
-                } else if (key == "radio") {
-                    try {
-                        g_npcTrackingConfig.radio = std::stoi(value);
-                    } catch (...) {
-                        g_npcTrackingConfig.radio = 3000;
-                    }
-                }
-            } else if (currentSection == "Plugin_Outfits") {
-                if (key == "start") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    g_pluginOutfitsConfig.start = (value == "true" || value == "1" || value == "yes");
-                } else if (key == "Plugin_list") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    g_pluginOutfitsConfig.pluginList = (value == "true" || value == "1" || value == "yes");
-                }
-            } else if (currentSection == "Plugin_NPCs") {
-                if (key == "startNPCs") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    g_pluginNPCsConfig.startNPCs = (value == "true" || value == "1" || value == "yes");
-                } else if (key == "Plugin_listNPCs") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    g_pluginNPCsConfig.pluginListNPCs = (value == "true" || value == "1" || value == "yes");
-                }
-            }
-        }
-    }
+    kAct2ManagerSchema.Apply(ini, "Act2_Manager.ini");
     
-    iniFile.close();
+    g_mainThreadScheduler.SetFrameBudget(std::chrono::microseconds(
+        static_cast<long long>(g_schedulerConfig.frameBudgetMs * 1000.0)));
+    PublishAct2ManagerConfig();
     return true;
 }
 
 bool SaveNPCTrackingConfig() {
     std::lock_guard<std::mutex> lock(g_npcTrackingMutex);
     
-    std::ofstream iniFile(g_npcTrackingIniPath, std::ios::trunc);
-    if (!iniFile.is_open()) {
-        WriteToAdvancedLog("ERROR: Could not save Act2_Manager.ini", __LINE__);
+    // Edits the file as it is on disk, so comments and keys this plugin does not know survive
+    IniDocument ini;
+    if (!ini.Load(g_npcTrackingIniPath) && fs::exists(g_npcTrackingIniPath)) {
+        WriteToAdvancedLog("ERROR: Could not read Act2_Manager.ini before saving", __LINE__);
         return false;
     }
     
-    iniFile << "[NPC_tracking]\n";
-    iniFile << "start = " << (g_npcTrackingConfig.start ? "true" : "false") << "\n";
-    iniFile << "radio = " << g_npcTrackingConfig.radio << "\n";
-    iniFile << "\n";
-    iniFile << "[Plugin_Outfits]\n";
-    iniFile << "start = " << (g_pluginOutfitsConfig.start ? "true" : "false") << "\n";
-    iniFile << "Plugin_list = " << (g_pluginOutfitsConfig.pluginList ? "true" : "false") << "\n";
-    iniFile << "\n";
-    iniFile << "[Plugin_NPCs]\n";
-    iniFile << "startNPCs = " << (g_pluginNPCsConfig.startNPCs ? "true" : "false") << "\n";
-    iniFile << "Plugin_listNPCs = " << (g_pluginNPCsConfig.pluginListNPCs ? "true" : "false") << "\n";
+    if (!kAct2ManagerSchema.Store(ini)) {
+        WriteToAdvancedLog("Act2_Manager.ini already up to date, not rewritten", __LINE__);
+        return true;
+    }
     
-    iniFile.close();
+    if (!ini.Save(g_npcTrackingIniPath)) {
+        WriteToAdvancedLog("ERROR: Could not save Act2_Manager.ini", __LINE__);
+        return false;
+    }
     
     WriteToAdvancedLog("Saved Act2_Manager.ini - NPC start=" + std::string(g_npcTrackingConfig.start ? "true" : "false") + 
                       ", radio=" + std::to_string(g_npcTrackingConfig.radio) + 
@@ -1565,50 +1712,14 @@ bool LoadPluginOutfitsConfig() {
         return false;
     }
     
-    std::ifstream iniFile(g_npcTrackingIniPath);
-    if (!iniFile.is_open()) {
+    IniDocument ini;
+    if (!ini.Load(g_npcTrackingIniPath)) {
         return false;
     }
     
-    std::string line;
-    std::string currentSection;
-    
-    while (std::getline(iniFile, line)) {
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        
-        if (line.empty() || line[0] == ';' || line[0] == '#') {
-            continue;
-        }
-        
-        if (line[0] == '[' && line[line.length() - 1] == ']') {
-            currentSection = line.substr(1, line.length() - 2);
-            continue;
-        }
-        
-        size_t equalPos = line.find('=');
-        if (equalPos != std::string::npos) {
-            std::string key = line.substr(0, equalPos);
-            std::string value = line.substr(equalPos + 1);
-            
-            key.erase(0, key.find_first_not_of(" \t"));
-            key.erase(key.find_last_not_of(" \t") + 1);
-            value.erase(0, value.find_first_not_of(" \t"));
-            value.erase(value.find_last_not_of(" \t") + 1);
-            
-            if (currentSection == "Plugin_Outfits") {
-                if (key == "start") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    g_pluginOutfitsConfig.start = (value == "true" || value == "1" || value == "yes");
-                } else if (key == "Plugin_list") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    g_pluginOutfitsConfig.pluginList = (value == "true" || value == "1" || value == "yes");
-                }
-            }
-        }
-    }
+    kAct2ManagerSchema.Apply(ini, "Act2_Manager.ini", "Plugin_Outfits");
+    PublishAct2ManagerConfig();
     
-    iniFile.close();
     return true;
 }
 
@@ -1650,11 +1761,11 @@ NPCData CapturePlayerData() {
     }
     
     playerData.gender = playerBase->IsFemale() ? "Female" : "Male";
-    playerData.isVampire = IsActorVampire(player);
-    playerData.isWerewolf = IsActorWerewolf(player);
+    ApplyActorFlags(playerData, g_actorPredicates.Evaluate(player));
     playerData.refID = player->GetFormID();
     playerData.baseID = playerBase->GetFormID();
     playerData.formID = playerBase->GetFormID();
+    playerData.cellID = player->GetParentCell() ? player->GetParentCell()->GetFormID() : 0;
     playerData.distanceFromPlayer = 0.0f;
     playerData.factions = GetActorFactions(player);
     playerData.equippedItems = GetAllEquippedItems(player);
@@ -1662,72 +1773,424 @@ NPCData CapturePlayerData() {
     return playerData;
 }
 
-NPCData CaptureNPCData(RE::Actor* actor, RE::NiPoint3 playerPos) {
+// ===== NPC STATIC ATTRIBUTE CACHE =====
+// Name, editor ID, plugin, race, gender and faction list never change for a given TESNPC, so
+// they are read once per base form and reused by every later capture. Strings repeated across
+// NPCs (plugin and race names above all) are interned. The cache is dropped on new game,
+// load game and data reload; runtime-created bases (0xFF) are never cached since their
+// FormIDs get reused and the game can free them at any time.
+
+class StringInterner {
+public:
+    const std::string* Intern(std::string_view text) {
+        auto it = pool.find(text);
+        if (it != pool.end()) return &*it;
+        return &*pool.emplace(text).first;
+    }
+
+    size_t Size() const { return pool.size(); }
+    void Clear() { pool.clear(); }
+
+private:
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+    std::unordered_set<std::string, Hash, std::equal_to<>> pool;
+};
+
+// Static attributes as read from the base form, before interning
+struct NPCBaseAttributes {
+    std::string name;
+    std::string editorID;
+    std::string pluginName;
+    std::string race;
+    bool isFemale = false;
+    FactionMembership factions;
+};
+
+NPCBaseAttributes ReadNPCBaseAttributes(RE::TESNPC* actorBase) {
+    NPCBaseAttributes attributes;
+
+    const char* name = actorBase->GetName();
+    attributes.name = name ? name : "";
+
+    const char* editorID = actorBase->GetFormEditorID();
+    attributes.editorID = (editorID && editorID[0] != '\0') ? editorID : "Unknown";
+
+    auto* file = actorBase->GetFile(0);
+    attributes.pluginName = file ? file->fileName : "Unknown";
+
+    auto* race = actorBase->GetRace();
+    attributes.race = race ? race->GetName() : "Unknown";
+
+    attributes.isFemale = actorBase->IsFemale();
+    attributes.factions = GetNPCFactions(actorBase);
+    return attributes;
+}
+
+void CopyNPCBaseAttributes(const NPCBaseAttributes& attributes, NPCData& npcData) {
+    npcData.name = attributes.name;
+    npcData.editorID = attributes.editorID;
+    npcData.pluginName = attributes.pluginName;
+    npcData.race = attributes.race;
+    npcData.gender = attributes.isFemale ? "Female" : "Male";
+    npcData.factions = attributes.factions;
+}
+
+struct NPCStaticAttributes {
+    const std::string* name;
+    const std::string* editorID;
+    const std::string* pluginName;
+    const std::string* race;
+    bool isFemale;
+    FactionMembership factions;
+};
+
+class NPCAttributeCache {
+public:
+    // Copies the static attributes of the base form into npcData, looking the form up and reading
+    // it on first use; false when baseID no longer resolves to a TESNPC. The game data is read and
+    // the strings copied without the lock, which only guards the lookup and the insert.
+    bool Fill(RE::FormID baseID, NPCData& npcData) {
+        std::shared_ptr<Generation> generation;
+        const NPCStaticAttributes* attributes = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            generation = current;
+            auto it = generation->entries.find(baseID);
+            if (it != generation->entries.end()) {
+                hits++;
+                attributes = &it->second;
+            } else {
+                misses++;
+            }
+        }
+
+        if (!attributes) {
+            auto* actorBase = RE::TESForm::LookupByID<RE::TESNPC>(baseID);
+            if (!actorBase) return false;
+            NPCBaseAttributes fresh = ReadNPCBaseAttributes(actorBase);
+
+            // Another worker may have inserted the same base meanwhile; emplace keeps its entry
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = generation->entries.find(baseID);
+            if (it == generation->entries.end()) {
+                it = generation->entries.emplace(baseID, Intern(*generation, std::move(fresh))).first;
+            }
+            attributes = &it->second;
+        }
+
+        // Entries and interned strings are never modified once inserted and the generation stays
+        // alive through the shared_ptr, so an Invalidate() meanwhile cannot free them
+        npcData.name = *attributes->name;
+        npcData.editorID = *attributes->editorID;
+        npcData.pluginName = *attributes->pluginName;
+        npcData.race = *attributes->race;
+        npcData.gender = attributes->isFemale ? "Female" : "Male";
+        npcData.factions = attributes->factions;
+        return true;
+    }
+
+    void Invalidate(const std::string& reason) {
+        std::lock_guard<std::mutex> lock(mutex);
+        WriteToAdvancedLog("NPC attribute cache cleared (" + reason + "): " + std::to_string(current->entries.size()) +
+                          " bases, " + std::to_string(current->strings.Size()) + " strings, " + std::to_string(hits) +
+                          " hits / " + std::to_string(misses) + " misses", __LINE__);
+        current = std::make_shared<Generation>();
+        hits = 0;
+        misses = 0;
+    }
+
+    std::string Stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::to_string(current->entries.size()) + " bases cached, " + std::to_string(hits) + " hits, " +
+               std::to_string(misses) + " misses";
+    }
+
+private:
+    // Everything one Invalidate() drops; workers still copying from it keep it alive
+    struct Generation {
+        StringInterner strings;
+        std::unordered_map<RE::FormID, NPCStaticAttributes> entries;
+    };
+
+    // Called with the mutex held
+    static NPCStaticAttributes Intern(Generation& generation, NPCBaseAttributes&& attributes) {
+        return NPCStaticAttributes{
+            generation.strings.Intern(attributes.name),
+            generation.strings.Intern(attributes.editorID),
+            generation.strings.Intern(attributes.pluginName),
+            generation.strings.Intern(attributes.race),
+            attributes.isFemale,
+            std::move(attributes.factions)
+        };
+    }
+
+    std::mutex mutex;
+    std::shared_ptr<Generation> current = std::make_shared<Generation>();
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+static NPCAttributeCache g_npcAttributeCache;
+
+// ===== TWO-PHASE NPC CAPTURE =====
+// Phase one runs on the main thread and only copies what belongs to the live reference into a
+// column-per-field snapshot: RefID, base FormID, cell, distance, worn FormIDs and the predicate
+// flags. Phase two turns each row into NPCData on worker threads; it looks the base forms up by
+// FormID and reads nothing but forms loaded from plugins (names, editor IDs, races, factions,
+// item names), which do not change after data load, so the game is only held for the cheap
+// copies. Runtime-created bases (0xFF) can be freed by the game once the actor unloads, so
+// their static attributes are copied in phase one instead.
+
+constexpr size_t kParallelMinItemsPerWorker = 16;
+
+size_t GetWorkerCount() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    return std::clamp<size_t>(hardware > 1 ? hardware - 1 : 1, 1, 8);
+}
+
+// Helpers started on the first scan and kept for the session; the caller is the last worker
+static ParallelForPool g_parallelPool(GetWorkerCount() - 1);
+
+// Runs work(0..count-1) on up to GetWorkerCount() threads including the caller
+void ParallelFor(size_t count, const std::function<void(size_t)>& work) {
+    g_parallelPool.Run(count, kParallelMinItemsPerWorker, work);
+}
+
+struct ActorSnapshot {
+    std::vector<RE::FormID> refIDs;
+    std::vector<RE::FormID> baseIDs;
+    std::vector<RE::FormID> cellIDs;
+    std::vector<float> distances;
+    std::vector<EquippedFormIDs> equipment;
+    std::vector<std::uint32_t> flags;
+    std::vector<std::unique_ptr<NPCBaseAttributes>> runtimeBases;  // Set only for 0xFF bases
+    
+    size_t Size() const { return refIDs.size(); }
+    
+    void Reserve(size_t count) {
+        refIDs.reserve(count);
+        baseIDs.reserve(count);
+        cellIDs.reserve(count);
+        distances.reserve(count);
+        equipment.reserve(count);
+        flags.reserve(count);
+        runtimeBases.reserve(count);
+    }
+};
+
+// Main-thread half of a capture; flags are filled in later for the whole batch
+void SnapshotActor(RE::Actor* actor, RE::TESNPC* actorBase, float distance, ActorSnapshot& snapshot) {
+    auto* cell = actor->GetParentCell();
+    RE::FormID baseID = actorBase->GetFormID();
+    snapshot.refIDs.push_back(actor->GetFormID());
+    snapshot.baseIDs.push_back(baseID);
+    snapshot.cellIDs.push_back(cell ? cell->GetFormID() : 0);
+    snapshot.distances.push_back(distance);
+    snapshot.equipment.push_back(ReadEquippedFormIDs(actor));
+    snapshot.flags.push_back(0);
+    snapshot.runtimeBases.push_back((baseID >> 24) == 0xFF
+        ? std::make_unique<NPCBaseAttributes>(ReadNPCBaseAttributes(actorBase))
+        : nullptr);
+}
+
+// Worker half: everything that needs strings
+NPCData ResolveSnapshotRow(const ActorSnapshot& snapshot, size_t row) {
     NPCData npcData;
+    RE::FormID baseID = snapshot.baseIDs[row];
     
-    if (!actor) return npcData;
+    // Static attributes come from the snapshot for runtime bases, from the per-base cache otherwise
+    if (const auto& runtimeBase = snapshot.runtimeBases[row]) {
+        CopyNPCBaseAttributes(*runtimeBase, npcData);
+    } else if (!g_npcAttributeCache.Fill(baseID, npcData)) {
+        CopyNPCBaseAttributes(NPCBaseAttributes{"", "Unknown", "Unknown", "Unknown"}, npcData);
+    }
     
-    auto* actorBase = actor->GetActorBase();
-    if (!actorBase) return npcData;
+    ApplyActorFlags(npcData, snapshot.flags[row]);
+    npcData.refID = snapshot.refIDs[row];
+    npcData.baseID = baseID;
+    npcData.formID = baseID;
+    npcData.cellID = snapshot.cellIDs[row];
+    npcData.distanceFromPlayer = snapshot.distances[row];
+    npcData.equippedItems = ResolveEquippedItems(snapshot.equipment[row]);
     
-    npcData.name = actorBase->GetName();
+    return npcData;
+}
+
+std::vector<NPCData> ResolveActorSnapshot(const ActorSnapshot& snapshot) {
+    std::vector<NPCData> npcList(snapshot.Size());
+    ParallelFor(snapshot.Size(), [&](size_t row) { npcList[row] = ResolveSnapshotRow(snapshot, row); });
+    return npcList;
+}
+
+// ===== SCAN FILTER PUSHDOWN =====
+// NPCFilter.h holds the filter columns and the SSE2 kernel; names in [Filter] are resolved here.
+
+constexpr std::array<std::string_view, 5> kVanillaPlugins = {
+    "Skyrim.esm", "Update.esm", "Dawnguard.esm", "HearthFires.esm", "Dragonborn.esm"
+};
+
+// Load-order ID as shown in the plugin list: 0x00-0xFD for full plugins, 0xFE000-0xFEFFF for light ones
+std::uint32_t GetPluginID(const RE::TESFile* file) {
+    if (!file) return kNoPluginID;
+    if (file->IsLight()) return 0xFE000 | file->GetSmallFileCompileIndex();
+    return file->GetCompileIndex();
+}
+
+std::vector<std::string> SplitFilterList(const std::string& list) {
+    std::vector<std::string> items;
+    for (auto& item : SplitCSVLine(list)) {
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (!item.empty()) items.push_back(std::move(item));
+    }
+    return items;
+}
+
+// Resolves names against the loaded data; call on the main thread
+CompiledNPCFilter CompileNPCFilter(const FilterConfig& config, float radius) {
+    CompiledNPCFilter filter;
+    auto* dataHandler = RE::TESDataHandler::GetSingleton();
     
-    const char* nEditorID = actorBase->GetFormEditorID();
-    if (nEditorID && strlen(nEditorID) > 0) {
-        npcData.editorID = nEditorID;
-    } else {
-        npcData.editorID = "Unknown";
+    if (config.maxDistance > 0.0f && config.maxDistance < radius) {
+        filter.maxDistanceSquared = config.maxDistance * config.maxDistance;
+        filter.active = true;
     }
     
-    npcData.pluginName = GetPluginNameFromFormID(actorBase->GetFormID());
+    if (config.sex == "male" || config.sex == "female") {
+        filter.sex = config.sex == "female" ? FilterSex::kFemale : FilterSex::kMale;
+        filter.active = true;
+    }
     
-    auto* race = actorBase->GetRace();
-    if (race) {
-        npcData.race = race->GetName();
-    } else {
-        npcData.race = "Unknown";
+    auto races = SplitFilterList(config.races);
+    if (!races.empty()) {
+        filter.restrictRaces = true;
+        filter.active = true;
+        for (const auto& race : races) {
+            RE::TESRace* resolved = nullptr;
+            std::string plugin;
+            RE::FormID localID = 0;
+            if (ParseFormSpec(race, plugin, localID)) {
+                resolved = dataHandler ? dataHandler->LookupForm<RE::TESRace>(localID, plugin) : nullptr;
+            } else if (dataHandler) {
+                for (auto* candidate : dataHandler->GetFormArray<RE::TESRace>()) {
+                    const char* editorID = candidate ? candidate->GetFormEditorID() : nullptr;
+                    if (editorID && _stricmp(editorID, race.c_str()) == 0) {
+                        resolved = candidate;
+                        break;
+                    }
+                }
+            }
+            if (resolved) {
+                filter.raceIDs.push_back(resolved->GetFormID());
+            } else {
+                WriteToAdvancedLog("Filter race not found: " + race, __LINE__);
+            }
+        }
     }
     
-    npcData.gender = actorBase->IsFemale() ? "Female" : "Male";
-    npcData.isVampire = IsActorVampire(actor);
-    npcData.isWerewolf = IsActorWerewolf(actor);
-    npcData.refID = actor->GetFormID();
-    npcData.baseID = actorBase->GetFormID();
-    npcData.formID = actorBase->GetFormID();
+    auto resolvePlugin = [&](std::string_view name) {
+        const RE::TESFile* file = dataHandler ? dataHandler->LookupModByName(name) : nullptr;
+        return file ? GetPluginID(file) : kNoPluginID;
+    };
     
-    RE::NiPoint3 npcPos = actor->GetPosition();
-    npcData.distanceFromPlayer = playerPos.GetDistance(npcPos);
+    auto plugins = SplitFilterList(config.plugins);
+    if (!plugins.empty()) {
+        filter.restrictPlugins = true;
+        filter.active = true;
+        for (const auto& plugin : plugins) {
+            std::uint32_t pluginID = resolvePlugin(plugin);
+            if (pluginID != kNoPluginID) {
+                filter.pluginIDs.push_back(pluginID);
+            } else {
+                WriteToAdvancedLog("Filter plugin not loaded: " + plugin, __LINE__);
+            }
+        }
+    }
     
-    npcData.factions = GetActorFactions(actor);
-    npcData.equippedItems = GetAllEquippedItems(actor);
+    if (config.excludeVanilla) {
+        filter.active = true;
+        for (auto plugin : kVanillaPlugins) {
+            std::uint32_t pluginID = resolvePlugin(plugin);
+            if (pluginID != kNoPluginID) filter.excludedPluginIDs.push_back(pluginID);
+        }
+    }
     
-    return npcData;
+    return filter;
 }
 
-std::vector<NPCData> ScanNPCsAroundPlayer(float radius) {
-    std::vector<NPCData> npcList;
-    
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        WriteToAdvancedLog("ERROR: Could not get player for NPC scan", __LINE__);
-        return npcList;
+// ===== PLUGIN FILTER LISTS =====
+// PluginFilterList.h holds the memory-mapped list; binding it to the load order happens here.
+
+static PluginFilterList g_pluginFilterList;
+static PluginFilterList g_npcFilterList;
+
+// Load-order ID of a plugin by file name, kNoPluginID when it is not loaded
+std::uint32_t GetLoadedPluginID(std::string_view pluginName) {
+    auto* dataHandler = RE::TESDataHandler::GetSingleton();
+    const RE::TESFile* file = dataHandler ? dataHandler->LookupModByName(pluginName) : nullptr;
+    return file ? GetPluginID(file) : kNoPluginID;
+}
+
+// Shared by both lists; the caller holds the list's mutex
+bool LoadFilterList(PluginFilterList& list, const fs::path& path, const std::string& fileName, const std::string& label) {
+    switch (list.Load(path)) {
+        case PluginFilterList::LoadResult::kMissing:
+            WriteToAdvancedLog(fileName + " not found, will scan all plugins", __LINE__);
+            return false;
+        case PluginFilterList::LoadResult::kError:
+            WriteToAdvancedLog("ERROR: Could not open " + fileName, __LINE__);
+            return false;
+        case PluginFilterList::LoadResult::kUnchanged:
+            WriteToAdvancedLog(label + " unchanged, reusing " + std::to_string(list.Size()) + " entries", __LINE__);
+            break;
+        case PluginFilterList::LoadResult::kLoaded:
+            WriteToAdvancedLog("Loaded " + label + ": " + std::to_string(list.Size()) + " entries", __LINE__);
+            break;
     }
     
-    auto* processLists = RE::ProcessLists::GetSingleton();
-    if (!processLists) {
-        WriteToAdvancedLog("ERROR: Could not get process lists", __LINE__);
-        return npcList;
-    }
+    if (!list.Bound()) list.BindLoadOrder(GetLoadedPluginID);
+    return true;
+}
+
+bool LoadPluginFilterList() {
+    std::lock_guard<std::mutex> lock(g_pluginFilterMutex);
+    return LoadFilterList(g_pluginFilterList, g_pluginFilterIniPath, "Act2_Plugins.ini", "plugin filter list");
+}
+
+bool LoadNPCFilterList() {
+    std::lock_guard<std::mutex> lock(g_npcFilterMutex);
+    return LoadFilterList(g_npcFilterList, g_npcFilterIniPath, "Act2_NPCs.ini", "NPC filter list");
+}
+
+enum class ActorSkipReason {
+    kNone,
+    kNo3D,
+    kDisabled,
+    kDifferentCell,
+    kDifferentWorldspace
+};
+
+ActorSkipReason CheckActorInPlayerSpace(RE::Actor* actor, RE::TESObjectCELL* playerCell, RE::TESWorldSpace* playerWorldspace) {
+    if (!actor->Is3DLoaded()) return ActorSkipReason::kNo3D;
+    if (actor->IsDisabled()) return ActorSkipReason::kDisabled;
     
-    RE::NiPoint3 playerPos = player->GetPosition();
-    auto* playerCell = player->GetParentCell();
-    auto* playerWorldspace = player->GetWorldspace();
+    auto* actorCell = actor->GetParentCell();
+    if (!actorCell) return ActorSkipReason::kDifferentCell;
     
-    WriteToAdvancedLog("Starting NPC scan with radius: " + std::to_string(radius), __LINE__);
-    WriteToAdvancedLog("Player cell: " + std::string(playerCell ? "Valid" : "NULL"), __LINE__);
-    WriteToAdvancedLog("Player worldspace: " + std::string(playerWorldspace ? "Valid" : "NULL"), __LINE__);
+    auto* actorWorldspace = actor->GetWorldspace();
+    if (playerWorldspace && actorWorldspace != playerWorldspace) return ActorSkipReason::kDifferentWorldspace;
+    if (!playerWorldspace && !actorWorldspace && actorCell != playerCell) return ActorSkipReason::kDifferentCell;
+    
+    return ActorSkipReason::kNone;
+}
+
+std::vector<NPCData> ScanNPCsAroundPlayer(float radius, size_t maxResults, std::vector<DistanceRing>* rings) {
+    std::vector<NPCData> npcList;
     
-    auto scanActorList = [&](auto& actorHandles, const std::string& priority) {
+    struct PriorityScanCounters {
         int scanned = 0;
         int skipped_no_3d = 0;
         int skipped_disabled = 0;
@@ -1735,127 +2198,595 @@ std::vector<NPCData> ScanNPCsAroundPlayer(float radius) {
         int skipped_different_worldspace = 0;
         int skipped_distance = 0;
         int skipped_unknown_plugin = 0;
+        int skipped_filter = 0;
         int added = 0;
+    };
+    
+    const std::array<std::string, 3> priorityNames = {"HIGH", "MEDIUM", "LOW"};
+    std::array<std::vector<RE::ActorHandle>, 3> handleLists;
+    std::array<PriorityScanCounters, 3> counters;
+    
+    // Log lines are buffered while on the main thread and written once the job is done
+    std::vector<std::string> deferredLog;
+    
+    RE::PlayerCharacter* player = nullptr;
+    RE::TESObjectCELL* playerCell = nullptr;
+    RE::TESWorldSpace* playerWorldspace = nullptr;
+    RE::NiPoint3 playerPos;
+    bool started = false;
+    size_t listIndex = 0;
+    size_t handleIndex = 0;
+    
+    // Actors that pass the cell/worldspace checks are indexed by position first; only the
+    // ones the grid returns inside the radius get the full capture
+    struct LocatedActor {
+        RE::ActorHandle handle;
+        size_t priority;
+    };
+    std::vector<LocatedActor> located;
+    std::vector<GridPoint> gridPoints;
+    std::vector<GridHit> inRange;
+    std::vector<RE::ActorHandle> capturedHandles;
+    ActorSnapshot snapshot;
+    const auto config = GetAct2ManagerConfig();
+    const FilterConfig& filterConfig = config->filter;
+    CompiledNPCFilter filter;
+    FilterColumns columns;
+    std::vector<std::uint32_t> matches;
+    std::vector<std::uint32_t> candidates;
+    size_t columnIndex = 0;
+    size_t sortedCount = 0;
+    bool filtered = false;
+    bool ordered = false;
+    bool indexed = false;
+    size_t hitIndex = 0;
+    
+    auto locateActor = [&](RE::ActorHandle& actorHandle, size_t priority) {
+        auto actor = actorHandle.get();
+        if (!actor) return;
+        
+        auto& c = counters[priority];
+        c.scanned++;
+        
+        if (actor.get() == player) return;
+        
+        switch (CheckActorInPlayerSpace(actor.get(), playerCell, playerWorldspace)) {
+            case ActorSkipReason::kNo3D:
+                c.skipped_no_3d++;
+                return;
+            case ActorSkipReason::kDisabled:
+                c.skipped_disabled++;
+                return;
+            case ActorSkipReason::kDifferentCell:
+                c.skipped_different_cell++;
+                return;
+            case ActorSkipReason::kDifferentWorldspace:
+                c.skipped_different_worldspace++;
+                return;
+            case ActorSkipReason::kNone:
+                break;
+        }
         
-        for (auto& actorHandle : actorHandles) {
-            auto actor = actorHandle.get();
-            if (!actor) continue;
-            
-            scanned++;
-            
-            if (actor.get() == player) continue;
-            
-            if (!actor->Is3DLoaded()) {
-                skipped_no_3d++;
-                continue;
-            }
-            
-            if (actor->IsDisabled()) {
-                skipped_disabled++;
-                continue;
-            }
-            
-            auto* actorCell = actor->GetParentCell();
-            if (!actorCell) {
-                skipped_different_cell++;
-                continue;
-            }
-            
-            auto* actorWorldspace = actor->GetWorldspace();
-            
-            if (playerWorldspace && actorWorldspace != playerWorldspace) {
-                skipped_different_worldspace++;
-                continue;
+        RE::NiPoint3 npcPos = actor->GetPosition();
+        gridPoints.push_back({npcPos.x, npcPos.y, npcPos.z, static_cast<std::uint32_t>(located.size())});
+        located.push_back({actorHandle, priority});
+    };
+    
+    auto indexActors = [&]() {
+        SpatialGridIndex grid;
+        grid.Build(std::move(gridPoints));
+        grid.QueryRadius(playerPos.x, playerPos.y, playerPos.z, radius, inRange);
+        
+        // Keep the process-list order of the old linear walk
+        std::sort(inRange.begin(), inRange.end(), [](const GridHit& a, const GridHit& b) { return a.id < b.id; });
+        
+        std::array<int, 3> locatedPerPriority{};
+        std::array<int, 3> inRangePerPriority{};
+        for (const auto& entry : located) locatedPerPriority[entry.priority]++;
+        for (const auto& hit : inRange) inRangePerPriority[located[hit.id].priority]++;
+        for (size_t i = 0; i < counters.size(); ++i) {
+            counters[i].skipped_distance = locatedPerPriority[i] - inRangePerPriority[i];
+        }
+    };
+    
+    auto gatherColumns = [&](const GridHit& hit) {
+        auto actor = located[hit.id].handle.get();
+        auto* actorBase = actor ? actor->GetActorBase() : nullptr;
+        if (!actorBase) {
+            // Gone since indexing; an infinite distance fails every filter
+            columns.Push(std::numeric_limits<float>::infinity(), false, 0, kNoPluginID);
+            return;
+        }
+        auto* race = actorBase->GetRace();
+        columns.Push(hit.distanceSquared, actorBase->IsFemale(), race ? race->GetFormID() : 0,
+                     GetPluginID(actorBase->GetFile(0)));
+    };
+    
+    auto filterHits = [&]() {
+        FilterRows(filter, columns, matches);
+        
+        std::vector<bool> kept(inRange.size(), false);
+        for (auto row : matches) kept[row] = true;
+        for (size_t i = 0; i < inRange.size(); ++i) {
+            if (!kept[i]) counters[located[inRange[i].id].priority].skipped_filter++;
+        }
+    };
+    
+    // Filter matches (or every hit) in capture order, closest first when max_results is set
+    auto orderCandidates = [&]() {
+        if (filter.active) {
+            candidates = std::move(matches);
+        } else {
+            candidates.resize(inRange.size());
+            std::iota(candidates.begin(), candidates.end(), 0u);
+        }
+        
+        if (rings) {
+            for (auto row : candidates) {
+                (*rings)[FindDistanceRing(*rings, std::sqrt(inRange[row].distanceSquared))].inRange++;
             }
+        }
+        
+        sortedCount = maxResults > 0 ? SelectNearestRows(candidates, inRange, maxResults) : candidates.size();
+    };
+    
+    auto captureActor = [&](const GridHit& hit) {
+        const auto& entry = located[hit.id];
+        auto& c = counters[entry.priority];
+        
+        auto actor = entry.handle.get();
+        if (!actor) return;
+        
+        auto* actorBase = actor->GetActorBase();
+        if (!actorBase) return;
+        
+        float distance = std::sqrt(hit.distanceSquared);
+        const char* name = actorBase->GetName();
+        auto* file = actorBase->GetFile(0);
+        
+        if (!file || file->fileName[0] == '\0') {
+            deferredLog.push_back("SKIPPED NPC with Unknown plugin: " + std::string(name ? name : "") + 
+                                  " (distance: " + std::to_string(distance) + ")");
+            c.skipped_unknown_plugin++;
+            return;
+        }
+        
+        if (name && name[0] != '\0') {
+            SnapshotActor(actor.get(), actorBase, distance, snapshot);
+            capturedHandles.push_back(entry.handle);
+            c.added++;
+        }
+    };
+    
+    auto classifyActors = [&]() {
+        std::vector<RE::NiPointer<RE::Actor>> held;
+        std::vector<RE::Actor*> actors;
+        held.reserve(capturedHandles.size());
+        actors.reserve(capturedHandles.size());
+        for (const auto& handle : capturedHandles) {
+            held.push_back(handle.get());
+            actors.push_back(held.back().get());
+        }
+        
+        snapshot.flags = g_actorPredicates.EvaluateBatch(actors);
+    };
+    
+    auto step = [&]() -> bool {
+        if (!started) {
+            started = true;
             
-            if (!playerWorldspace && !actorWorldspace) {
-                if (actorCell != playerCell) {
-                    skipped_different_cell++;
-                    continue;
-                }
+            player = RE::PlayerCharacter::GetSingleton();
+            if (!player) {
+                deferredLog.push_back("ERROR: Could not get player for NPC scan");
+                return false;
             }
             
-            RE::NiPoint3 npcPos = actor->GetPosition();
-            float distance = playerPos.GetDistance(npcPos);
-            
-            if (distance > radius) {
-                skipped_distance++;
-                continue;
+            auto* processLists = RE::ProcessLists::GetSingleton();
+            if (!processLists) {
+                deferredLog.push_back("ERROR: Could not get process lists");
+                return false;
             }
             
-            auto* actorBase = actor->GetActorBase();
-            if (!actorBase) continue;
+            playerPos = player->GetPosition();
+            playerCell = player->GetParentCell();
+            playerWorldspace = player->GetWorldspace();
+            filter = CompileNPCFilter(filterConfig, radius);
             
-            NPCData npcData = CaptureNPCData(actor.get(), playerPos);
+            handleLists[0].assign(processLists->highActorHandles.begin(), processLists->highActorHandles.end());
+            handleLists[1].assign(processLists->middleHighActorHandles.begin(), processLists->middleHighActorHandles.end());
+            handleLists[2].assign(processLists->lowActorHandles.begin(), processLists->lowActorHandles.end());
             
-            if (npcData.pluginName == "Unknown" || npcData.pluginName.empty()) {
-                WriteToAdvancedLog("SKIPPED NPC with Unknown plugin: " + npcData.name + 
-                                 " (distance: " + std::to_string(distance) + ")", __LINE__);
-                skipped_unknown_plugin++;
-                continue;
+            size_t total = handleLists[0].size() + handleLists[1].size() + handleLists[2].size();
+            located.reserve(total);
+            gridPoints.reserve(total);
+            snapshot.Reserve(total);
+            if (filter.active) columns.Reserve(total);
+            return true;
+        }
+        
+        if (!indexed) {
+            while (listIndex < handleLists.size() && handleIndex >= handleLists[listIndex].size()) {
+                listIndex++;
+                handleIndex = 0;
+            }
+            if (listIndex < handleLists.size()) {
+                locateActor(handleLists[listIndex][handleIndex++], listIndex);
+                return true;
             }
             
-            if (!npcData.name.empty()) {
-                npcList.push_back(npcData);
-                added++;
-                
-                WriteToAdvancedLog("ADDED: " + npcData.name + 
-                                 " | Distance: " + std::to_string(distance) + 
-                                 " | Plugin: " + npcData.pluginName, __LINE__);
+            indexActors();
+            indexed = true;
+            return true;
+        }
+        
+        if (filter.active && !filtered) {
+            if (columnIndex < inRange.size()) {
+                gatherColumns(inRange[columnIndex++]);
+                return true;
+            }
+            filterHits();
+            filtered = true;
+            return true;
+        }
+        
+        if (!ordered) {
+            orderCandidates();
+            ordered = true;
+            return true;
+        }
+        
+        bool wantMore = maxResults == 0 || snapshot.Size() < maxResults;
+        if (wantMore && hitIndex < candidates.size()) {
+            if (hitIndex == sortedCount) {
+                // Some of the closest K were skipped; order the rest to keep filling by distance
+                sortedCount = SelectNearestRows(candidates, inRange, candidates.size());
             }
+            captureActor(inRange[candidates[hitIndex++]]);
+            return true;
         }
         
-        WriteToAdvancedLog("===== " + priority + " PRIORITY SCAN RESULTS =====", __LINE__);
-        WriteToAdvancedLog("  Total scanned: " + std::to_string(scanned), __LINE__);
-        WriteToAdvancedLog("  Skipped (no 3D): " + std::to_string(skipped_no_3d), __LINE__);
-        WriteToAdvancedLog("  Skipped (disabled): " + std::to_string(skipped_disabled), __LINE__);
-        WriteToAdvancedLog("  Skipped (different cell): " + std::to_string(skipped_different_cell), __LINE__);
-        WriteToAdvancedLog("  Skipped (different worldspace): " + std::to_string(skipped_different_worldspace), __LINE__);
-        WriteToAdvancedLog("  Skipped (distance): " + std::to_string(skipped_distance), __LINE__);
-        WriteToAdvancedLog("  Skipped (unknown plugin): " + std::to_string(skipped_unknown_plugin), __LINE__);
-        WriteToAdvancedLog("  ADDED: " + std::to_string(added), __LINE__);
+        classifyActors();
+        return false;
     };
     
-    scanActorList(processLists->highActorHandles, "HIGH");
-    scanActorList(processLists->middleHighActorHandles, "MEDIUM");
-    scanActorList(processLists->lowActorHandles, "LOW");
+    WriteToAdvancedLog("Starting NPC scan with radius: " + std::to_string(radius), __LINE__);
+    
+    bool completed = RunOnMainThreadBudgeted(step, "NPC scan");
+    
+    if (player) {
+        WriteToAdvancedLog("Player cell: " + std::string(playerCell ? "Valid" : "NULL"), __LINE__);
+        WriteToAdvancedLog("Player worldspace: " + std::string(playerWorldspace ? "Valid" : "NULL"), __LINE__);
+    }
+    
+    for (const auto& line : deferredLog) {
+        WriteToAdvancedLog(line, __LINE__);
+    }
+    
+    if (!completed) {
+        WriteToAdvancedLog("WARNING: NPC scan did not complete, discarding partial results", __LINE__);
+        npcList.clear();
+        return npcList;
+    }
+    
+    // Game data is released; names, factions and equipment are resolved on worker threads
+    auto resolveStart = std::chrono::steady_clock::now();
+    npcList = ResolveActorSnapshot(snapshot);
+    auto resolveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - resolveStart).count();
+    
+    for (const auto& npc : npcList) {
+        WriteToAdvancedLog("ADDED: " + npc.name + 
+                          " | Distance: " + std::to_string(npc.distanceFromPlayer) + 
+                          " | Plugin: " + npc.pluginName, __LINE__);
+    }
+    
+    std::stringstream resolveLog;
+    resolveLog << "Resolved " << npcList.size() << " snapshots on " << GetWorkerCount() << " workers in "
+               << std::fixed << std::setprecision(2) << resolveMs << " ms";
+    WriteToAdvancedLog(resolveLog.str(), __LINE__);
+    
+    for (size_t i = 0; i < counters.size() && player; ++i) {
+        const auto& c = counters[i];
+        WriteToAdvancedLog("===== " + priorityNames[i] + " PRIORITY SCAN RESULTS =====", __LINE__);
+        WriteToAdvancedLog("  Total scanned: " + std::to_string(c.scanned), __LINE__);
+        WriteToAdvancedLog("  Skipped (no 3D): " + std::to_string(c.skipped_no_3d), __LINE__);
+        WriteToAdvancedLog("  Skipped (disabled): " + std::to_string(c.skipped_disabled), __LINE__);
+        WriteToAdvancedLog("  Skipped (different cell): " + std::to_string(c.skipped_different_cell), __LINE__);
+        WriteToAdvancedLog("  Skipped (different worldspace): " + std::to_string(c.skipped_different_worldspace), __LINE__);
+        WriteToAdvancedLog("  Skipped (distance): " + std::to_string(c.skipped_distance), __LINE__);
+        WriteToAdvancedLog("  Skipped (unknown plugin): " + std::to_string(c.skipped_unknown_plugin), __LINE__);
+        WriteToAdvancedLog("  Skipped (filter): " + std::to_string(c.skipped_filter), __LINE__);
+        WriteToAdvancedLog("  ADDED: " + std::to_string(c.added), __LINE__);
+    }
     
     WriteToAdvancedLog("========================================", __LINE__);
     WriteToAdvancedLog("FINAL RESULT: " + std::to_string(npcList.size()) + " valid NPCs found", __LINE__);
+    if (maxResults > 0) {
+        WriteToAdvancedLog("Closest " + std::to_string(npcList.size()) + " of " + std::to_string(candidates.size()) +
+                          " candidates kept (max_results = " + std::to_string(maxResults) + ")", __LINE__);
+    }
+    if (rings) {
+        for (const auto& npc : npcList) {
+            (*rings)[FindDistanceRing(*rings, npc.distanceFromPlayer)].returned++;
+        }
+        for (const auto& ring : *rings) {
+            WriteToAdvancedLog("Ring " + std::to_string(static_cast<int>(ring.minDistance)) + "-" +
+                              std::to_string(static_cast<int>(ring.maxDistance)) + ": " + std::to_string(ring.inRange) +
+                              " in range, " + std::to_string(ring.returned) + " returned", __LINE__);
+        }
+    }
+    WriteToAdvancedLog("NPC attribute cache: " + g_npcAttributeCache.Stats(), __LINE__);
+    WriteToAdvancedLog("Live equipment table: " + g_liveEquipment.Stats(), __LINE__);
     WriteToAdvancedLog("========================================", __LINE__);
     
     return npcList;
 }
 
-std::vector<OutfitItemData> GetOutfitItems(RE::BGSOutfit* outfit) {
-    std::vector<OutfitItemData> items;
-    
-    if (!outfit) return items;
-    
-    if (outfit->outfitItems.empty()) return items;
+// ===== FORM CATALOG =====
+// FormCatalog.h holds the arena-backed column store; filling it from the form arrays happens here.
+
+std::string_view GetCatalogFormName(RE::TESForm* form, std::string_view fallback) {
+    const char* editorID = form->GetFormEditorID();
+    if (editorID && editorID[0] != '\0') {
+        return editorID;
+    }
+
+    const char* displayName = form->GetName();
+    if (displayName && displayName[0] != '\0') {
+        return displayName;
+    }
+
+    return fallback;
+}
+
+void AddOutfitItemsToCatalog(FormCatalog& catalog, RE::BGSOutfit* outfit) {
+    if (!outfit) return;
     
     for (auto* item : outfit->outfitItems) {
         if (!item) continue;
-        
-        OutfitItemData itemData;
-        
-        const char* editorID = item->GetFormEditorID();
-        if (editorID && strlen(editorID) > 0) {
-            itemData.name = editorID;
+        catalog.AddOutfitItem(item->GetFormID(), GetCatalogFormName(item, "Unnamed Item"));
+    }
+}
+
+// Appends armors, outfits and weapons (and optionally NPCs) to the catalog. With a filter, only plugins
+// enabled in the list are kept; the decision is cached per file so the filter is consulted once per plugin.
+bool FillCatalogFromFormArrays(FormCatalog& catalog, const PluginFilterList* filter,
+                               bool includeNPCs = false) {
+    constexpr std::uint16_t kFilteredOut = FormCatalog::kNoPlugin - 1;
+    std::unordered_map<const RE::TESFile*, std::uint16_t> pluginCache;
+    std::array<int, kCatalogFormTypeCount> added{};
+    std::array<int, kCatalogFormTypeCount> skipped{};
+
+    auto resolvePlugin = [&](RE::TESForm* form) -> std::uint16_t {
+        auto* file = form->GetFile(0);
+        if (!file) return FormCatalog::kNoPlugin;
+
+        auto cached = pluginCache.find(file);
+        if (cached != pluginCache.end()) return cached->second;
+
+        const char* fileName = file->fileName;
+        std::uint16_t pluginID = FormCatalog::kNoPlugin;
+        if (fileName && fileName[0] != '\0') {
+            if (filter) {
+                pluginID = filter->EnabledByID(GetPluginID(file)) ? catalog.InternPlugin(fileName) : kFilteredOut;
+            } else {
+                pluginID = catalog.InternPlugin(fileName);
+            }
+        }
+        pluginCache.emplace(file, pluginID);
+        return pluginID;
+    };
+
+    auto addForm = [&](RE::TESForm* form, CatalogFormType type, std::string_view fallbackName) -> bool {
+        std::uint16_t pluginID = resolvePlugin(form);
+        if (pluginID == FormCatalog::kNoPlugin) return false;
+        if (pluginID == kFilteredOut) {
+            skipped[static_cast<size_t>(type)]++;
+            return false;
+        }
+
+        catalog.AddForm(form->GetFormID(), pluginID, type, GetCatalogFormName(form, fallbackName));
+        added[static_cast<size_t>(type)]++;
+        return true;
+    };
+
+    auto logPhase = [&](CatalogFormType type, const std::string& label, const std::string& filteredLabel) {
+        auto index = static_cast<size_t>(type);
+        if (filter) {
+            WriteToAdvancedLog(filteredLabel + " scanned: " + std::to_string(added[index]) +
+                              " (skipped: " + std::to_string(skipped[index]) + ")", __LINE__);
         } else {
-            const char* displayName = item->GetName();
-            if (displayName && strlen(displayName) > 0) {
-                itemData.name = displayName;
+            WriteToAdvancedLog("Total " + label + " scanned: " + std::to_string(added[index]), __LINE__);
+        }
+    };
+
+    RunOnMainThreadBudgeted([&]() {
+        auto* dataHandler = RE::TESDataHandler::GetSingleton();
+        size_t rows = dataHandler->GetFormArray<RE::TESObjectARMO>().size() +
+                      dataHandler->GetFormArray<RE::BGSOutfit>().size() +
+                      dataHandler->GetFormArray<RE::TESObjectWEAP>().size();
+        if (includeNPCs) rows += dataHandler->GetFormArray<RE::TESNPC>().size();
+        catalog.Reserve(rows, dataHandler->GetFormArray<RE::BGSOutfit>().size() * 4, rows * 32);
+        return false;
+    }, "catalog sizing");
+
+    WriteToAdvancedLog(filter ? "Scanning armors (filtered)..." : "Scanning armors...", __LINE__);
+    bool completed = ForEachFormOnMainThread<RE::TESObjectARMO>([&](RE::TESObjectARMO* armor) {
+        addForm(armor, CatalogFormType::kArmor, "Unnamed Armor");
+    }, "armors (catalog)");
+    logPhase(CatalogFormType::kArmor, "armors", "Armors");
+
+    WriteToAdvancedLog(filter ? "Scanning outfits (filtered)..." : "Scanning outfits...", __LINE__);
+    completed = completed && ForEachFormOnMainThread<RE::BGSOutfit>([&](RE::BGSOutfit* outfit) {
+        if (addForm(outfit, CatalogFormType::kOutfit, "Unnamed Outfit")) {
+            AddOutfitItemsToCatalog(catalog, outfit);
+        }
+    }, "outfits (catalog)");
+    logPhase(CatalogFormType::kOutfit, "outfits", "Outfits");
+
+    WriteToAdvancedLog(filter ? "Scanning weapons (filtered)..." : "Scanning weapons...", __LINE__);
+    completed = completed && ForEachFormOnMainThread<RE::TESObjectWEAP>([&](RE::TESObjectWEAP* weapon) {
+        addForm(weapon, CatalogFormType::kWeapon, "Unnamed Weapon");
+    }, "weapons (catalog)");
+    logPhase(CatalogFormType::kWeapon, "weapons", "Weapons");
+
+    if (includeNPCs) {
+        WriteToAdvancedLog(filter ? "Scanning NPCs (filtered)..." : "Scanning NPCs...", __LINE__);
+        completed = completed && ForEachFormOnMainThread<RE::TESNPC>([&](RE::TESNPC* npc) {
+            addForm(npc, CatalogFormType::kNPC, "Unnamed NPC");
+        }, "NPCs (catalog)");
+        logPhase(CatalogFormType::kNPC, "NPCs", "NPCs");
+    }
+
+    return completed;
+}
+
+void LogCatalogFootprint(const FormCatalog& catalog, const std::string& label) {
+    std::stringstream ss;
+    ss << label << " catalog: " << catalog.Size() << " forms, " << catalog.ItemCount() << " outfit items, "
+       << catalog.PluginCount() << " plugins | arena upstream allocations: " << catalog.UpstreamAllocations()
+       << ", peak: " << (catalog.PeakBytes() / 1024) << " KB";
+    if (catalog.Size() > 0) {
+        ss << " (" << (catalog.PeakBytes() / catalog.Size()) << " bytes/form)";
+    }
+    WriteToAdvancedLog(ss.str(), __LINE__);
+}
+
+// ===== CATALOG DIFF BETWEEN SESSIONS =====
+// CatalogDiff.h builds, saves, loads and diffs the snapshots; the scan and the JSON report happen here.
+
+const char* GetCatalogFormTypeName(CatalogFormType type) {
+    switch (type) {
+        case CatalogFormType::kArmor: return "armor";
+        case CatalogFormType::kOutfit: return "outfit";
+        case CatalogFormType::kWeapon: return "weapon";
+        case CatalogFormType::kNPC: return "npc";
+    }
+    return "unknown";
+}
+
+void WriteCatalogDiffJSON(std::ostream& jsonFile, const CatalogDiffResult& diff, const std::string& previousTimestamp,
+                          size_t currentForms) {
+    jsonFile << "{\n";
+    jsonFile << "  \"timestamp\": \"" << GetCurrentTimeString() << "\",\n";
+    jsonFile << "  \"previous_snapshot\": \"" << previousTimestamp << "\",\n";
+    jsonFile << "  \"total_forms\": " << currentForms << ",\n";
+    jsonFile << "  \"total_added\": " << diff.totalAdded << ",\n";
+    jsonFile << "  \"total_removed\": " << diff.totalRemoved << ",\n";
+    jsonFile << "  \"total_renamed\": " << diff.totalRenamed << ",\n";
+    jsonFile << "  \"changed_plugins\": " << diff.plugins.size() << ",\n";
+    jsonFile << "  \"plugins\": {\n";
+
+    char idBuffer[16];
+    auto writeEntries = [&](size_t begin, size_t end, CatalogDiffEntry::Kind kind) {
+        bool first = true;
+        for (size_t e = begin; e < end; ++e) {
+            const auto& entry = diff.entries[e];
+            if (entry.kind != kind) continue;
+
+            std::snprintf(idBuffer, sizeof(idBuffer), "0x%06X", CatalogSnapshot::KeyLocalID(entry.key));
+            jsonFile << (first ? "" : ",\n") << "        {\"type\": \"" << GetCatalogFormTypeName(CatalogSnapshot::KeyType(entry.key))
+                     << "\", \"form_id\": \"" << idBuffer << "\"";
+            if (kind == CatalogDiffEntry::Kind::kRenamed) {
+                jsonFile << ", \"old_name\": \"" << EscapeJSONString(entry.oldName) << "\", \"new_name\": \""
+                         << EscapeJSONString(entry.newName) << "\"}";
             } else {
-                itemData.name = "Unnamed Item";
+                jsonFile << ", \"name\": \"" << EscapeJSONString(kind == CatalogDiffEntry::Kind::kAdded ? entry.newName : entry.oldName)
+                         << "\"}";
             }
+            first = false;
         }
-        
-        itemData.formID = item->GetFormID();
-        items.push_back(itemData);
+        if (!first) jsonFile << "\n";
+    };
+
+    for (size_t i = 0; i < diff.plugins.size(); ++i) {
+        const auto& plugin = diff.plugins[i];
+        size_t entryEnd = (i + 1 < diff.plugins.size()) ? diff.plugins[i + 1].firstEntry : diff.entries.size();
+
+        jsonFile << "    \"" << EscapeJSONString(plugin.pluginName) << "\": {\n";
+
+        // Whole plugins that appeared or disappeared are summarized instead of listed form by form
+        if (!plugin.inPrevious) {
+            jsonFile << "      \"status\": \"new_plugin\",\n";
+            jsonFile << "      \"forms\": " << plugin.currentForms << "\n";
+        } else if (!plugin.inCurrent) {
+            jsonFile << "      \"status\": \"removed_plugin\",\n";
+            jsonFile << "      \"forms\": " << plugin.previousForms << "\n";
+        } else {
+            jsonFile << "      \"status\": \"changed\",\n";
+            jsonFile << "      \"added\": [\n";
+            writeEntries(plugin.firstEntry, entryEnd, CatalogDiffEntry::Kind::kAdded);
+            jsonFile << "      ],\n";
+            jsonFile << "      \"removed\": [\n";
+            writeEntries(plugin.firstEntry, entryEnd, CatalogDiffEntry::Kind::kRemoved);
+            jsonFile << "      ],\n";
+            jsonFile << "      \"renamed\": [\n";
+            writeEntries(plugin.firstEntry, entryEnd, CatalogDiffEntry::Kind::kRenamed);
+            jsonFile << "      ]\n";
+        }
+
+        jsonFile << "    }" << (i + 1 < diff.plugins.size() ? "," : "") << "\n";
     }
-    
-    return items;
+
+    jsonFile << "  }\n";
+    jsonFile << "}\n";
+}
+
+void ExecuteCatalogDiff() {
+    WriteToAdvancedLog("========================================", __LINE__);
+    WriteToAdvancedLog("CATALOG DIFF STARTED", __LINE__);
+    WriteToAdvancedLog("========================================", __LINE__);
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+
+        auto catalog = std::make_unique<FormCatalog>();
+        if (!FillCatalogFromFormArrays(*catalog, nullptr, true)) {
+            WriteToAdvancedLog("ERROR: Catalog scan for diff did not complete", __LINE__);
+            return;
+        }
+        auto scanned = std::chrono::steady_clock::now();
+
+        CatalogSnapshot current = BuildSnapshotFromCatalog(*catalog, GetCurrentTimeString());
+        LogCatalogFootprint(*catalog, "Session");
+        catalog.reset();
+
+        CatalogSnapshot previous;
+        bool hasPrevious = LoadCatalogSnapshot(g_catalogSnapshotPath, previous);
+        if (!hasPrevious) {
+            WriteToAdvancedLog("No previous catalog snapshot, every plugin is reported as new", __LINE__);
+            previous = CatalogSnapshot{};
+            previous.timestamp = "none";
+        }
+
+        CatalogDiffResult diff = DiffCatalogSnapshots(previous, current);
+        auto diffed = std::chrono::steady_clock::now();
+
+        std::ofstream jsonFile(g_catalogDiffJsonPath, std::ios::trunc);
+        if (!jsonFile.is_open()) {
+            WriteToAdvancedLog("ERROR: Could not create Act2_CatalogDiff.json", __LINE__);
+        } else {
+            WriteCatalogDiffJSON(jsonFile, diff, previous.timestamp, current.rows.size());
+            jsonFile.close();
+        }
+
+        if (SaveCatalogSnapshot(current, g_catalogSnapshotPath)) {
+            WriteToAdvancedLog("Catalog snapshot saved: " + std::to_string(current.rows.size()) + " forms", __LINE__);
+        }
+
+        auto ms = [](auto from, auto to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2);
+        ss << "Catalog diff: " << previous.rows.size() << " -> " << current.rows.size() << " forms, "
+           << diff.plugins.size() << " plugins changed (+" << diff.totalAdded << " -" << diff.totalRemoved
+           << " ~" << diff.totalRenamed << ") | scan " << ms(start, scanned) << " ms, diff " << ms(scanned, diffed) << " ms";
+        WriteToAdvancedLog(ss.str(), __LINE__);
+    } catch (const std::exception& e) {
+        WriteToAdvancedLog("ERROR in catalog diff: " + std::string(e.what()), __LINE__);
+    }
+
+    WriteToAdvancedLog("========================================", __LINE__);
+    WriteToAdvancedLog("CATALOG DIFF COMPLETE", __LINE__);
+    WriteToAdvancedLog("========================================", __LINE__);
 }
 
 std::vector<PluginCountData> ScanAllPluginsForCounts() {
@@ -1874,15 +2805,12 @@ std::vector<PluginCountData> ScanAllPluginsForCounts() {
     std::unordered_map<std::string, PluginCountData> pluginMap;
     
     WriteToAdvancedLog("Counting armors...", __LINE__);
-    auto& armors = dataHandler->GetFormArray<RE::TESObjectARMO>();
-    for (auto* armor : armors) {
-        if (!armor) continue;
-        
+    ForEachFormOnMainThread<RE::TESObjectARMO>([&](RE::TESObjectARMO* armor) {
         auto* file = armor->GetFile(0);
-        if (!file) continue;
+        if (!file) return;
         
         std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
+        if (pluginName.empty()) return;
         
         if (pluginMap.find(pluginName) == pluginMap.end()) {
             PluginCountData newData;
@@ -1894,18 +2822,15 @@ std::vector<PluginCountData> ScanAllPluginsForCounts() {
         }
         
         pluginMap[pluginName].armorCount++;
-    }
+    }, "armors (ScanAllPluginsForCounts)");
     
     WriteToAdvancedLog("Counting outfits...", __LINE__);
-    auto& outfits = dataHandler->GetFormArray<RE::BGSOutfit>();
-    for (auto* outfit : outfits) {
-        if (!outfit) continue;
-        
+    ForEachFormOnMainThread<RE::BGSOutfit>([&](RE::BGSOutfit* outfit) {
         auto* file = outfit->GetFile(0);
-        if (!file) continue;
+        if (!file) return;
         
         std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
+        if (pluginName.empty()) return;
         
         if (pluginMap.find(pluginName) == pluginMap.end()) {
             PluginCountData newData;
@@ -1917,18 +2842,15 @@ std::vector<PluginCountData> ScanAllPluginsForCounts() {
         }
         
         pluginMap[pluginName].outfitCount++;
-    }
+    }, "outfits (ScanAllPluginsForCounts)");
     
     WriteToAdvancedLog("Counting weapons...", __LINE__);
-    auto& weapons = dataHandler->GetFormArray<RE::TESObjectWEAP>();
-    for (auto* weapon : weapons) {
-        if (!weapon) continue;
-        
+    ForEachFormOnMainThread<RE::TESObjectWEAP>([&](RE::TESObjectWEAP* weapon) {
         auto* file = weapon->GetFile(0);
-        if (!file) continue;
+        if (!file) return;
         
         std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
+        if (pluginName.empty()) return;
         
         if (pluginMap.find(pluginName) == pluginMap.end()) {
             PluginCountData newData;
@@ -1940,10 +2862,10 @@ std::vector<PluginCountData> ScanAllPluginsForCounts() {
         }
         
         pluginMap[pluginName].weaponCount++;
-    }
+    }, "weapons (ScanAllPluginsForCounts)");
     
     for (auto& [pluginName, data] : pluginMap) {
-        pluginCounts.push_back(data);
+        pluginCounts.push_back(std::move(data));
     }
     
     WriteToAdvancedLog("========================================", __LINE__);
@@ -2019,7 +2941,7 @@ void ExecutePluginListScanning() {
     }
     
     WriteToAdvancedLog("Resetting plugin_list flag to false...", __LINE__);
-    g_pluginOutfitsConfig.pluginList = false;
+    UpdateAct2ManagerConfig([] { g_pluginOutfitsConfig.pluginList = false; });
     SavePluginOutfitsConfig();
     
     WriteToAdvancedLog("========================================", __LINE__);
@@ -2045,17 +2967,14 @@ std::vector<PluginNPCCountData> ScanAllPluginsForNPCCount() {
     std::unordered_map<std::string, PluginNPCCountData> pluginMap;
     
     WriteToAdvancedLog("Counting NPCs...", __LINE__);
-    auto& npcs = dataHandler->GetFormArray<RE::TESNPC>();
     
     int totalNPCs = 0;
-    for (auto* npc : npcs) {
-        if (!npc) continue;
-        
+    ForEachFormOnMainThread<RE::TESNPC>([&](RE::TESNPC* npc) {
         auto* file = npc->GetFile(0);
-        if (!file) continue;
+        if (!file) return;
         
         std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
+        if (pluginName.empty()) return;
         
         if (pluginMap.find(pluginName) == pluginMap.end()) {
             PluginNPCCountData newData;
@@ -2066,10 +2985,10 @@ std::vector<PluginNPCCountData> ScanAllPluginsForNPCCount() {
         
         pluginMap[pluginName].npcCount++;
         totalNPCs++;
-    }
+    }, "NPCs (ScanAllPluginsForNPCCount)");
     
     for (auto& [pluginName, data] : pluginMap) {
-        npcCounts.push_back(data);
+        npcCounts.push_back(std::move(data));
     }
     
     WriteToAdvancedLog("========================================", __LINE__);
@@ -2090,18 +3009,13 @@ std::vector<PluginNPCListData> ScanFilteredPluginsForNPCList() {
     
     LoadNPCFilterList();
     
-    if (g_npcFilterMap.empty()) {
+    if (g_npcFilterList.Empty()) {
         WriteToAdvancedLog("WARNING: No NPC filter loaded, aborting scan", __LINE__);
         return npcDataList;
     }
     
-    int enabledCount = 0;
-    for (const auto& [plugin, enabled] : g_npcFilterMap) {
-        if (enabled) enabledCount++;
-    }
-    
-    WriteToAdvancedLog("Filter loaded: " + std::to_string(g_npcFilterMap.size()) + " plugins", __LINE__);
-    WriteToAdvancedLog("Enabled plugins: " + std::to_string(enabledCount), __LINE__);
+    WriteToAdvancedLog("Filter loaded: " + std::to_string(g_npcFilterList.Size()) + " plugins", __LINE__);
+    WriteToAdvancedLog("Enabled plugins: " + std::to_string(g_npcFilterList.EnabledCount()), __LINE__);
     
     auto* dataHandler = RE::TESDataHandler::GetSingleton();
     if (!dataHandler) {
@@ -2114,21 +3028,17 @@ std::vector<PluginNPCListData> ScanFilteredPluginsForNPCList() {
     WriteToAdvancedLog("Scanning NPCs (filtered)...", __LINE__);
     int npcCount = 0;
     int npcSkipped = 0;
-    auto& npcs = dataHandler->GetFormArray<RE::TESNPC>();
     
-    for (auto* npc : npcs) {
-        if (!npc) continue;
-        
+    ForEachFormOnMainThread<RE::TESNPC>([&](RE::TESNPC* npc) {
         auto* file = npc->GetFile(0);
-        if (!file) continue;
+        if (!file) return;
         
         std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
+        if (pluginName.empty()) return;
         
-        auto it = g_npcFilterMap.find(pluginName);
-        if (it == g_npcFilterMap.end() || !it->second) {
+        if (!g_npcFilterList.EnabledByID(GetPluginID(file))) {
             npcSkipped++;
-            continue;
+            return;
         }
         
         NPCBasicData npcData;
@@ -2166,14 +3076,14 @@ std::vector<PluginNPCListData> ScanFilteredPluginsForNPCList() {
             pluginMap[pluginName] = newPluginData;
         }
         
-        pluginMap[pluginName].npcs.push_back(npcData);
+        pluginMap[pluginName].npcs.push_back(std::move(npcData));
         npcCount++;
-    }
+    }, "NPCs (ScanFilteredPluginsForNPCList)");
     
     WriteToAdvancedLog("NPCs scanned: " + std::to_string(npcCount) + " (skipped: " + std::to_string(npcSkipped) + ")", __LINE__);
     
     for (auto& [pluginName, pluginData] : pluginMap) {
-        npcDataList.push_back(pluginData);
+        npcDataList.push_back(std::move(pluginData));
     }
     
     WriteToAdvancedLog("========================================", __LINE__);
@@ -2287,7 +3197,7 @@ void ExecuteNPCCountScanning() {
     }
     
     WriteToAdvancedLog("Resetting startNPCs flag to false...", __LINE__);
-    g_pluginNPCsConfig.startNPCs = false;
+    UpdateAct2ManagerConfig([] { g_pluginNPCsConfig.startNPCs = false; });
     SaveNPCTrackingConfig();
     
     WriteToAdvancedLog("========================================", __LINE__);
@@ -2312,7 +3222,7 @@ void ExecuteNPCListScanning() {
     }
     
     WriteToAdvancedLog("Resetting Plugin_listNPCs flag to false...", __LINE__);
-    g_pluginNPCsConfig.pluginListNPCs = false;
+    UpdateAct2ManagerConfig([] { g_pluginNPCsConfig.pluginListNPCs = false; });
     SaveNPCTrackingConfig();
     
     WriteToAdvancedLog("========================================", __LINE__);
@@ -2320,688 +3230,1072 @@ void ExecuteNPCListScanning() {
     WriteToAdvancedLog("========================================", __LINE__);
 }
 
-std::vector<PluginOutfitsData> ScanAllPluginsForItems() {
-    std::vector<PluginOutfitsData> pluginDataList;
-    
+std::unique_ptr<FormCatalog> ScanAllPluginsForItems() {
     WriteToAdvancedLog("========================================", __LINE__);
     WriteToAdvancedLog("PLUGIN OUTFITS SCANNING STARTED (ALL PLUGINS)", __LINE__);
     WriteToAdvancedLog("========================================", __LINE__);
     
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (!dataHandler) {
+    if (!RE::TESDataHandler::GetSingleton()) {
         WriteToAdvancedLog("ERROR: Could not get TESDataHandler", __LINE__);
-        return pluginDataList;
+        return nullptr;
     }
     
-    std::unordered_map<std::string, PluginOutfitsData> pluginMap;
+    auto catalog = std::make_unique<FormCatalog>();
+    if (!FillCatalogFromFormArrays(*catalog, nullptr)) {
+        WriteToAdvancedLog("ERROR: Plugin outfits scan did not complete", __LINE__);
+        return nullptr;
+    }
     
-    WriteToAdvancedLog("Scanning armors...", __LINE__);
-    int armorCount = 0;
-    auto& armors = dataHandler->GetFormArray<RE::TESObjectARMO>();
-    for (auto* armor : armors) {
-        if (!armor) continue;
-        
-        auto* file = armor->GetFile(0);
-        if (!file) continue;
-        
-        std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
-        
-        PluginItemData itemData;
-        
-        const char* editorID = armor->GetFormEditorID();
-        if (editorID && strlen(editorID) > 0) {
-            itemData.name = editorID;
-        } else {
-            const char* displayName = armor->GetName();
-            if (displayName && strlen(displayName) > 0) {
-                itemData.name = displayName;
-            } else {
-                itemData.name = "Unnamed Armor";
-            }
-        }
-        
-        itemData.formID = armor->GetFormID();
-        
-        if (pluginMap.find(pluginName) == pluginMap.end()) {
-            PluginOutfitsData newPluginData;
-            newPluginData.pluginName = pluginName;
-            pluginMap[pluginName] = newPluginData;
-        }
-        
-        pluginMap[pluginName].armors.push_back(itemData);
-        armorCount++;
+    WriteToAdvancedLog("========================================", __LINE__);
+    WriteToAdvancedLog("SCANNING COMPLETE", __LINE__);
+    WriteToAdvancedLog("Total plugins: " + std::to_string(catalog->PluginCount()), __LINE__);
+    WriteToAdvancedLog("Total items: " + std::to_string(catalog->Size()), __LINE__);
+    WriteToAdvancedLog("========================================", __LINE__);
+    
+    return catalog;
+}
+
+std::unique_ptr<FormCatalog> ScanFilteredPluginsForItems() {
+    WriteToAdvancedLog("========================================", __LINE__);
+    WriteToAdvancedLog("PLUGIN OUTFITS SCANNING STARTED (FILTERED)", __LINE__);
+    WriteToAdvancedLog("========================================", __LINE__);
+    
+    LoadPluginFilterList();
+    
+    if (g_pluginFilterList.Empty()) {
+        WriteToAdvancedLog("WARNING: No filter loaded, scanning all plugins", __LINE__);
+        return ScanAllPluginsForItems();
     }
-    WriteToAdvancedLog("Total armors scanned: " + std::to_string(armorCount), __LINE__);
     
-    WriteToAdvancedLog("Scanning outfits...", __LINE__);
-    int outfitCount = 0;
-    auto& outfits = dataHandler->GetFormArray<RE::BGSOutfit>();
-    for (auto* outfit : outfits) {
-        if (!outfit) continue;
-        
-        auto* file = outfit->GetFile(0);
-        if (!file) continue;
-        
-        std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
-        
-        PluginOutfitData outfitData;
-        
-        const char* editorID = outfit->GetFormEditorID();
-        if (editorID && strlen(editorID) > 0) {
-            outfitData.name = editorID;
-        } else {
-            const char* displayName = outfit->GetName();
-            if (displayName && strlen(displayName) > 0) {
-                outfitData.name = displayName;
-            } else {
-                outfitData.name = "Unnamed Outfit";
-            }
-        }
-        
-        outfitData.formID = outfit->GetFormID();
-        outfitData.items = GetOutfitItems(outfit);
-        
-        if (pluginMap.find(pluginName) == pluginMap.end()) {
-            PluginOutfitsData newPluginData;
-            newPluginData.pluginName = pluginName;
-            pluginMap[pluginName] = newPluginData;
-        }
-        
-        pluginMap[pluginName].outfits.push_back(outfitData);
-        outfitCount++;
+    WriteToAdvancedLog("Filter loaded: " + std::to_string(g_pluginFilterList.Size()) + " plugins", __LINE__);
+    WriteToAdvancedLog("Enabled plugins: " + std::to_string(g_pluginFilterList.EnabledCount()), __LINE__);
+    
+    if (!RE::TESDataHandler::GetSingleton()) {
+        WriteToAdvancedLog("ERROR: Could not get TESDataHandler", __LINE__);
+        return nullptr;
     }
-    WriteToAdvancedLog("Total outfits scanned: " + std::to_string(outfitCount), __LINE__);
     
-    WriteToAdvancedLog("Scanning weapons...", __LINE__);
-    int weaponCount = 0;
-    auto& weapons = dataHandler->GetFormArray<RE::TESObjectWEAP>();
-    for (auto* weapon : weapons) {
-        if (!weapon) continue;
-        
-        auto* file = weapon->GetFile(0);
-        if (!file) continue;
+    auto catalog = std::make_unique<FormCatalog>();
+    if (!FillCatalogFromFormArrays(*catalog, &g_pluginFilterList)) {
+        WriteToAdvancedLog("ERROR: Filtered plugin outfits scan did not complete", __LINE__);
+        return nullptr;
+    }
+    
+    WriteToAdvancedLog("========================================", __LINE__);
+    WriteToAdvancedLog("FILTERED SCANNING COMPLETE", __LINE__);
+    WriteToAdvancedLog("Plugins included: " + std::to_string(catalog->PluginCount()), __LINE__);
+    WriteToAdvancedLog("Total items: " + std::to_string(catalog->Size()), __LINE__);
+    WriteToAdvancedLog("========================================", __LINE__);
+    
+    return catalog;
+}
+
+void WritePluginOutfitsJSON(std::ostream& jsonFile, FormCatalog& catalog) {
+    size_t totalArmors = catalog.CountOfType(CatalogFormType::kArmor);
+    size_t totalOutfits = catalog.CountOfType(CatalogFormType::kOutfit);
+    size_t totalWeapons = catalog.CountOfType(CatalogFormType::kWeapon);
+    
+    auto grouping = catalog.GroupByPluginAndType();
+    
+    jsonFile << "{\n";
+    jsonFile << "  \"timestamp\": \"" << GetCurrentTimeString() << "\",\n";
+    jsonFile << "  \"total_plugins\": " << catalog.PluginCount() << ",\n";
+    jsonFile << "  \"total_armors\": " << totalArmors << ",\n";
+    jsonFile << "  \"total_outfits\": " << totalOutfits << ",\n";
+    jsonFile << "  \"total_weapons\": " << totalWeapons << ",\n";
+    jsonFile << "  \"plugins\": {\n";
+    
+    auto writeItemRows = [&](std::uint16_t pluginID, CatalogFormType type) {
+        std::uint32_t begin = grouping.Begin(pluginID, type);
+        std::uint32_t end = grouping.End(pluginID, type);
+        for (std::uint32_t j = begin; j < end; ++j) {
+            std::uint32_t row = grouping.rows[j];
+            jsonFile << "        {\n";
+            jsonFile << "          \"name\": \"" << catalog.GetName(row) << "\",\n";
+            jsonFile << "          \"form_id\": \"0x" << std::hex << std::uppercase << catalog.GetFormID(row) << std::dec << "\"\n";
+            jsonFile << "        }" << (j + 1 < end ? "," : "") << "\n";
+        }
+    };
+    
+    for (size_t i = 0; i < catalog.PluginCount(); ++i) {
+        auto pluginID = static_cast<std::uint16_t>(i);
         
-        std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
+        jsonFile << "    \"" << catalog.GetPluginName(pluginID) << "\": {\n";
         
-        PluginItemData itemData;
+        jsonFile << "      \"armors\": [\n";
+        writeItemRows(pluginID, CatalogFormType::kArmor);
+        jsonFile << "      ],\n";
         
-        const char* editorID = weapon->GetFormEditorID();
-        if (editorID && strlen(editorID) > 0) {
-            itemData.name = editorID;
-        } else {
-            const char* displayName = weapon->GetName();
-            if (displayName && strlen(displayName) > 0) {
-                itemData.name = displayName;
-            } else {
-                itemData.name = "Unnamed Weapon";
+        jsonFile << "      \"outfits\": [\n";
+        std::uint32_t outfitBegin = grouping.Begin(pluginID, CatalogFormType::kOutfit);
+        std::uint32_t outfitEnd = grouping.End(pluginID, CatalogFormType::kOutfit);
+        for (std::uint32_t j = outfitBegin; j < outfitEnd; ++j) {
+            std::uint32_t row = grouping.rows[j];
+            jsonFile << "        {\n";
+            jsonFile << "          \"name\": \"" << catalog.GetName(row) << "\",\n";
+            jsonFile << "          \"form_id\": \"0x" << std::hex << std::uppercase << catalog.GetFormID(row) << std::dec << "\",\n";
+            jsonFile << "          \"items\": [\n";
+            
+            size_t itemEnd = catalog.ItemEnd(row);
+            for (size_t k = catalog.ItemBegin(row); k < itemEnd; ++k) {
+                jsonFile << "            {\n";
+                jsonFile << "              \"name\": \"" << catalog.GetItemName(k) << "\",\n";
+                jsonFile << "              \"form_id\": \"0x" << std::hex << std::uppercase << catalog.GetItemFormID(k) << std::dec << "\"\n";
+                jsonFile << "            }" << (k + 1 < itemEnd ? "," : "") << "\n";
             }
+            
+            jsonFile << "          ]\n";
+            jsonFile << "        }" << (j + 1 < outfitEnd ? "," : "") << "\n";
         }
+        jsonFile << "      ],\n";
         
-        itemData.formID = weapon->GetFormID();
-        
-        if (pluginMap.find(pluginName) == pluginMap.end()) {
-            PluginOutfitsData newPluginData;
-            newPluginData.pluginName = pluginName;
-            pluginMap[pluginName] = newPluginData;
-        }
+        jsonFile << "      \"weapons\": [\n";
+        writeItemRows(pluginID, CatalogFormType::kWeapon);
+        jsonFile << "      ]\n";
         
-        pluginMap[pluginName].weapons.push_back(itemData);
-        weaponCount++;
+        jsonFile << "    }" << (i + 1 < catalog.PluginCount() ? "," : "") << "\n";
     }
-    WriteToAdvancedLog("Total weapons scanned: " + std::to_string(weaponCount), __LINE__);
     
-    for (auto& [pluginName, pluginData] : pluginMap) {
-        pluginDataList.push_back(pluginData);
+    jsonFile << "  }\n";
+    jsonFile << "}\n";
+}
+
+void ExportPluginOutfitsToJSON(FormCatalog& catalog) {
+    std::ofstream jsonFile(g_pluginOutfitsJsonPath, std::ios::trunc);
+    if (!jsonFile.is_open()) {
+        WriteToAdvancedLog("ERROR: Could not create Act2_Outfits.json", __LINE__);
+        return;
     }
     
-    WriteToAdvancedLog("========================================", __LINE__);
-    WriteToAdvancedLog("SCANNING COMPLETE", __LINE__);
-    WriteToAdvancedLog("Total plugins: " + std::to_string(pluginDataList.size()), __LINE__);
-    WriteToAdvancedLog("Total items: " + std::to_string(armorCount + outfitCount + weaponCount), __LINE__);
-    WriteToAdvancedLog("========================================", __LINE__);
+    WritePluginOutfitsJSON(jsonFile, catalog);
+    jsonFile.close();
     
-    return pluginDataList;
+    WriteToAdvancedLog("Successfully exported plugin outfits data to Act2_Outfits.json", __LINE__);
+    WriteToAdvancedLog("Total plugins: " + std::to_string(catalog.PluginCount()), __LINE__);
+    WriteToAdvancedLog("Total armors: " + std::to_string(catalog.CountOfType(CatalogFormType::kArmor)), __LINE__);
+    WriteToAdvancedLog("Total outfits: " + std::to_string(catalog.CountOfType(CatalogFormType::kOutfit)), __LINE__);
+    WriteToAdvancedLog("Total weapons: " + std::to_string(catalog.CountOfType(CatalogFormType::kWeapon)), __LINE__);
 }
 
-std::vector<PluginOutfitsData> ScanFilteredPluginsForItems() {
-    std::vector<PluginOutfitsData> pluginDataList;
+void ExecutePluginOutfitsScanning() {
+    WriteToAdvancedLog("========================================", __LINE__);
+    WriteToAdvancedLog("PLUGIN OUTFITS SCANNING SYSTEM ACTIVATED", __LINE__);
+    WriteToAdvancedLog("========================================", __LINE__);
+    
+    WriteToAdvancedLog("Mode: FULL OUTFIT SCAN", __LINE__);
+    
+    std::unique_ptr<FormCatalog> catalog;
+    
+    if (fs::exists(g_pluginFilterIniPath)) {
+        WriteToAdvancedLog("Act2_Plugins.ini found, using filtered scan", __LINE__);
+        catalog = ScanFilteredPluginsForItems();
+    } else {
+        WriteToAdvancedLog("Act2_Plugins.ini not found, scanning all plugins", __LINE__);
+        catalog = ScanAllPluginsForItems();
+    }
+    
+    if (!catalog || catalog->Size() == 0) {
+        WriteToAdvancedLog("WARNING: No plugin data found", __LINE__);
+    } else {
+        WriteToAdvancedLog("Exporting plugin outfits to JSON...", __LINE__);
+        ExportPluginOutfitsToJSON(*catalog);
+        LogCatalogFootprint(*catalog, "Plugin outfits");
+    }
+    
+    // The whole arena goes back in one release
+    catalog.reset();
+    
+    WriteToAdvancedLog("Resetting start flag to false...", __LINE__);
+    UpdateAct2ManagerConfig([] { g_pluginOutfitsConfig.start = false; });
+    SavePluginOutfitsConfig();
     
     WriteToAdvancedLog("========================================", __LINE__);
-    WriteToAdvancedLog("PLUGIN OUTFITS SCANNING STARTED (FILTERED)", __LINE__);
+    WriteToAdvancedLog("PLUGIN OUTFITS SCANNING COMPLETE", __LINE__);
     WriteToAdvancedLog("========================================", __LINE__);
+}
+
+std::string EscapeJSONString(std::string_view text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        if (static_cast<unsigned char>(c) < 0x20) continue;
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Compact per-actor faction list: {"id": <dictionary index>, "rank": <rank>} on one line
+void WriteFactionRefsJSON(std::ostream& out, const FactionMembership& factions) {
+    for (size_t i = 0; i < factions.ranks.size(); ++i) {
+        const auto& entry = factions.ranks[i];
+        out << (i > 0 ? ", " : "") << "{\"id\": " << entry.index << ", \"rank\": " << static_cast<int>(entry.rank) << "}";
+    }
+}
+
+void WriteFactionDictionaryJSON(std::ostream& out, FactionDictionary& dictionary, const FactionBitset& referenced) {
+    auto entries = dictionary.Collect(referenced);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto& [index, entry] = entries[i];
+        out << "    {\"id\": " << index
+            << ", \"form_id\": \"0x" << std::hex << std::uppercase << entry.formID << std::dec << "\""
+            << ", \"editor_id\": \"" << EscapeJSONString(entry.editorID.empty() ? "Unknown" : entry.editorID) << "\""
+            << ", \"name\": \"" << EscapeJSONString(entry.name) << "\"}"
+            << (i + 1 < entries.size() ? "," : "") << "\n";
+    }
+}
+
+// Names of the predicate flags set in the mask, e.g. "vampire", "follower"
+void WriteActorFlagsJSON(std::ostream& out, std::uint32_t flags, const std::vector<std::string>& names) {
+    bool first = true;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (!(flags & (std::uint32_t{1} << i))) continue;
+        out << (first ? "" : ", ") << "\"" << names[i] << "\"";
+        first = false;
+    }
+}
+
+void ExportNPCDataToJSON(const std::vector<NPCData>& npcList, const NPCData& playerData, const std::vector<DistanceRing>& rings,
+                         const FactionQueryResult& factionQuery) {
+    std::ofstream jsonFile(g_npcTrackingJsonPath, std::ios::trunc);
+    if (!jsonFile.is_open()) {
+        WriteToAdvancedLog("ERROR: Could not create Act2_Manager.json", __LINE__);
+        return;
+    }
     
-    LoadPluginFilterList();
+    const auto flagNames = g_actorPredicates.Names();
+    const auto config = GetAct2ManagerConfig();
     
-    if (g_pluginFilterMap.empty()) {
-        WriteToAdvancedLog("WARNING: No filter loaded, scanning all plugins", __LINE__);
-        return ScanAllPluginsForItems();
+    jsonFile << "{\n";
+    jsonFile << "  \"timestamp\": \"" << GetCurrentTimeString() << "\",\n";
+    jsonFile << "  \"scan_radius\": " << config->npcTracking.radio << ",\n";
+    jsonFile << "  \"total_npcs\": " << npcList.size() << ",\n";
+    jsonFile << "  \"max_results\": " << config->npcTracking.maxResults << ",\n";
+    jsonFile << "  \"rings\": [";
+    for (size_t i = 0; i < rings.size(); ++i) {
+        jsonFile << (i > 0 ? ", " : "") << "{\"min\": " << rings[i].minDistance << ", \"max\": " << rings[i].maxDistance
+                 << ", \"in_range\": " << rings[i].inRange << ", \"returned\": " << rings[i].returned << "}";
     }
+    jsonFile << "],\n";
+    jsonFile << "  \"faction_query\": {\"factions\": [";
+    for (size_t i = 0; i < factionQuery.factions.ranks.size(); ++i) {
+        jsonFile << (i > 0 ? ", " : "") << factionQuery.factions.ranks[i].index;
+    }
+    jsonFile << "], \"ref_ids\": [";
+    for (size_t i = 0; i < factionQuery.refIDs.size(); ++i) {
+        jsonFile << (i > 0 ? ", " : "") << "\"0x" << std::hex << std::uppercase << factionQuery.refIDs[i] << std::dec << "\"";
+    }
+    jsonFile << "]},\n";
+    jsonFile << "  \"player\": {\n";
+    jsonFile << "    \"name\": \"" << playerData.name << "\",\n";
+    jsonFile << "    \"editor_id\": \"" << playerData.editorID << "\",\n";
+    jsonFile << "    \"plugin\": \"" << playerData.pluginName << "\",\n";
+    jsonFile << "    \"race\": \"" << playerData.race << "\",\n";
+    jsonFile << "    \"gender\": \"" << playerData.gender << "\",\n";
+    jsonFile << "    \"is_vampire\": " << (playerData.isVampire ? "true" : "false") << ",\n";
+    jsonFile << "    \"is_werewolf\": " << (playerData.isWerewolf ? "true" : "false") << ",\n";
+    jsonFile << "    \"flags\": [";
+    WriteActorFlagsJSON(jsonFile, playerData.actorFlags, flagNames);
+    jsonFile << "],\n";
+    jsonFile << "    \"ref_id\": \"0x" << std::hex << std::uppercase << playerData.refID << std::dec << "\",\n";
+    jsonFile << "    \"base_id\": \"0x" << std::hex << std::uppercase << playerData.baseID << std::dec << "\",\n";
+    jsonFile << "    \"form_id\": \"0x" << std::hex << std::uppercase << playerData.formID << std::dec << "\",\n";
+    jsonFile << "    \"factions\": [";
+    WriteFactionRefsJSON(jsonFile, playerData.factions);
+    jsonFile << "],\n";
+    jsonFile << "    \"equipped_items\": {\n";
+    
+    WriteEquippedItemsJSON(jsonFile, playerData.equippedItems, "      ");
     
-    int enabledCount = 0;
-    for (const auto& [plugin, enabled] : g_pluginFilterMap) {
-        if (enabled) enabledCount++;
+    jsonFile << "    }\n";
+    jsonFile << "  },\n";
+    jsonFile << "  \"npcs\": [\n";
+    
+    // Each NPC block is formatted on a worker and written in scan order
+    std::vector<std::string> npcBlocks(npcList.size());
+    ParallelFor(npcList.size(), [&](size_t i) {
+        const auto& npc = npcList[i];
+        std::ostringstream npcJson;
+        npcJson << "    {\n";
+        npcJson << "      \"name\": \"" << npc.name << "\",\n";
+        npcJson << "      \"editor_id\": \"" << npc.editorID << "\",\n";
+        npcJson << "      \"plugin\": \"" << npc.pluginName << "\",\n";
+        npcJson << "      \"race\": \"" << npc.race << "\",\n";
+        npcJson << "      \"gender\": \"" << npc.gender << "\",\n";
+        npcJson << "      \"is_vampire\": " << (npc.isVampire ? "true" : "false") << ",\n";
+        npcJson << "      \"is_werewolf\": " << (npc.isWerewolf ? "true" : "false") << ",\n";
+        npcJson << "      \"flags\": [";
+        WriteActorFlagsJSON(npcJson, npc.actorFlags, flagNames);
+        npcJson << "],\n";
+        npcJson << "      \"ref_id\": \"0x" << std::hex << std::uppercase << npc.refID << std::dec << "\",\n";
+        npcJson << "      \"base_id\": \"0x" << std::hex << std::uppercase << npc.baseID << std::dec << "\",\n";
+        npcJson << "      \"form_id\": \"0x" << std::hex << std::uppercase << npc.formID << std::dec << "\",\n";
+        npcJson << "      \"distance_from_player\": " << std::fixed << std::setprecision(2) << npc.distanceFromPlayer << ",\n";
+        npcJson << "      \"factions\": [";
+        WriteFactionRefsJSON(npcJson, npc.factions);
+        npcJson << "],\n";
+        npcJson << "      \"equipped_items\": {\n";
+        
+        WriteEquippedItemsJSON(npcJson, npc.equippedItems, "        ");
+        
+        npcJson << "      }\n";
+        npcJson << "    }" << (i < npcList.size() - 1 ? "," : "") << "\n";
+        npcBlocks[i] = npcJson.str();
+    });
+    
+    for (const auto& block : npcBlocks) {
+        jsonFile << block;
     }
     
-    WriteToAdvancedLog("Filter loaded: " + std::to_string(g_pluginFilterMap.size()) + " plugins", __LINE__);
-    WriteToAdvancedLog("Enabled plugins: " + std::to_string(enabledCount), __LINE__);
+    jsonFile << "  ],\n";
     
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (!dataHandler) {
-        WriteToAdvancedLog("ERROR: Could not get TESDataHandler", __LINE__);
-        return pluginDataList;
+    FactionBitset referenced = playerData.factions.bits;
+    MergeFactionBits(referenced, factionQuery.factions.bits);
+    for (const auto& npc : npcList) {
+        MergeFactionBits(referenced, npc.factions.bits);
     }
     
-    std::unordered_map<std::string, PluginOutfitsData> pluginMap;
+    jsonFile << "  \"faction_dictionary\": [\n";
+    WriteFactionDictionaryJSON(jsonFile, g_factionDictionary, referenced);
+    jsonFile << "  ]\n";
+    jsonFile << "}\n";
     
-    WriteToAdvancedLog("Scanning armors (filtered)...", __LINE__);
-    int armorCount = 0;
-    int armorSkipped = 0;
-    auto& armors = dataHandler->GetFormArray<RE::TESObjectARMO>();
-    for (auto* armor : armors) {
-        if (!armor) continue;
-        
-        auto* file = armor->GetFile(0);
-        if (!file) continue;
-        
-        std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
-        
-        auto it = g_pluginFilterMap.find(pluginName);
-        if (it == g_pluginFilterMap.end() || !it->second) {
-            armorSkipped++;
-            continue;
+    jsonFile.close();
+    
+    WriteToAdvancedLog("Successfully exported NPC data to Act2_Manager.json", __LINE__);
+    WriteToAdvancedLog("Total entries: 1 player + " + std::to_string(npcList.size()) + " NPCs", __LINE__);
+}
+
+// ===== SIGHTING HISTORY =====
+// Every NPC sighting (one-shot scans, and entered/moved/equipment events of continuous tracking)
+// becomes a fixed 24-byte record in an in-memory ring buffer. Records not yet on disk are
+// appended to Act2_History.bin every flush_interval_s; when the file grows past its limit the
+// newest half is kept. Queries stream the file in fixed-size chunks (newest first where that
+// allows an early stop) instead of loading it, and [History] query = last_seen | cell |
+// equipment_changes with target = 0x... writes the answer to Act2_History.json.
+
+struct SightingRecord {
+    std::int64_t time;
+    RE::FormID refID;
+    RE::FormID cellID;
+    float distance;
+    std::uint32_t equipmentHash;
+};
+
+static_assert(sizeof(SightingRecord) == 24 && std::is_trivially_copyable_v<SightingRecord>);
+
+constexpr size_t kSightingRingCapacity = 8192;
+constexpr std::uintmax_t kSightingLogMaxBytes = 8 * 1024 * 1024;
+constexpr size_t kSightingChunkRecords = 4096;
+constexpr size_t kSightingQueryLimit = 500;
+constexpr char kSightingLogMagic[4] = {'A', '2', 'S', 'H'};
+
+struct SightingLogHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(SightingLogHeader) == 16);
+
+// FNV-1a over the slot FormIDs; only used to notice that an NPC changed clothes
+std::uint32_t HashEquippedFormIDs(const EquippedFormIDs& equipment) {
+    std::uint32_t hash = 2166136261u;
+    for (RE::FormID id : equipment) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash ^= (id >> shift) & 0xFF;
+            hash *= 16777619u;
         }
-        
-        PluginItemData itemData;
-        
-        const char* editorID = armor->GetFormEditorID();
-        if (editorID && strlen(editorID) > 0) {
-            itemData.name = editorID;
+    }
+    return hash;
+}
+
+class SightingHistory {
+public:
+    explicit SightingHistory(size_t capacity) : ring(capacity) {}
+
+    void Record(const SightingRecord& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ring[head] = record;
+        head = (head + 1) % ring.size();
+        count = std::min(count + 1, ring.size());
+        if (unflushed == ring.size()) {
+            dropped++;
         } else {
-            const char* displayName = armor->GetName();
-            if (displayName && strlen(displayName) > 0) {
-                itemData.name = displayName;
-            } else {
-                itemData.name = "Unnamed Armor";
-            }
+            unflushed++;
         }
-        
-        itemData.formID = armor->GetFormID();
-        
-        if (pluginMap.find(pluginName) == pluginMap.end()) {
-            PluginOutfitsData newPluginData;
-            newPluginData.pluginName = pluginName;
-            pluginMap[pluginName] = newPluginData;
+    }
+
+    // Appends the records added since the last flush; compacts the file when it is too large
+    bool Flush(const fs::path& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (unflushed == 0) return true;
+
+        if (!ValidLogFile(path)) {
+            std::ofstream fresh(path, std::ios::binary | std::ios::trunc);
+            if (!fresh.is_open()) return false;
+            SightingLogHeader header{{kSightingLogMagic[0], kSightingLogMagic[1], kSightingLogMagic[2], kSightingLogMagic[3]},
+                                     1, sizeof(SightingRecord), 0};
+            fresh.write(reinterpret_cast<const char*>(&header), sizeof(header));
         }
-        
-        pluginMap[pluginName].armors.push_back(itemData);
-        armorCount++;
+
+        std::ofstream log(path, std::ios::binary | std::ios::app);
+        if (!log.is_open()) return false;
+        for (size_t i = unflushed; i > 0; --i) {
+            const auto& record = At(i - 1);
+            log.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+        log.close();
+        if (!log) return false;
+
+        flushed += unflushed;
+        unflushed = 0;
+
+        std::error_code ec;
+        if (fs::file_size(path, ec) > kSightingLogMaxBytes && !ec) {
+            Compact(path);
+        }
+        return true;
     }
-    WriteToAdvancedLog("Armors scanned: " + std::to_string(armorCount) + " (skipped: " + std::to_string(armorSkipped) + ")", __LINE__);
-    
-    WriteToAdvancedLog("Scanning outfits (filtered)...", __LINE__);
-    int outfitCount = 0;
-    int outfitSkipped = 0;
-    auto& outfits = dataHandler->GetFormArray<RE::BGSOutfit>();
-    for (auto* outfit : outfits) {
-        if (!outfit) continue;
-        
-        auto* file = outfit->GetFile(0);
-        if (!file) continue;
-        
-        std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
-        
-        auto it = g_pluginFilterMap.find(pluginName);
-        if (it == g_pluginFilterMap.end() || !it->second) {
-            outfitSkipped++;
-            continue;
+
+    // Visits records from newest to oldest until visit returns false
+    template <class Visit>
+    void VisitNewestFirst(const fs::path& path, Visit&& visit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < unflushed; ++i) {
+            if (!visit(At(i))) return;
         }
-        
-        PluginOutfitData outfitData;
-        
-        const char* editorID = outfit->GetFormEditorID();
-        if (editorID && strlen(editorID) > 0) {
-            outfitData.name = editorID;
-        } else {
-            const char* displayName = outfit->GetName();
-            if (displayName && strlen(displayName) > 0) {
-                outfitData.name = displayName;
-            } else {
-                outfitData.name = "Unnamed Outfit";
+
+        std::ifstream log(path, std::ios::binary);
+        size_t total = RecordsInFile(log);
+        std::vector<SightingRecord> chunk;
+        while (total > 0) {
+            size_t take = std::min(total, kSightingChunkRecords);
+            total -= take;
+            ReadChunk(log, total, take, chunk);
+            for (size_t i = chunk.size(); i > 0; --i) {
+                if (!visit(chunk[i - 1])) return;
             }
         }
-        
-        outfitData.formID = outfit->GetFormID();
-        outfitData.items = GetOutfitItems(outfit);
-        
-        if (pluginMap.find(pluginName) == pluginMap.end()) {
-            PluginOutfitsData newPluginData;
-            newPluginData.pluginName = pluginName;
-            pluginMap[pluginName] = newPluginData;
+    }
+
+    // Visits records from oldest to newest
+    template <class Visit>
+    void VisitOldestFirst(const fs::path& path, Visit&& visit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ifstream log(path, std::ios::binary);
+        size_t total = RecordsInFile(log);
+        std::vector<SightingRecord> chunk;
+        for (size_t first = 0; first < total; first += kSightingChunkRecords) {
+            ReadChunk(log, first, std::min(kSightingChunkRecords, total - first), chunk);
+            for (const auto& record : chunk) visit(record);
+        }
+
+        for (size_t i = unflushed; i > 0; --i) {
+            visit(At(i - 1));
         }
-        
-        pluginMap[pluginName].outfits.push_back(outfitData);
-        outfitCount++;
     }
-    WriteToAdvancedLog("Outfits scanned: " + std::to_string(outfitCount) + " (skipped: " + std::to_string(outfitSkipped) + ")", __LINE__);
-    
-    WriteToAdvancedLog("Scanning weapons (filtered)...", __LINE__);
-    int weaponCount = 0;
-    int weaponSkipped = 0;
-    auto& weapons = dataHandler->GetFormArray<RE::TESObjectWEAP>();
-    for (auto* weapon : weapons) {
-        if (!weapon) continue;
-        
-        auto* file = weapon->GetFile(0);
-        if (!file) continue;
-        
-        std::string pluginName = file->fileName;
-        if (pluginName.empty()) continue;
-        
-        auto it = g_pluginFilterMap.find(pluginName);
-        if (it == g_pluginFilterMap.end() || !it->second) {
-            weaponSkipped++;
-            continue;
+
+    std::string Stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::to_string(count) + " in memory, " + std::to_string(unflushed) + " pending, " +
+               std::to_string(flushed) + " flushed, " + std::to_string(dropped) + " dropped";
+    }
+
+private:
+    // 0 is the newest record
+    const SightingRecord& At(size_t age) const {
+        return ring[(head + ring.size() - 1 - age) % ring.size()];
+    }
+
+    static bool ValidLogFile(const fs::path& path) {
+        std::ifstream log(path, std::ios::binary);
+        SightingLogHeader header{};
+        if (!log.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+        return std::equal(std::begin(header.magic), std::end(header.magic), kSightingLogMagic) &&
+               header.version == 1 && header.recordSize == sizeof(SightingRecord);
+    }
+
+    static size_t RecordsInFile(std::ifstream& log) {
+        SightingLogHeader header{};
+        if (!log.is_open() || !log.read(reinterpret_cast<char*>(&header), sizeof(header))) return 0;
+        if (!std::equal(std::begin(header.magic), std::end(header.magic), kSightingLogMagic) ||
+            header.recordSize != sizeof(SightingRecord)) {
+            return 0;
         }
-        
-        PluginItemData itemData;
-        
-        const char* editorID = weapon->GetFormEditorID();
-        if (editorID && strlen(editorID) > 0) {
-            itemData.name = editorID;
-        } else {
-            const char* displayName = weapon->GetName();
-            if (displayName && strlen(displayName) > 0) {
-                itemData.name = displayName;
-            } else {
-                itemData.name = "Unnamed Weapon";
-            }
+        log.seekg(0, std::ios::end);
+        auto size = static_cast<size_t>(log.tellg());
+        return (size - sizeof(header)) / sizeof(SightingRecord);
+    }
+
+    static void ReadChunk(std::ifstream& log, size_t first, size_t records, std::vector<SightingRecord>& chunk) {
+        chunk.resize(records);
+        log.clear();
+        log.seekg(static_cast<std::streamoff>(sizeof(SightingLogHeader) + first * sizeof(SightingRecord)));
+        log.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(records * sizeof(SightingRecord)));
+        chunk.resize(static_cast<size_t>(log.gcount()) / sizeof(SightingRecord));
+    }
+
+    // Keeps the newest half of the file, written to a temp file and renamed over the log
+    void Compact(const fs::path& path) {
+        std::ifstream log(path, std::ios::binary);
+        size_t total = RecordsInFile(log);
+        size_t keep = total / 2;
+        std::vector<SightingRecord> tail;
+        ReadChunk(log, total - keep, keep, tail);
+        log.close();
+
+        fs::path tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            SightingLogHeader header{{kSightingLogMagic[0], kSightingLogMagic[1], kSightingLogMagic[2], kSightingLogMagic[3]},
+                                     1, sizeof(SightingRecord), 0};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(tail.data()), static_cast<std::streamsize>(tail.size() * sizeof(SightingRecord)));
         }
-        
-        itemData.formID = weapon->GetFormID();
-        
-        if (pluginMap.find(pluginName) == pluginMap.end()) {
-            PluginOutfitsData newPluginData;
-            newPluginData.pluginName = pluginName;
-            pluginMap[pluginName] = newPluginData;
+
+        std::error_code ec;
+        fs::rename(tempPath, path, ec);
+        WriteToAdvancedLog("Act2_History.bin compacted: kept " + std::to_string(tail.size()) + " of " +
+                          std::to_string(total) + " records" + (ec ? " (rename failed: " + ec.message() + ")" : ""), __LINE__);
+    }
+
+    std::mutex mutex;
+    std::vector<SightingRecord> ring;
+    size_t head = 0;
+    size_t count = 0;
+    size_t unflushed = 0;
+    size_t flushed = 0;
+    size_t dropped = 0;
+};
+
+static SightingHistory g_sightingHistory(kSightingRingCapacity);
+static std::chrono::steady_clock::time_point g_lastSightingFlush = std::chrono::steady_clock::now();
+
+void RecordSighting(RE::FormID refID, RE::FormID cellID, float distance, const EquippedFormIDs& equipment) {
+    if (!GetAct2ManagerConfig()->history.record) return;
+    g_sightingHistory.Record({static_cast<std::int64_t>(std::time(nullptr)), refID, cellID, distance,
+                              HashEquippedFormIDs(equipment)});
+}
+
+void FlushSightingHistoryIfDue(bool force = false) {
+    if (g_historyLogPath.empty()) return;
+    auto now = std::chrono::steady_clock::now();
+    if (!force && now - g_lastSightingFlush < std::chrono::seconds(GetAct2ManagerConfig()->history.flushIntervalS)) return;
+    g_lastSightingFlush = now;
+    if (!g_sightingHistory.Flush(g_historyLogPath)) {
+        WriteToAdvancedLog("ERROR: Could not write Act2_History.bin", __LINE__);
+    }
+}
+
+// Bounds the monitor loop's wait so a due flush is not held back
+std::chrono::milliseconds TimeUntilSightingHistoryFlush() {
+    if (g_historyLogPath.empty()) return std::chrono::hours(1);
+    auto due = g_lastSightingFlush + std::chrono::seconds(GetAct2ManagerConfig()->history.flushIntervalS);
+    return std::max(std::chrono::milliseconds(0),
+                    std::chrono::ceil<std::chrono::milliseconds>(due - std::chrono::steady_clock::now()));
+}
+
+std::string FormatUnixTime(std::int64_t time) {
+    std::time_t time_t = static_cast<std::time_t>(time);
+    std::tm buf;
+    localtime_s(&buf, &time_t);
+    std::stringstream ss;
+    ss << std::put_time(&buf, "%Y-%m-%d %H:%M:%S");
+    return ss.str();
+}
+
+void ExecuteHistoryQuery() {
+    const auto config = GetAct2ManagerConfig();
+    const std::string query = config->history.query;
+    RE::FormID target = 0;
+    std::string targetText = config->history.target;
+    if (targetText.starts_with("0x") || targetText.starts_with("0X")) targetText.erase(0, 2);
+    std::from_chars(targetText.data(), targetText.data() + targetText.size(), target, 16);
+
+    WriteToAdvancedLog("History query: " + query + " target: " + config->history.target, __LINE__);
+
+    // Make sure the query sees everything recorded so far
+    FlushSightingHistoryIfDue(true);
+
+    std::vector<SightingRecord> results;
+    if (query == "last_seen") {
+        // With a target: its newest sighting; without: the newest sighting of every NPC
+        std::unordered_set<RE::FormID> seen;
+        g_sightingHistory.VisitNewestFirst(g_historyLogPath, [&](const SightingRecord& record) {
+            if (target != 0 && record.refID != target) return true;
+            if (seen.insert(record.refID).second) results.push_back(record);
+            return target == 0 && results.size() < kSightingQueryLimit;
+        });
+    } else if (query == "cell") {
+        g_sightingHistory.VisitNewestFirst(g_historyLogPath, [&](const SightingRecord& record) {
+            if (record.cellID == target) results.push_back(record);
+            return results.size() < kSightingQueryLimit;
+        });
+    } else if (query == "equipment_changes") {
+        // Oldest first so each record is compared with the previous sighting of the same NPC
+        std::optional<std::uint32_t> previousHash;
+        g_sightingHistory.VisitOldestFirst(g_historyLogPath, [&](const SightingRecord& record) {
+            if (record.refID != target) return;
+            if (!previousHash || *previousHash != record.equipmentHash) results.push_back(record);
+            previousHash = record.equipmentHash;
+        });
+        if (results.size() > kSightingQueryLimit) {
+            results.erase(results.begin(), results.end() - kSightingQueryLimit);
         }
-        
-        pluginMap[pluginName].weapons.push_back(itemData);
-        weaponCount++;
+    } else {
+        WriteToAdvancedLog("WARNING: Unknown history query '" + query + "' (use last_seen, cell or equipment_changes)", __LINE__);
     }
-    WriteToAdvancedLog("Weapons scanned: " + std::to_string(weaponCount) + " (skipped: " + std::to_string(weaponSkipped) + ")", __LINE__);
-    
-    for (auto& [pluginName, pluginData] : pluginMap) {
-        pluginDataList.push_back(pluginData);
+
+    std::ofstream jsonFile(g_historyJsonPath, std::ios::trunc);
+    if (jsonFile.is_open()) {
+        jsonFile << "{\n";
+        jsonFile << "  \"timestamp\": \"" << GetCurrentTimeString() << "\",\n";
+        jsonFile << "  \"query\": \"" << query << "\",\n";
+        jsonFile << "  \"target\": \"0x" << std::hex << std::uppercase << target << std::dec << "\",\n";
+        jsonFile << "  \"history\": \"" << g_sightingHistory.Stats() << "\",\n";
+        jsonFile << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& record = results[i];
+            jsonFile << "    {\"time\": \"" << FormatUnixTime(record.time) << "\", \"ref_id\": \"0x" << std::hex
+                     << std::uppercase << record.refID << "\", \"cell_id\": \"0x" << record.cellID
+                     << "\", \"equipment_hash\": \"0x" << record.equipmentHash << std::dec << "\", \"distance\": "
+                     << std::fixed << std::setprecision(2) << record.distance << "}"
+                     << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        jsonFile << "  ]\n";
+        jsonFile << "}\n";
+        jsonFile.close();
+        WriteToAdvancedLog("History query wrote " + std::to_string(results.size()) + " results to Act2_History.json", __LINE__);
+    } else {
+        WriteToAdvancedLog("ERROR: Could not create Act2_History.json", __LINE__);
     }
-    
+
+    WriteToAdvancedLog("Resetting history query to none...", __LINE__);
+    UpdateAct2ManagerConfig([] { g_historyConfig.query = "none"; });
+    SaveNPCTrackingConfig();
+}
+
+void ExecuteNPCTracking() {
     WriteToAdvancedLog("========================================", __LINE__);
-    WriteToAdvancedLog("FILTERED SCANNING COMPLETE", __LINE__);
-    WriteToAdvancedLog("Plugins included: " + std::to_string(pluginDataList.size()), __LINE__);
-    WriteToAdvancedLog("Total items: " + std::to_string(armorCount + outfitCount + weaponCount), __LINE__);
+    WriteToAdvancedLog("NPC TRACKING SYSTEM ACTIVATED", __LINE__);
     WriteToAdvancedLog("========================================", __LINE__);
     
-    return pluginDataList;
-}
-
-void ExportPluginOutfitsToJSON(const std::vector<PluginOutfitsData>& pluginData) {
-    std::ofstream jsonFile(g_pluginOutfitsJsonPath, std::ios::trunc);
-    if (!jsonFile.is_open()) {
-        WriteToAdvancedLog("ERROR: Could not create Act2_Outfits.json", __LINE__);
+    WriteToAdvancedLog("Capturing player data...", __LINE__);
+    NPCData playerData;
+    RunOnMainThreadBudgeted([&]() {
+        playerData = CapturePlayerData();
+        return false;
+    }, "player capture");
+    
+    if (playerData.name.empty()) {
+        WriteToAdvancedLog("ERROR: Failed to capture player data", __LINE__);
+        UpdateAct2ManagerConfig([] { g_npcTrackingConfig.start = false; });
+        SaveNPCTrackingConfig();
         return;
     }
     
-    int totalArmors = 0;
-    int totalOutfits = 0;
-    int totalWeapons = 0;
+    WriteToAdvancedLog("Player captured: " + playerData.name, __LINE__);
+    const auto config = GetAct2ManagerConfig();
+    WriteToAdvancedLog("Starting NPC scan with radius: " + std::to_string(config->npcTracking.radio), __LINE__);
     
-    for (const auto& plugin : pluginData) {
-        totalArmors += static_cast<int>(plugin.armors.size());
-        totalOutfits += static_cast<int>(plugin.outfits.size());
-        totalWeapons += static_cast<int>(plugin.weapons.size());
+    const float radius = static_cast<float>(config->npcTracking.radio);
+    std::vector<DistanceRing> rings = ParseDistanceRings(config->npcTracking.rings, radius);
+    std::vector<NPCData> npcList = ScanNPCsAroundPlayer(radius, static_cast<size_t>(config->npcTracking.maxResults),
+                                                        rings.empty() ? nullptr : &rings);
+    
+    WriteToAdvancedLog("Scan complete. Found " + std::to_string(npcList.size()) + " NPCs", __LINE__);
+    
+    std::vector<std::string> queryEditorIDs = SplitFilterList(config->npcTracking.factionQuery);
+    FactionQueryResult factionQuery = RunFactionQuery(npcList, queryEditorIDs);
+    if (!queryEditorIDs.empty()) {
+        WriteToAdvancedLog("Faction query: " + std::to_string(factionQuery.factions.size()) + " of " +
+                          std::to_string(queryEditorIDs.size()) + " factions known, " +
+                          std::to_string(factionQuery.refIDs.size()) + " NPCs match", __LINE__);
     }
     
-    jsonFile << "{\n";
-    jsonFile << "  \"timestamp\": \"" << GetCurrentTimeString() << "\",\n";
-    jsonFile << "  \"total_plugins\": " << pluginData.size() << ",\n";
-    jsonFile << "  \"total_armors\": " << totalArmors << ",\n";
-    jsonFile << "  \"total_outfits\": " << totalOutfits << ",\n";
-    jsonFile << "  \"total_weapons\": " << totalWeapons << ",\n";
-    jsonFile << "  \"plugins\": {\n";
+    for (const auto& npc : npcList) {
+        RecordSighting(npc.refID, npc.cellID, npc.distanceFromPlayer, ToEquippedFormIDs(npc.equippedItems));
+    }
     
-    for (size_t i = 0; i < pluginData.size(); ++i) {
-        const auto& plugin = pluginData[i];
-        
-        jsonFile << "    \"" << plugin.pluginName << "\": {\n";
-        
-        jsonFile << "      \"armors\": [\n";
-        for (size_t j = 0; j < plugin.armors.size(); ++j) {
-            const auto& armor = plugin.armors[j];
-            jsonFile << "        {\n";
-            jsonFile << "          \"name\": \"" << armor.name << "\",\n";
-            jsonFile << "          \"form_id\": \"0x" << std::hex << std::uppercase << armor.formID << std::dec << "\"\n";
-            jsonFile << "        }" << (j < plugin.armors.size() - 1 ? "," : "") << "\n";
+    // Game data reads are finished; formatting and disk I/O stay on this worker thread
+    WriteToAdvancedLog("Exporting data to JSON...", __LINE__);
+    
+    ExportNPCDataToJSON(npcList, playerData, rings, factionQuery);
+    
+    WriteToAdvancedLog("Resetting start flag to false...", __LINE__);
+    UpdateAct2ManagerConfig([] { g_npcTrackingConfig.start = false; });
+    SaveNPCTrackingConfig();
+    
+    WriteToAdvancedLog("========================================", __LINE__);
+    WriteToAdvancedLog("NPC TRACKING COMPLETE", __LINE__);
+    WriteToAdvancedLog("========================================", __LINE__);
+}
+
+// ===== CONTINUOUS NPC TRACKING =====
+// With [NPC_tracking] continuous = true the monitor re-evaluates the actors around the player
+// every interval_ms and appends only what changed to Act2_Manager_Stream.jsonl, one JSON object
+// per line: actors entering or leaving the radius, distance moves past distance_threshold and
+// equipment slot changes. A full capture is only taken for actors entering the radius: they are
+// snapshotted in the main-thread step and resolved after it, like a scan.
+
+struct TrackedActorState {
+    float reportedDistance;
+    EquippedFormIDs equipment;
+};
+
+struct ActorTickSample {
+    RE::FormID refID;
+    RE::FormID cellID;
+    float distance;
+    EquippedFormIDs equipment;
+    std::unique_ptr<NPCData> entered;
+};
+
+static std::unordered_map<RE::FormID, TrackedActorState> g_trackedActors;
+static std::uint64_t g_npcTrackingStreamSequence = 0;
+static bool g_continuousTrackingActive = false;
+static std::chrono::steady_clock::time_point g_lastContinuousTick;
+
+constexpr std::uintmax_t kTrackingStreamMaxBytes = 16 * 1024 * 1024;
+
+// Samples every actor inside the radius on the main thread; entrants are snapshotted there and
+// get their full capture resolved afterwards on this thread
+bool SampleTrackedActors(float radius, std::vector<ActorTickSample>& samples) {
+    RE::PlayerCharacter* player = nullptr;
+    RE::TESObjectCELL* playerCell = nullptr;
+    RE::TESWorldSpace* playerWorldspace = nullptr;
+    RE::NiPoint3 playerPos;
+    std::vector<RE::ActorHandle> handles;
+    std::vector<RE::ActorHandle> located;
+    std::vector<GridPoint> gridPoints;
+    std::vector<GridHit> inRange;
+    ActorSnapshot entrants;
+    std::vector<size_t> entrantSamples;
+    bool started = false;
+    bool indexed = false;
+    size_t index = 0;
+    
+    bool completed = RunOnMainThreadBudgeted([&]() {
+        if (!started) {
+            started = true;
+            player = RE::PlayerCharacter::GetSingleton();
+            auto* processLists = RE::ProcessLists::GetSingleton();
+            if (!player || !processLists) return false;
+            
+            playerPos = player->GetPosition();
+            playerCell = player->GetParentCell();
+            playerWorldspace = player->GetWorldspace();
+            
+            handles.assign(processLists->highActorHandles.begin(), processLists->highActorHandles.end());
+            handles.insert(handles.end(), processLists->middleHighActorHandles.begin(), processLists->middleHighActorHandles.end());
+            handles.insert(handles.end(), processLists->lowActorHandles.begin(), processLists->lowActorHandles.end());
+            return true;
         }
-        jsonFile << "      ],\n";
         
-        jsonFile << "      \"outfits\": [\n";
-        for (size_t j = 0; j < plugin.outfits.size(); ++j) {
-            const auto& outfit = plugin.outfits[j];
-            jsonFile << "        {\n";
-            jsonFile << "          \"name\": \"" << outfit.name << "\",\n";
-            jsonFile << "          \"form_id\": \"0x" << std::hex << std::uppercase << outfit.formID << std::dec << "\",\n";
-            jsonFile << "          \"items\": [\n";
-            
-            for (size_t k = 0; k < outfit.items.size(); ++k) {
-                const auto& item = outfit.items[k];
-                jsonFile << "            {\n";
-                jsonFile << "              \"name\": \"" << item.name << "\",\n";
-                jsonFile << "              \"form_id\": \"0x" << std::hex << std::uppercase << item.formID << std::dec << "\"\n";
-                jsonFile << "            }" << (k < outfit.items.size() - 1 ? "," : "") << "\n";
+        if (!indexed) {
+            if (index < handles.size()) {
+                auto actor = handles[index].get();
+                if (actor && actor.get() != player &&
+                    CheckActorInPlayerSpace(actor.get(), playerCell, playerWorldspace) == ActorSkipReason::kNone) {
+                    RE::NiPoint3 pos = actor->GetPosition();
+                    gridPoints.push_back({pos.x, pos.y, pos.z, static_cast<std::uint32_t>(located.size())});
+                    located.push_back(handles[index]);
+                }
+                index++;
+                return true;
             }
             
-            jsonFile << "          ]\n";
-            jsonFile << "        }" << (j < plugin.outfits.size() - 1 ? "," : "") << "\n";
+            SpatialGridIndex grid;
+            grid.Build(std::move(gridPoints));
+            grid.QueryRadius(playerPos.x, playerPos.y, playerPos.z, radius, inRange);
+            indexed = true;
+            index = 0;
+            return !inRange.empty();
         }
-        jsonFile << "      ],\n";
         
-        jsonFile << "      \"weapons\": [\n";
-        for (size_t j = 0; j < plugin.weapons.size(); ++j) {
-            const auto& weapon = plugin.weapons[j];
-            jsonFile << "        {\n";
-            jsonFile << "          \"name\": \"" << weapon.name << "\",\n";
-            jsonFile << "          \"form_id\": \"0x" << std::hex << std::uppercase << weapon.formID << std::dec << "\"\n";
-            jsonFile << "        }" << (j < plugin.weapons.size() - 1 ? "," : "") << "\n";
-        }
-        jsonFile << "      ]\n";
+        if (index >= inRange.size()) return false;
         
-        jsonFile << "    }" << (i < pluginData.size() - 1 ? "," : "") << "\n";
-    }
-    
-    jsonFile << "  }\n";
-    jsonFile << "}\n";
+        const auto& hit = inRange[index++];
+        auto actor = located[hit.id].get();
+        auto* actorBase = actor ? actor->GetActorBase() : nullptr;
+        if (actorBase) {
+            ActorTickSample sample;
+            sample.refID = actor->GetFormID();
+            sample.distance = std::sqrt(hit.distanceSquared);
+            sample.cellID = actor->GetParentCell() ? actor->GetParentCell()->GetFormID() : 0;
+            
+            if (g_trackedActors.find(sample.refID) == g_trackedActors.end()) {
+                SnapshotActor(actor.get(), actorBase, sample.distance, entrants);
+                sample.equipment = entrants.equipment.back();
+                entrantSamples.push_back(samples.size());
+            } else {
+                sample.equipment = ReadEquippedFormIDs(actor.get());
+            }
+            samples.push_back(std::move(sample));
+        }
+        return index < inRange.size();
+    }, "continuous NPC tracking");
     
-    jsonFile.close();
+    if (!completed || !player) return false;
     
-    WriteToAdvancedLog("Successfully exported plugin outfits data to Act2_Outfits.json", __LINE__);
-    WriteToAdvancedLog("Total plugins: " + std::to_string(pluginData.size()), __LINE__);
-    WriteToAdvancedLog("Total armors: " + std::to_string(totalArmors), __LINE__);
-    WriteToAdvancedLog("Total outfits: " + std::to_string(totalOutfits), __LINE__);
-    WriteToAdvancedLog("Total weapons: " + std::to_string(totalWeapons), __LINE__);
+    std::vector<NPCData> entered = ResolveActorSnapshot(entrants);
+    for (size_t i = 0; i < entered.size(); ++i) {
+        samples[entrantSamples[i]].entered = std::make_unique<NPCData>(std::move(entered[i]));
+    }
+    return true;
 }
 
-void ExecutePluginOutfitsScanning() {
-    WriteToAdvancedLog("========================================", __LINE__);
-    WriteToAdvancedLog("PLUGIN OUTFITS SCANNING SYSTEM ACTIVATED", __LINE__);
-    WriteToAdvancedLog("========================================", __LINE__);
-    
-    WriteToAdvancedLog("Mode: FULL OUTFIT SCAN", __LINE__);
-    
-    std::vector<PluginOutfitsData> pluginData;
+std::string FormatTrackingEventHeader(const char* eventName, RE::FormID refID) {
+    std::stringstream ss;
+    ss << "{\"seq\": " << ++g_npcTrackingStreamSequence << ", \"time\": \"" << GetCurrentTimeString()
+       << "\", \"event\": \"" << eventName << "\", \"ref_id\": \"0x" << std::hex << std::uppercase << refID << std::dec << "\"";
+    return ss.str();
+}
+
+void AppendTrackingEvents(const std::vector<std::string>& events) {
+    if (events.empty()) return;
     
-    if (fs::exists(g_pluginFilterIniPath)) {
-        WriteToAdvancedLog("Act2_Plugins.ini found, using filtered scan", __LINE__);
-        pluginData = ScanFilteredPluginsForItems();
-    } else {
-        WriteToAdvancedLog("Act2_Plugins.ini not found, scanning all plugins", __LINE__);
-        pluginData = ScanAllPluginsForItems();
+    std::ofstream stream(g_npcTrackingStreamPath, std::ios::app | std::ios::binary);
+    if (!stream.is_open()) {
+        WriteToAdvancedLog("ERROR: Could not open Act2_Manager_Stream.jsonl", __LINE__);
+        return;
     }
+    for (const auto& line : events) {
+        stream << line << "\n";
+    }
+}
+
+void BeginContinuousTracking() {
+    g_trackedActors.clear();
     
-    if (pluginData.empty()) {
-        WriteToAdvancedLog("WARNING: No plugin data found", __LINE__);
-    } else {
-        WriteToAdvancedLog("Exporting plugin outfits to JSON...", __LINE__);
-        ExportPluginOutfitsToJSON(pluginData);
+    // The stream is append-only within a session; it is restarted when it grows too large
+    std::error_code ec;
+    if (fs::exists(g_npcTrackingStreamPath, ec) && fs::file_size(g_npcTrackingStreamPath, ec) > kTrackingStreamMaxBytes) {
+        std::ofstream truncate(g_npcTrackingStreamPath, std::ios::trunc);
+        WriteToAdvancedLog("Act2_Manager_Stream.jsonl exceeded size limit, restarted", __LINE__);
     }
     
-    WriteToAdvancedLog("Resetting start flag to false...", __LINE__);
-    g_pluginOutfitsConfig.start = false;
-    SavePluginOutfitsConfig();
+    const auto config = GetAct2ManagerConfig();
+    std::stringstream ss;
+    ss << "{\"seq\": " << ++g_npcTrackingStreamSequence << ", \"time\": \"" << GetCurrentTimeString()
+       << "\", \"event\": \"session_start\", \"radius\": " << config->npcTracking.radio
+       << ", \"interval_ms\": " << config->npcTracking.intervalMs
+       << ", \"distance_threshold\": " << config->npcTracking.distanceThreshold << "}";
+    AppendTrackingEvents({ss.str()});
+    
+    g_continuousTrackingActive = true;
+    g_lastContinuousTick = {};
+    WriteToAdvancedLog("Continuous NPC tracking started (interval " + std::to_string(config->npcTracking.intervalMs) + " ms)", __LINE__);
+}
+
+void EndContinuousTracking() {
+    std::stringstream ss;
+    ss << "{\"seq\": " << ++g_npcTrackingStreamSequence << ", \"time\": \"" << GetCurrentTimeString()
+       << "\", \"event\": \"session_end\"}";
+    AppendTrackingEvents({ss.str()});
     
-    WriteToAdvancedLog("========================================", __LINE__);
-    WriteToAdvancedLog("PLUGIN OUTFITS SCANNING COMPLETE", __LINE__);
-    WriteToAdvancedLog("========================================", __LINE__);
+    g_trackedActors.clear();
+    g_continuousTrackingActive = false;
+    WriteToAdvancedLog("Continuous NPC tracking stopped", __LINE__);
 }
 
-void ExportNPCDataToJSON(const std::vector<NPCData>& npcList, const NPCData& playerData) {
-    std::ofstream jsonFile(g_npcTrackingJsonPath, std::ios::trunc);
-    if (!jsonFile.is_open()) {
-        WriteToAdvancedLog("ERROR: Could not create Act2_Manager.json", __LINE__);
+void ExecuteContinuousTrackingTick() {
+    const auto config = GetAct2ManagerConfig();
+    std::vector<ActorTickSample> samples;
+    if (!SampleTrackedActors(static_cast<float>(config->npcTracking.radio), samples)) {
         return;
     }
     
-    jsonFile << "{\n";
-    jsonFile << "  \"timestamp\": \"" << GetCurrentTimeString() << "\",\n";
-    jsonFile << "  \"scan_radius\": " << g_npcTrackingConfig.radio << ",\n";
-    jsonFile << "  \"total_npcs\": " << npcList.size() << ",\n";
-    jsonFile << "  \"player\": {\n";
-    jsonFile << "    \"name\": \"" << playerData.name << "\",\n";
-    jsonFile << "    \"editor_id\": \"" << playerData.editorID << "\",\n";
-    jsonFile << "    \"plugin\": \"" << playerData.pluginName << "\",\n";
-    jsonFile << "    \"race\": \"" << playerData.race << "\",\n";
-    jsonFile << "    \"gender\": \"" << playerData.gender << "\",\n";
-    jsonFile << "    \"is_vampire\": " << (playerData.isVampire ? "true" : "false") << ",\n";
-    jsonFile << "    \"is_werewolf\": " << (playerData.isWerewolf ? "true" : "false") << ",\n";
-    jsonFile << "    \"ref_id\": \"0x" << std::hex << std::uppercase << playerData.refID << std::dec << "\",\n";
-    jsonFile << "    \"base_id\": \"0x" << std::hex << std::uppercase << playerData.baseID << std::dec << "\",\n";
-    jsonFile << "    \"form_id\": \"0x" << std::hex << std::uppercase << playerData.formID << std::dec << "\",\n";
-    jsonFile << "    \"factions\": [\n";
-    
-    for (size_t i = 0; i < playerData.factions.size(); ++i) {
-        const auto& faction = playerData.factions[i];
-        jsonFile << "      {\n";
-        jsonFile << "        \"name\": \"" << faction.name << "\",\n";
-        jsonFile << "        \"editor_id\": \"" << faction.editorID << "\",\n";
-        jsonFile << "        \"form_id\": \"0x" << std::hex << std::uppercase << faction.formID << std::dec << "\",\n";
-        jsonFile << "        \"rank\": " << faction.rank << ",\n";
-        jsonFile << "        \"is_member\": " << (faction.isMember ? "true" : "false") << "\n";
-        jsonFile << "      }" << (i < playerData.factions.size() - 1 ? "," : "") << "\n";
-    }
-    
-    jsonFile << "    ],\n";
-    jsonFile << "    \"equipped_items\": {\n";
-    
-    std::vector<std::string> slotOrder = {
-        "right_hand", "left_hand",
-        "head", "hair", "body", "hands", "forearms",
-        "amulet", "ring", "feet", "calves", "shield",
-        "tail", "long_hair", "circlet", "ears",
-        "face_jewelry", "neck", "chest_primary", "back",
-        "misc_fx", "pelvis_primary", "decapitated_head", "decapitate",
-        "pelvis_secondary", "leg_primary_right", "leg_secondary_left", "face_alternate",
-        "chest_secondary", "shoulder", "arm_left", "arm_right",
-        "unnamed_fx", "fx01"
-    };
-    
-    for (size_t i = 0; i < slotOrder.size(); ++i) {
-        const auto& slotKey = slotOrder[i];
-        auto it = playerData.equippedItems.find(slotKey);
-        
-        if (it != playerData.equippedItems.end()) {
-            const auto& item = it->second;
-            jsonFile << "      \"" << slotKey << "\": {\n";
-            jsonFile << "        \"equipped\": " << (item.equipped ? "true" : "false");
-            
-            if (item.equipped) {
-                jsonFile << ",\n";
-                jsonFile << "        \"name\": \"" << item.name << "\",\n";
-                jsonFile << "        \"form_id\": \"0x" << std::hex << std::uppercase << item.formID << std::dec << "\",\n";
-                jsonFile << "        \"plugin\": \"" << item.pluginName << "\"\n";
-            } else {
-                jsonFile << "\n";
+    std::vector<std::string> events;
+    std::unordered_set<RE::FormID> present;
+    present.reserve(samples.size());
+    char idBuffer[16];
+    
+    for (auto& sample : samples) {
+        present.insert(sample.refID);
+        
+        if (sample.entered) {
+            const auto& npc = *sample.entered;
+            std::stringstream ss;
+            ss << FormatTrackingEventHeader("entered", sample.refID) << ", \"name\": \"" << EscapeJSONString(npc.name)
+               << "\", \"editor_id\": \"" << EscapeJSONString(npc.editorID) << "\", \"plugin\": \""
+               << EscapeJSONString(npc.pluginName) << "\", \"race\": \"" << EscapeJSONString(npc.race)
+               << "\", \"gender\": \"" << npc.gender << "\", \"distance\": "
+               << std::fixed << std::setprecision(2) << sample.distance << ", \"equipped\": {";
+            bool first = true;
+            for (size_t i = 0; i < kEquipSlotCount; ++i) {
+                if (!sample.equipment[i]) continue;
+                std::snprintf(idBuffer, sizeof(idBuffer), "0x%X", sample.equipment[i]);
+                ss << (first ? "" : ", ") << "\"" << kEquipSlotTable[i].jsonKey << "\": \"" << idBuffer << "\"";
+                first = false;
             }
-            
-            jsonFile << "      }" << (i < slotOrder.size() - 1 ? "," : "") << "\n";
-        }
-    }
-    
-    jsonFile << "    }\n";
-    jsonFile << "  },\n";
-    jsonFile << "  \"npcs\": [\n";
-    
-    for (size_t i = 0; i < npcList.size(); ++i) {
-        const auto& npc = npcList[i];
-        jsonFile << "    {\n";
-        jsonFile << "      \"name\": \"" << npc.name << "\",\n";
-        jsonFile << "      \"editor_id\": \"" << npc.editorID << "\",\n";
-        jsonFile << "      \"plugin\": \"" << npc.pluginName << "\",\n";
-        jsonFile << "      \"race\": \"" << npc.race << "\",\n";
-        jsonFile << "      \"gender\": \"" << npc.gender << "\",\n";
-        jsonFile << "      \"is_vampire\": " << (npc.isVampire ? "true" : "false") << ",\n";
-        jsonFile << "      \"is_werewolf\": " << (npc.isWerewolf ? "true" : "false") << ",\n";
-        jsonFile << "      \"ref_id\": \"0x" << std::hex << std::uppercase << npc.refID << std::dec << "\",\n";
-        jsonFile << "      \"base_id\": \"0x" << std::hex << std::uppercase << npc.baseID << std::dec << "\",\n";
-        jsonFile << "      \"form_id\": \"0x" << std::hex << std::uppercase << npc.formID << std::dec << "\",\n";
-        jsonFile << "      \"distance_from_player\": " << std::fixed << std::setprecision(2) << npc.distanceFromPlayer << ",\n";
-        jsonFile << "      \"factions\": [\n";
-        
-        for (size_t j = 0; j < npc.factions.size(); ++j) {
-            const auto& faction = npc.factions[j];
-            jsonFile << "        {\n";
-            jsonFile << "          \"name\": \"" << faction.name << "\",\n";
-            jsonFile << "          \"editor_id\": \"" << faction.editorID << "\",\n";
-            jsonFile << "          \"form_id\": \"0x" << std::hex << std::uppercase << faction.formID << std::dec << "\",\n";
-            jsonFile << "          \"rank\": " << faction.rank << ",\n";
-            jsonFile << "          \"is_member\": " << (faction.isMember ? "true" : "false") << "\n";
-            jsonFile << "        }" << (j < npc.factions.size() - 1 ? "," : "") << "\n";
+            ss << "}}";
+            events.push_back(ss.str());
+            g_trackedActors[sample.refID] = {sample.distance, sample.equipment};
+            RecordSighting(sample.refID, sample.cellID, sample.distance, sample.equipment);
+            continue;
         }
         
-        jsonFile << "      ],\n";
-        jsonFile << "      \"equipped_items\": {\n";
+        auto& state = g_trackedActors[sample.refID];
+        bool changed = false;
         
-        for (size_t k = 0; k < slotOrder.size(); ++k) {
-            const auto& slotKey = slotOrder[k];
-            auto it = npc.equippedItems.find(slotKey);
-            
-            if (it != npc.equippedItems.end()) {
-                const auto& item = it->second;
-                jsonFile << "        \"" << slotKey << "\": {\n";
-                jsonFile << "          \"equipped\": " << (item.equipped ? "true" : "false");
-                
-                if (item.equipped) {
-                    jsonFile << ",\n";
-                    jsonFile << "          \"name\": \"" << item.name << "\",\n";
-                    jsonFile << "          \"form_id\": \"0x" << std::hex << std::uppercase << item.formID << std::dec << "\",\n";
-                    jsonFile << "          \"plugin\": \"" << item.pluginName << "\"\n";
+        if (std::abs(sample.distance - state.reportedDistance) >= config->npcTracking.distanceThreshold) {
+            std::stringstream ss;
+            ss << FormatTrackingEventHeader("moved", sample.refID) << ", \"distance\": " << std::fixed
+               << std::setprecision(2) << sample.distance << "}";
+            events.push_back(ss.str());
+            state.reportedDistance = sample.distance;
+            changed = true;
+        }
+        
+        if (sample.equipment != state.equipment) {
+            std::stringstream ss;
+            ss << FormatTrackingEventHeader("equipment", sample.refID) << ", \"changed\": {";
+            bool first = true;
+            for (size_t i = 0; i < kEquipSlotCount; ++i) {
+                if (sample.equipment[i] == state.equipment[i]) continue;
+                ss << (first ? "" : ", ") << "\"" << kEquipSlotTable[i].jsonKey << "\": ";
+                if (sample.equipment[i]) {
+                    std::snprintf(idBuffer, sizeof(idBuffer), "0x%X", sample.equipment[i]);
+                    ss << "\"" << idBuffer << "\"";
                 } else {
-                    jsonFile << "\n";
+                    ss << "null";
                 }
-                
-                jsonFile << "        }" << (k < slotOrder.size() - 1 ? "," : "") << "\n";
+                first = false;
             }
+            ss << "}}";
+            events.push_back(ss.str());
+            state.equipment = sample.equipment;
+            changed = true;
         }
         
-        jsonFile << "      }\n";
-        jsonFile << "    }" << (i < npcList.size() - 1 ? "," : "") << "\n";
+        if (changed) {
+            RecordSighting(sample.refID, sample.cellID, sample.distance, sample.equipment);
+        }
     }
     
-    jsonFile << "  ]\n";
-    jsonFile << "}\n";
-    
-    jsonFile.close();
+    for (auto it = g_trackedActors.begin(); it != g_trackedActors.end();) {
+        if (present.find(it->first) == present.end()) {
+            events.push_back(FormatTrackingEventHeader("left", it->first) + "}");
+            it = g_trackedActors.erase(it);
+        } else {
+            ++it;
+        }
+    }
     
-    WriteToAdvancedLog("Successfully exported NPC data to Act2_Manager.json", __LINE__);
-    WriteToAdvancedLog("Total entries: 1 player + " + std::to_string(npcList.size()) + " NPCs", __LINE__);
+    AppendTrackingEvents(events);
 }
 
-void ExecuteNPCTracking() {
-    WriteToAdvancedLog("========================================", __LINE__);
-    WriteToAdvancedLog("NPC TRACKING SYSTEM ACTIVATED", __LINE__);
-    WriteToAdvancedLog("========================================", __LINE__);
+// Called from the monitor loop every pass; returns how long the loop may sleep. With tracking
+// off there is nothing to tick: turning it on edits Act2_Manager.ini, which wakes the loop.
+std::chrono::milliseconds UpdateContinuousTracking() {
+    constexpr std::chrono::milliseconds kIdlePoll(1000);
+    constexpr std::chrono::milliseconds kIdleWait = std::chrono::hours(1);
+    const auto config = GetAct2ManagerConfig();
     
-    WriteToAdvancedLog("Capturing player data...", __LINE__);
-    NPCData playerData = CapturePlayerData();
+    if (!config->npcTracking.continuous) {
+        if (g_continuousTrackingActive) EndContinuousTracking();
+        return kIdleWait;
+    }
     
-    if (playerData.name.empty()) {
-        WriteToAdvancedLog("ERROR: Failed to capture player data", __LINE__);
-        g_npcTrackingConfig.start = false;
-        SaveNPCTrackingConfig();
-        return;
+    if (!g_continuousTrackingActive) BeginContinuousTracking();
+    
+    std::chrono::milliseconds interval(config->npcTracking.intervalMs);
+    auto now = std::chrono::steady_clock::now();
+    if (now - g_lastContinuousTick >= interval) {
+        g_lastContinuousTick = now;
+        ExecuteContinuousTrackingTick();
     }
     
-    WriteToAdvancedLog("Player captured: " + playerData.name, __LINE__);
-    WriteToAdvancedLog("Starting NPC scan with radius: " + std::to_string(g_npcTrackingConfig.radio), __LINE__);
+    auto untilNext = std::chrono::duration_cast<std::chrono::milliseconds>(g_lastContinuousTick + interval - std::chrono::steady_clock::now());
+    return std::clamp(untilNext, std::chrono::milliseconds(10), kIdlePoll);
+}
+
+void ReloadNPCTrackingIni() {
+    if (!fs::exists(g_npcTrackingIniPath)) return;
+    // Flag resets saved by this plugin and repeated events for one edit are not a reason to reload;
+    // the first pass after monitoring starts always reloads
+    if (!IniDocument::ContentChanged(g_npcTrackingIniPath)) return;
     
-    std::vector<NPCData> npcList = ScanNPCsAroundPlayer(static_cast<float>(g_npcTrackingConfig.radio));
+    WriteToAdvancedLog("Act2_Manager.ini changed, reloading...", __LINE__);
     
-    WriteToAdvancedLog("Scan complete. Found " + std::to_string(npcList.size()) + " NPCs", __LINE__);
-    WriteToAdvancedLog("Exporting data to JSON...", __LINE__);
+    LoadNPCTrackingConfig();
+    const auto config = GetAct2ManagerConfig();
     
-    ExportNPCDataToJSON(npcList, playerData);
+    if (config->npcTracking.start) {
+        WriteToAdvancedLog("NPC Tracking start flag detected as TRUE - executing NPC tracking", __LINE__);
+        ExecuteNPCTracking();
+    }
     
-    WriteToAdvancedLog("Resetting start flag to false...", __LINE__);
-    g_npcTrackingConfig.start = false;
-    SaveNPCTrackingConfig();
+    if (config->pluginOutfits.start) {
+        WriteToAdvancedLog("Plugin Outfits start flag detected as TRUE - executing plugin scanning", __LINE__);
+        ExecutePluginOutfitsScanning();
+    }
     
-    WriteToAdvancedLog("========================================", __LINE__);
-    WriteToAdvancedLog("NPC TRACKING COMPLETE", __LINE__);
-    WriteToAdvancedLog("========================================", __LINE__);
+    if (config->pluginOutfits.pluginList) {
+        WriteToAdvancedLog("Plugin List flag detected as TRUE - executing plugin list scanning", __LINE__);
+        ExecutePluginListScanning();
+    }
+    
+    if (config->pluginNPCs.startNPCs) {
+        WriteToAdvancedLog("Plugin NPCs startNPCs flag detected as TRUE - executing NPC count scanning", __LINE__);
+        ExecuteNPCCountScanning();
+    }
+    
+    if (config->pluginNPCs.pluginListNPCs) {
+        WriteToAdvancedLog("Plugin NPCs Plugin_listNPCs flag detected as TRUE - executing NPC list scanning", __LINE__);
+        ExecuteNPCListScanning();
+    }
+    
+    if (config->history.query != "none") {
+        WriteToAdvancedLog("History query detected - executing history query", __LINE__);
+        ExecuteHistoryQuery();
+    }
 }
 
-void NPCTrackingMonitorThreadFunction() {
-    WriteToAdvancedLog("NPC Tracking monitor thread started", __LINE__);
-    
-    while (g_monitoringNPCTracking.load() && !g_isShuttingDown.load()) {
+// One pass of the NPC tracking task: applies an INI change, ticks continuous tracking and flushes
+// history. Returns the delay until the next pass is needed.
+std::optional<std::chrono::milliseconds> RunNPCTrackingPass() {
+    if (g_npcTrackingIniChanged.exchange(false)) {
         try {
-            if (fs::exists(g_npcTrackingIniPath)) {
-                auto currentModTime = fs::last_write_time(g_npcTrackingIniPath);
-                auto currentModTimeT = std::chrono::system_clock::to_time_t(
-                    std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-                        currentModTime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()));
-                
-                if (currentModTimeT > g_lastNPCIniCheckTime) {
-                    WriteToAdvancedLog("Act2_Manager.ini changed, reloading...", __LINE__);
-                    
-                    LoadNPCTrackingConfig();
-                    
-                    if (g_npcTrackingConfig.start) {
-                        WriteToAdvancedLog("NPC Tracking start flag detected as TRUE - executing NPC tracking", __LINE__);
-                        ExecuteNPCTracking();
-                    }
-                    
-                    if (g_pluginOutfitsConfig.start) {
-                        WriteToAdvancedLog("Plugin Outfits start flag detected as TRUE - executing plugin scanning", __LINE__);
-                        ExecutePluginOutfitsScanning();
-                    }
-                    
-                    if (g_pluginOutfitsConfig.pluginList) {
-                        WriteToAdvancedLog("Plugin List flag detected as TRUE - executing plugin list scanning", __LINE__);
-                        ExecutePluginListScanning();
-                    }
-                    
-                    if (g_pluginNPCsConfig.startNPCs) {
-                        WriteToAdvancedLog("Plugin NPCs startNPCs flag detected as TRUE - executing NPC count scanning", __LINE__);
-                        ExecuteNPCCountScanning();
-                    }
-                    
-                    if (g_pluginNPCsConfig.pluginListNPCs) {
-                        WriteToAdvancedLog("Plugin NPCs Plugin_listNPCs flag detected as TRUE - executing NPC list scanning", __LINE__);
-                        ExecuteNPCListScanning();
-                    }
-                    
-                    g_lastNPCIniCheckTime = currentModTimeT;
-                }
-            }
+            ReloadNPCTrackingIni();
         } catch (const std::exception& e) {
             WriteToAdvancedLog("ERROR in NPC tracking monitor: " + std::string(e.what()), __LINE__);
         } catch (...) {
             WriteToAdvancedLog("UNKNOWN ERROR in NPC tracking monitor", __LINE__);
         }
-        
-        std::this_thread::sleep_for(std::chrono::seconds(1));
     }
     
-    WriteToAdvancedLog("NPC Tracking monitor thread stopped", __LINE__);
+    std::chrono::milliseconds delay(1000);
+    try {
+        delay = UpdateContinuousTracking();
+    } catch (const std::exception& e) {
+        WriteToAdvancedLog("ERROR in continuous NPC tracking: " + std::string(e.what()), __LINE__);
+    }
+    
+    FlushSightingHistoryIfDue();
+    return std::min(delay, std::max(TimeUntilSightingHistoryFlush(), std::chrono::milliseconds(10)));
+}
+
+static TaskID g_npcTrackingTask = 0;
+
+// Runs on the file watcher thread; the reload itself happens in the next tracking pass
+void OnNPCTrackingIniChanged() {
+    g_npcTrackingIniChanged = true;
+    g_scheduler.RunNow(g_npcTrackingTask);
 }
 
 void StartNPCTrackingMonitoring() {
     if (!g_monitoringNPCTracking.load()) {
         g_monitoringNPCTracking = true;
-        g_npcTrackingThread = std::thread(NPCTrackingMonitorThreadFunction);
+        // The first pass reads the flags the INI was left with
+        g_npcTrackingIniChanged = true;
+        g_npcTrackingTask = g_scheduler.Schedule("NPC tracking", std::chrono::milliseconds(0), TaskMode::kWorker,
+                                                 RunNPCTrackingPass);
+        g_fileWatcher.Watch(g_npcTrackingIniPath, kFileWatchDebounce, OnNPCTrackingIniChanged);
         WriteToAdvancedLog("NPC Tracking monitoring started", __LINE__);
     }
 }
@@ -3009,65 +4303,59 @@ void StartNPCTrackingMonitoring() {
 void StopNPCTrackingMonitoring() {
     if (g_monitoringNPCTracking.load()) {
         g_monitoringNPCTracking = false;
-        if (g_npcTrackingThread.joinable()) {
-            g_npcTrackingThread.join();
+        g_fileWatcher.Unwatch(g_npcTrackingIniPath);
+        g_scheduler.Cancel(g_npcTrackingTask);
+        
+        if (g_continuousTrackingActive) {
+            EndContinuousTracking();
         }
+        FlushSightingHistoryIfDue(true);
+        
         WriteToAdvancedLog("NPC Tracking monitoring stopped", __LINE__);
     }
 }
 
-void SkyrimSwitchThreadFunction() {
-    WriteToAdvancedLog("SkyrimSwitch monitor thread started", __LINE__);
-    
-    while (g_monitoringSkyrimSwitch.load() && !g_isShuttingDown.load()) {
-        try {
-            std::string timestamp = GetCurrentTimeString();
-            std::string line = "[" + timestamp + "] [log] [info] the game is on";
-            
-            {
-                std::lock_guard<std::mutex> lock(g_skyrimSwitchMutex);
-                
-                if (g_skyrimSwitchLines.size() >= 20) {
-                    g_skyrimSwitchLines.pop_front();
-                }
-                g_skyrimSwitchLines.push_back(line);
-                
-                std::ofstream logFile(g_skyrimSwitchLogPath, std::ios::trunc);
-                if (logFile.is_open()) {
-                    for (const auto& logLine : g_skyrimSwitchLines) {
-                        logFile << logLine << "\n";
-                    }
-                    logFile.close();
-                }
-            }
-            
-        } catch (const std::exception& e) {
-            WriteToAdvancedLog("ERROR in SkyrimSwitch monitor: " + std::string(e.what()), __LINE__);
-        } catch (...) {
-            WriteToAdvancedLog("UNKNOWN ERROR in SkyrimSwitch monitor", __LINE__);
-        }
-        
-        std::this_thread::sleep_for(std::chrono::seconds(3));
+std::uint32_t CurrentHeartbeatHealth() {
+    std::uint32_t health = 0;
+    if (g_monitoringIni.load()) health |= kHeartbeatIniMonitor;
+    if (g_monitoringNPCTracking.load()) health |= kHeartbeatNPCTracking;
+    if (g_pauseMonitoring.load()) health |= kHeartbeatPaused;
+    return health;
+}
+
+void WriteSkyrimSwitchHeartbeat() {
+    g_skyrimSwitchHeartbeat.Beat(g_heartbeatGameState.load(), CurrentHeartbeatHealth());
+}
+
+static TaskID g_skyrimSwitchTask = 0;
+
+// State changes are published straight away instead of on the next beat
+void SetHeartbeatGameState(HeartbeatGameState state) {
+    if (g_heartbeatGameState.exchange(state) != state && g_monitoringSkyrimSwitch.load()) {
+        g_scheduler.RunNow(g_skyrimSwitchTask);
     }
-    
-    WriteToAdvancedLog("SkyrimSwitch monitor thread stopped", __LINE__);
 }
 
 void StartSkyrimSwitchMonitoring() {
     if (!g_monitoringSkyrimSwitch.load()) {
+        if (!g_skyrimSwitchHeartbeat.Open(g_skyrimSwitchPath, kHeartbeatInterval)) {
+            WriteToAdvancedLog("ERROR: Could not map SkyrimSwitch heartbeat: " + g_skyrimSwitchPath.string(), __LINE__);
+            return;
+        }
         g_monitoringSkyrimSwitch = true;
-        g_skyrimSwitchThread = std::thread(SkyrimSwitchThreadFunction);
-        WriteToAdvancedLog("SkyrimSwitch monitoring started", __LINE__);
+        g_skyrimSwitchTask = g_scheduler.Every("SkyrimSwitch heartbeat", kHeartbeatInterval, TaskMode::kInline,
+                                               WriteSkyrimSwitchHeartbeat);
+        WriteToAdvancedLog("SkyrimSwitch heartbeat started", __LINE__);
     }
 }
 
+// The server notices the stop once the counter has been still for its timeout
 void StopSkyrimSwitchMonitoring() {
     if (g_monitoringSkyrimSwitch.load()) {
         g_monitoringSkyrimSwitch = false;
-        if (g_skyrimSwitchThread.joinable()) {
-            g_skyrimSwitchThread.join();
-        }
-        WriteToAdvancedLog("SkyrimSwitch monitoring stopped", __LINE__);
+        g_scheduler.Cancel(g_skyrimSwitchTask);
+        g_skyrimSwitchHeartbeat.Close();
+        WriteToAdvancedLog("SkyrimSwitch heartbeat stopped", __LINE__);
     }
 }
 
@@ -3261,6 +4549,14 @@ public:
 
     RE::BSEventNotifyControl ProcessEvent(const RE::MenuOpenCloseEvent* event,
                                            RE::BSTEventSource<RE::MenuOpenCloseEvent>*) override {
+        if (event) {
+            if (event->menuName == RE::LoadingMenu::MENU_NAME) {
+                SetHeartbeatGameState(event->opening ? HeartbeatGameState::kLoading : HeartbeatGameState::kInGame);
+            } else if (event->menuName == RE::MainMenu::MENU_NAME && event->opening) {
+                SetHeartbeatGameState(HeartbeatGameState::kMainMenu);
+            }
+        }
+
         if (g_pauseMonitoring.load()) {
             return RE::BSEventNotifyControl::kContinue;
         }
@@ -3292,6 +4588,14 @@ public:
             return RE::BSEventNotifyControl::kContinue;
         }
 
+        if (event && event->actor) {
+            auto* armor = RE::TESForm::LookupByID<RE::TESObjectARMO>(event->baseObject);
+            if (armor) {
+                g_liveEquipment.OnArmorEvent(event->actor->GetFormID(), armor->GetFormID(),
+                                             static_cast<std::uint32_t>(armor->GetSlotMask()), event->equipped);
+            }
+        }
+
         return RE::BSEventNotifyControl::kContinue;
     }
 
@@ -3417,38 +4721,65 @@ void InitializePlugin() {
             
             g_npcTrackingIniPath = iniFolder / "Act2_Manager.ini";
             g_npcTrackingJsonPath = jsonFolder / "Act2_Manager.json";
+            g_npcTrackingStreamPath = jsonFolder / "Act2_Manager_Stream.jsonl";
             g_pluginOutfitsJsonPath = jsonFolder / "Act2_Outfits.json";
             g_pluginListJsonPath = jsonFolder / "Act2_Plugins.json";
             g_pluginFilterIniPath = iniFolder / "Act2_Plugins.ini";
             g_npcCountJsonPath = jsonFolder / "Act2_NPCs.json";
             g_npcListJsonPath = jsonFolder / "Act2_NPCs_List.json";
             g_npcFilterIniPath = iniFolder / "Act2_NPCs.ini";
-            g_skyrimSwitchLogPath = logFolder / "SkyrimSwitch.log";
+            g_skyrimSwitchPath = logFolder / "SkyrimSwitch.heartbeat";
             
             // Set paths for Plugin Lector
             g_pluginsLectorLogPath = paths.primary / "OBody_NG_Preset_Distribution_Assistant-NG_Plugins_Lector.log";
             g_pluginsLectorJsonPath = jsonFolder / "Act2_PDA_Plugins.json";
             
+            g_catalogSnapshotPath = jsonFolder / "Act2_CatalogSnapshot.tsv";
+            g_catalogDiffJsonPath = jsonFolder / "Act2_CatalogDiff.json";
+            
+            g_factionCsvPath = assetsPath / "Data" / "AllFactions_EDID_Name.csv";
+            g_actorPredicatesIniPath = iniFolder / "Act2_Predicates.ini";
+            g_historyLogPath = jsonFolder / "Act2_History.bin";
+            g_historyJsonPath = jsonFolder / "Act2_History.json";
+            
             WriteToAdvancedLog("NPC Tracking INI path: " + g_npcTrackingIniPath.string(), __LINE__);
             WriteToAdvancedLog("NPC Tracking JSON path: " + g_npcTrackingJsonPath.string(), __LINE__);
+            WriteToAdvancedLog("NPC Tracking stream path: " + g_npcTrackingStreamPath.string(), __LINE__);
             WriteToAdvancedLog("Plugin Outfits JSON path: " + g_pluginOutfitsJsonPath.string(), __LINE__);
             WriteToAdvancedLog("Plugin List JSON path: " + g_pluginListJsonPath.string(), __LINE__);
             WriteToAdvancedLog("Plugin Filter INI path: " + g_pluginFilterIniPath.string(), __LINE__);
             WriteToAdvancedLog("NPC Count JSON path: " + g_npcCountJsonPath.string(), __LINE__);
             WriteToAdvancedLog("NPC List JSON path: " + g_npcListJsonPath.string(), __LINE__);
             WriteToAdvancedLog("NPC Filter INI path: " + g_npcFilterIniPath.string(), __LINE__);
-            WriteToAdvancedLog("SkyrimSwitch LOG path: " + g_skyrimSwitchLogPath.string(), __LINE__);
+            WriteToAdvancedLog("SkyrimSwitch heartbeat path: " + g_skyrimSwitchPath.string(), __LINE__);
             WriteToAdvancedLog("Plugin Lector LOG path: " + g_pluginsLectorLogPath.string(), __LINE__);
             WriteToAdvancedLog("Plugin Lector JSON path: " + g_pluginsLectorJsonPath.string(), __LINE__);
+            WriteToAdvancedLog("Catalog Diff JSON path: " + g_catalogDiffJsonPath.string(), __LINE__);
+            WriteToAdvancedLog("Faction CSV path: " + g_factionCsvPath.string(), __LINE__);
+            WriteToAdvancedLog("Actor predicates INI path: " + g_actorPredicatesIniPath.string(), __LINE__);
+            WriteToAdvancedLog("Sighting history path: " + g_historyLogPath.string(), __LINE__);
             
             LoadNPCTrackingConfig();
+            const auto config = GetAct2ManagerConfig();
             
-            WriteToAdvancedLog("NPC Tracking Config - start: " + std::string(g_npcTrackingConfig.start ? "true" : "false") + 
-                              ", radio: " + std::to_string(g_npcTrackingConfig.radio), __LINE__);
-            WriteToAdvancedLog("Plugin Outfits Config - start: " + std::string(g_pluginOutfitsConfig.start ? "true" : "false") +
-                              ", Plugin_list: " + std::string(g_pluginOutfitsConfig.pluginList ? "true" : "false"), __LINE__);
-            WriteToAdvancedLog("Plugin NPCs Config - startNPCs: " + std::string(g_pluginNPCsConfig.startNPCs ? "true" : "false") +
-                              ", Plugin_listNPCs: " + std::string(g_pluginNPCsConfig.pluginListNPCs ? "true" : "false"), __LINE__);
+            WriteToAdvancedLog("NPC Tracking Config - start: " + std::string(config->npcTracking.start ? "true" : "false") + 
+                              ", radio: " + std::to_string(config->npcTracking.radio) +
+                              ", continuous: " + std::string(config->npcTracking.continuous ? "true" : "false") +
+                              ", interval_ms: " + std::to_string(config->npcTracking.intervalMs) +
+                              ", max_results: " + std::to_string(config->npcTracking.maxResults) +
+                              ", rings: " + config->npcTracking.rings +
+                              ", faction_query: " + config->npcTracking.factionQuery, __LINE__);
+            WriteToAdvancedLog("Plugin Outfits Config - start: " + std::string(config->pluginOutfits.start ? "true" : "false") +
+                              ", Plugin_list: " + std::string(config->pluginOutfits.pluginList ? "true" : "false"), __LINE__);
+            WriteToAdvancedLog("Plugin NPCs Config - startNPCs: " + std::string(config->pluginNPCs.startNPCs ? "true" : "false") +
+                              ", Plugin_listNPCs: " + std::string(config->pluginNPCs.pluginListNPCs ? "true" : "false"), __LINE__);
+            WriteToAdvancedLog("Scheduler Config - frame_budget_ms: " + std::to_string(config->scheduler.frameBudgetMs), __LINE__);
+            WriteToAdvancedLog("History Config - record: " + std::string(config->history.record ? "true" : "false") +
+                              ", flush_interval_s: " + std::to_string(config->history.flushIntervalS), __LINE__);
+            WriteToAdvancedLog("Filter Config - sex: " + config->filter.sex + ", races: " + config->filter.races +
+                              ", plugins: " + config->filter.plugins +
+                              ", exclude_vanilla: " + std::string(config->filter.excludeVanilla ? "true" : "false") +
+                              ", max_distance: " + std::to_string(config->filter.maxDistance), __LINE__);
             
             StartNPCTrackingMonitoring();
             
@@ -3463,8 +4794,8 @@ void InitializePlugin() {
             StartSkyrimSwitchMonitoring();
             
             WriteToAdvancedLog("SKYRIMSWITCH MONITOR INITIALIZED", __LINE__);
-            WriteToAdvancedLog("Log interval: 3 seconds", __LINE__);
-            WriteToAdvancedLog("Max lines: 20", __LINE__);
+            WriteToAdvancedLog("Beat interval: " + std::to_string(kHeartbeatInterval.count()) + " ms", __LINE__);
+            WriteToAdvancedLog("Block size: " + std::to_string(sizeof(HeartbeatBlock)) + " bytes", __LINE__);
             WriteToAdvancedLog("========================================", __LINE__);
             
             g_isInitialized = true;
@@ -3487,7 +4818,10 @@ void InitializePlugin() {
     }
 }
 
+// Not called yet: SKSE sends no message when the game exits, so at DLL unload the threads are
+// only stopped by the g_fileWatcher, g_scheduler and g_parallelPool destructors
 void ShutdownPlugin() {
+    const auto shutdownStart = std::chrono::steady_clock::now();
     logger::info("OBODY PDA ADVANCED MANAGER SHUTTING DOWN");
     WriteToAdvancedLog("PLUGIN SHUTTING DOWN", __LINE__);
 
@@ -3496,7 +4830,12 @@ void ShutdownPlugin() {
     StopIniMonitoring();
     StopNPCTrackingMonitoring();
     StopSkyrimSwitchMonitoring();
+    g_fileWatcher.Stop();
+    g_scheduler.Stop();
+    g_parallelPool.Stop();
 
+    const auto shutdownMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - shutdownStart);
+    WriteToAdvancedLog("Plugin shutdown took " + std::to_string(shutdownMs.count()) + " ms", __LINE__);
     WriteToAdvancedLog("========================================", __LINE__);
     WriteToAdvancedLog("Plugin shutdown complete at: " + GetCurrentTimeString(), __LINE__);
     WriteToAdvancedLog("========================================", __LINE__);
@@ -3511,10 +4850,19 @@ void MessageListener(SKSE::MessagingInterface::Message* message) {
             g_processActive = false;
             g_activationMessageShown = false;
             g_pauseMonitoring = false;
+            g_npcAttributeCache.Invalidate("new game");
+            g_liveEquipment.Clear("new game");
+            SetHeartbeatGameState(HeartbeatGameState::kInGame);
 
             WriteToAdvancedLog("NEW GAME: All flags reset, ready for fresh initialization", __LINE__);
             break;
 
+        case SKSE::MessagingInterface::kPreLoadGame:
+            g_npcAttributeCache.Invalidate("load game");
+            g_liveEquipment.Clear("load game");
+            SetHeartbeatGameState(HeartbeatGameState::kLoading);
+            break;
+
         case SKSE::MessagingInterface::kPostLoadGame:
             logger::info("kPostLoadGame: Game loaded - checking systems");
             if (!g_monitoringIni.load()) {
@@ -3526,13 +4874,24 @@ void MessageListener(SKSE::MessagingInterface::Message* message) {
             if (!g_monitoringSkyrimSwitch.load()) {
                 StartSkyrimSwitchMonitoring();
             }
+            SetHeartbeatGameState(HeartbeatGameState::kInGame);
             break;
 
         case SKSE::MessagingInterface::kDataLoaded:
             logger::info("kDataLoaded: Game fully loaded");
             
+            g_npcAttributeCache.Invalidate("data loaded");
+            SetHeartbeatGameState(HeartbeatGameState::kMainMenu);
+            BuildFactionDictionary();
+            BuildActorPredicates();
+            
             // Run Plugin Lector
             ExecutePluginLectorScanning();
+            
+            // The diff scans every form, so it runs on a worker and reads game data in frame-budgeted slices
+            if (!g_catalogDiffJsonPath.empty() && !g_catalogDiffStarted.exchange(true)) {
+                g_scheduler.Post("catalog diff", ExecuteCatalogDiff);
+            }
 
             {
                 auto& eventProcessor = GameEventProcessor::GetSingleton();
@@ -3573,6 +4932,9 @@ SKSEPluginLoad(const SKSE::LoadInterface* a_skse) {
     SKSE::Init(a_skse);
     SetupLog();
 
+    // Plugin load runs on the game's main thread; the scheduler runs jobs inline from here
+    g_mainThreadId = std::this_thread::get_id();
+
     logger::info("OBody PDA Advanced Manager v3.8.1 - Starting...");
     
     auto paths = GetAllOBodyLogsPaths();
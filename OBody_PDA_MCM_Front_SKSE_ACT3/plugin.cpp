@@ -10,21 +10,42 @@
 #include <shellapi.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <charconv>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
 #include <ctime>
+#include <cwctype>
 #include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
+#include <stop_token>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
+#include "FileWatchService.h"
+#include "IniDocument.h"
+#include "TaskScheduler.h"
+#include "WorkerThread.h"
+
 #pragma comment(lib, "ole32.lib")
 #pragma comment(lib, "shell32.lib")
 
@@ -57,6 +78,12 @@ struct ScriptState {
           currentTrack("") {}
 };
 
+// Switches read from JsonMaster.ini and JsonRecord.ini
+struct JsonSwitchConfig {
+    bool startAct3;
+    bool startAct4;
+};
+
 struct OBodyPDAPathsResult {
     bool success;
     std::string detectionMethod;
@@ -90,7 +117,6 @@ static std::mutex g_logMutex;
 static std::atomic<bool> g_isShuttingDown(false);
 static std::atomic<bool> g_processActive(false);
 static std::atomic<bool> g_monitoringActive(false);
-static std::thread g_monitorThread;
 static int g_monitorCycles = 0;
 static std::unordered_set<std::string> g_processedLines;
 static size_t g_lastFileSize = 0;
@@ -123,13 +149,16 @@ static fs::path g_jsonMasterIniPath;
 static fs::path g_jsonSourcePath;
 static fs::path g_jsonDestPath;
 static fs::path g_jsonDestDirectory;
-static std::thread g_jsonMonitorThread;
 static std::atomic<bool> g_monitoringJsonMaster(false);
+static bool g_jsonMasterLastStatus = false;
 static std::mutex g_jsonMutex;
 
 static fs::path g_jsonRecordIniPath;
-static std::thread g_jsonRecordMonitorThread;
 static std::atomic<bool> g_monitoringJsonRecord(false);
+static bool g_jsonRecordLastStatus = false;
+
+static JsonSwitchConfig g_jsonSwitchConfig = {false, false};
+static std::mutex g_jsonSwitchMutex;
 
 void ProcessOBodyPDAActivation();
 void ExecuteStandaloneModeEXE();
@@ -154,29 +183,16 @@ OBodyPDAPathsResult DetectAllOBodyPDAPaths();
 bool GetJsonMasterStatus();
 bool SetJsonMasterStatus(bool active);
 bool CopyJsonFile();
-void JsonMasterMonitorThreadFunction();
+void OnJsonMasterIniChanged();
 void StartJsonMasterMonitoring();
 void StopJsonMasterMonitoring();
 bool GetJsonRecordStatus();
 bool SetJsonRecordStatus(bool active);
 bool CopyJsonRecordFile();
-void JsonRecordMonitorThreadFunction();
+void OnJsonRecordIniChanged();
 void StartJsonRecordMonitoring();
 void StopJsonRecordMonitoring();
 
-static size_t FindCaseInsensitive(const std::string& haystack, const std::string& needle) {
-    auto it = std::search(
-        haystack.begin(), haystack.end(),
-        needle.begin(), needle.end(),
-        [](char ch1, char ch2) {
-            return static_cast<unsigned char>(std::tolower(ch1)) == static_cast<unsigned char>(std::tolower(ch2));
-        });
-    if (it == haystack.end()) {
-        return std::string::npos;
-    }
-    return static_cast<size_t>(it - haystack.begin());
-}
-
 void ShowGameNotification(const std::string& message) {
     RE::DebugNotification(message.c_str());
     WriteToAdvancedLog("IN-GAME MESSAGE SHOWN: " + message, __LINE__);
@@ -576,6 +592,17 @@ void CleanStopFiles() {
     }
 }
 
+constexpr IniSchema kJsonMasterSchema(std::to_array<IniField>({
+    {"Act3_JSON", "startAct3", &g_jsonSwitchConfig.startAct3, "false"},
+}));
+
+constexpr IniSchema kJsonRecordSchema(std::to_array<IniField>({
+    {"Act4_JSON", "startAct4", &g_jsonSwitchConfig.startAct4, "false"},
+}));
+
+static FileWatchService g_fileWatcher;
+static TaskScheduler g_scheduler;
+
 // ===== JSON MASTER INI MANAGEMENT SYSTEM =====
 bool GetJsonMasterStatus() {
     try {
@@ -583,53 +610,15 @@ bool GetJsonMasterStatus() {
             return false;
         }
 
-        std::ifstream iniFile(g_jsonMasterIniPath);
-        if (!iniFile.is_open()) {
+        IniDocument ini;
+        if (!ini.Load(g_jsonMasterIniPath)) {
             return false;
         }
 
-        std::string line;
-        std::string currentSection;
-
-        while (std::getline(iniFile, line)) {
-            line.erase(0, line.find_first_not_of(" \t\r\n"));
-            line.erase(line.find_last_not_of(" \t\r\n") + 1);
-
-            if (line.empty() || line[0] == ';' || line[0] == '#') {
-                continue;
-            }
-
-            if (line[0] == '[' && line[line.length() - 1] == ']') {
-                currentSection = line.substr(1, line.length() - 2);
-                continue;
-            }
-
-            size_t equalPos = line.find('=');
-            if (equalPos != std::string::npos) {
-                std::string key = line.substr(0, equalPos);
-                std::string value = line.substr(equalPos + 1);
-
-                key.erase(0, key.find_first_not_of(" \t"));
-                key.erase(key.find_last_not_of(" \t") + 1);
-                value.erase(0, value.find_first_not_of(" \t"));
-                value.erase(value.find_last_not_of(" \t") + 1);
-
-                std::string sectionLower = currentSection;
-                std::string keyLower = key;
-                std::transform(sectionLower.begin(), sectionLower.end(), sectionLower.begin(), ::tolower);
-                std::transform(keyLower.begin(), keyLower.end(), keyLower.begin(), ::tolower);
-
-                if (sectionLower == "act3_json" && keyLower == "startact3") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    bool result = (value == "true" || value == "1" || value == "yes");
-                    iniFile.close();
-                    return result;
-                }
-            }
-        }
-
-        iniFile.close();
-        return false;
+        std::lock_guard<std::mutex> lock(g_jsonSwitchMutex);
+        kJsonMasterSchema.ApplyDefaults();
+        kJsonMasterSchema.Apply(ini, "JsonMaster.ini");
+        return g_jsonSwitchConfig.startAct3;
 
     } catch (const std::exception& e) {
         WriteToAdvancedLog("ERROR reading JsonMaster status: " + std::string(e.what()), __LINE__);
@@ -644,47 +633,24 @@ bool SetJsonMasterStatus(bool active) {
             return false;
         }
 
-        std::ifstream fileIn(g_jsonMasterIniPath);
-        if (!fileIn.is_open()) {
+        IniDocument ini;
+        if (!ini.Load(g_jsonMasterIniPath)) {
             WriteToAdvancedLog("Could not open JsonMaster INI for reading", __LINE__);
             return false;
         }
 
-        std::string content((std::istreambuf_iterator<char>(fileIn)), 
-                           std::istreambuf_iterator<char>());
-        fileIn.close();
-
-        std::string searchPattern = "startAct3 = ";
-        size_t pos = content.find(searchPattern);
-        if (pos != std::string::npos) {
-            size_t lineEnd = content.find('\n', pos);
-            if (lineEnd == std::string::npos) lineEnd = content.length();
-            
-            std::string newLine = searchPattern + (active ? "true" : "false");
-            content.replace(pos, lineEnd - pos, newLine);
-        } else {
-            WriteToAdvancedLog("startAct3 entry not found in JsonMaster INI", __LINE__);
-            return false;
+        const IniField& field = kJsonMasterSchema.Fields()[0];
+        if (ini.Set(field.section, field.key, active ? "true" : "false") == IniDocument::EditResult::kUnchanged) {
+            WriteToAdvancedLog("JsonMaster status already " + std::string(active ? "true" : "false") + ", not rewritten", __LINE__);
+            return true;
         }
 
-        std::ofstream fileOut(g_jsonMasterIniPath);
-        if (!fileOut.is_open()) {
-            WriteToAdvancedLog("Could not open JsonMaster INI for writing", __LINE__);
-            return false;
-        }
-        fileOut << content;
-        fileOut.flush();
-        fileOut.close();
-        
-        bool verifyStatus = GetJsonMasterStatus();
-        if (verifyStatus != active) {
-            WriteToAdvancedLog("ERROR: JsonMaster status verification failed after write", __LINE__);
-            WriteToAdvancedLog("Expected: " + std::string(active ? "true" : "false") + 
-                              ", Got: " + std::string(verifyStatus ? "true" : "false"), __LINE__);
+        if (!ini.Save(g_jsonMasterIniPath)) {
+            WriteToAdvancedLog("Could not write JsonMaster INI", __LINE__);
             return false;
         }
 
-        WriteToAdvancedLog("JsonMaster status set to: " + std::string(active ? "true" : "false") + " (verified)", __LINE__);
+        WriteToAdvancedLog("JsonMaster status set to: " + std::string(active ? "true" : "false"), __LINE__);
         return true;
 
     } catch (const std::exception& e) {
@@ -779,54 +745,15 @@ bool GetJsonRecordStatus() {
             return false;
         }
 
-        std::ifstream iniFile(g_jsonRecordIniPath);
-        if (!iniFile.is_open()) {
+        IniDocument ini;
+        if (!ini.Load(g_jsonRecordIniPath)) {
             return false;
         }
 
-        std::string line;
-        std::string currentSection;
-
-        while (std::getline(iniFile, line)) {
-            line.erase(0, line.find_first_not_of(" \t\r\n"));
-            line.erase(line.find_last_not_of(" \t\r\n") + 1);
-
-            if (line.empty() || line[0] == ';' || line[0] == '#') {
-                continue;
-            }
-
-            if (line[0] == '[' && line[line.length() - 1] == ']') {
-                currentSection = line.substr(1, line.length() - 2);
-                std::transform(currentSection.begin(), currentSection.end(), currentSection.begin(), ::tolower);
-                continue;
-            }
-
-            size_t equalPos = line.find('=');
-            if (equalPos != std::string::npos) {
-                std::string key = line.substr(0, equalPos);
-                std::string value = line.substr(equalPos + 1);
-
-                key.erase(0, key.find_first_not_of(" \t"));
-                key.erase(key.find_last_not_of(" \t") + 1);
-                value.erase(0, value.find_first_not_of(" \t"));
-                value.erase(value.find_last_not_of(" \t") + 1);
-
-                std::string sectionLower = currentSection;
-                std::string keyLower = key;
-                std::transform(sectionLower.begin(), sectionLower.end(), sectionLower.begin(), ::tolower);
-                std::transform(keyLower.begin(), keyLower.end(), keyLower.begin(), ::tolower);
-
-                if (sectionLower == "act4_json" && keyLower == "startact4") {
-                    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-                    bool result = (value == "true" || value == "1" || value == "yes");
-                    iniFile.close();
-                    return result;
-                }
-            }
-        }
-
-        iniFile.close();
-        return false;
+        std::lock_guard<std::mutex> lock(g_jsonSwitchMutex);
+        kJsonRecordSchema.ApplyDefaults();
+        kJsonRecordSchema.Apply(ini, "JsonRecord.ini");
+        return g_jsonSwitchConfig.startAct4;
 
     } catch (const std::exception& e) {
         WriteToAdvancedLog("ERROR reading JsonRecord status: " + std::string(e.what()), __LINE__);
@@ -841,47 +768,24 @@ bool SetJsonRecordStatus(bool active) {
             return false;
         }
 
-        std::ifstream fileIn(g_jsonRecordIniPath);
-        if (!fileIn.is_open()) {
+        IniDocument ini;
+        if (!ini.Load(g_jsonRecordIniPath)) {
             WriteToAdvancedLog("Could not open JsonRecord INI for reading", __LINE__);
             return false;
         }
 
-        std::string content((std::istreambuf_iterator<char>(fileIn)),
-                           std::istreambuf_iterator<char>());
-        fileIn.close();
-
-        std::string searchPatternLower = "startact4 = ";
-        size_t pos = FindCaseInsensitive(content, searchPatternLower);
-        if (pos != std::string::npos) {
-            size_t lineEnd = content.find('\n', pos);
-            if (lineEnd == std::string::npos) lineEnd = content.length();
-
-            std::string newLine = "startAct4 = " + std::string(active ? "true" : "false");
-            content.replace(pos, lineEnd - pos, newLine);
-        } else {
-            WriteToAdvancedLog("startAct4 entry not found in JsonRecord INI", __LINE__);
-            return false;
-        }
-
-        std::ofstream fileOut(g_jsonRecordIniPath);
-        if (!fileOut.is_open()) {
-            WriteToAdvancedLog("Could not open JsonRecord INI for writing", __LINE__);
-            return false;
+        const IniField& field = kJsonRecordSchema.Fields()[0];
+        if (ini.Set(field.section, field.key, active ? "true" : "false") == IniDocument::EditResult::kUnchanged) {
+            WriteToAdvancedLog("JsonRecord status already " + std::string(active ? "true" : "false") + ", not rewritten", __LINE__);
+            return true;
         }
-        fileOut << content;
-        fileOut.flush();
-        fileOut.close();
 
-        bool verifyStatus = GetJsonRecordStatus();
-        if (verifyStatus != active) {
-            WriteToAdvancedLog("ERROR: JsonRecord status verification failed after write", __LINE__);
-            WriteToAdvancedLog("Expected: " + std::string(active ? "true" : "false") +
-                              ", Got: " + std::string(verifyStatus ? "true" : "false"), __LINE__);
+        if (!ini.Save(g_jsonRecordIniPath)) {
+            WriteToAdvancedLog("Could not write JsonRecord INI", __LINE__);
             return false;
         }
 
-        WriteToAdvancedLog("JsonRecord status set to: " + std::string(active ? "true" : "false") + " (verified)", __LINE__);
+        WriteToAdvancedLog("JsonRecord status set to: " + std::string(active ? "true" : "false"), __LINE__);
         return true;
 
     } catch (const std::exception& e) {
@@ -958,142 +862,89 @@ bool CopyJsonRecordFile() {
     }
 }
 
-void JsonMasterMonitorThreadFunction() {
-    logger::info("JsonMaster monitoring thread started");
-    WriteToAdvancedLog("JsonMaster monitoring thread started (1 second interval)", __LINE__);
-    
-    bool lastStatus = GetJsonMasterStatus();
-    WriteToAdvancedLog("JsonMaster initial status: " + std::string(lastStatus ? "true" : "false"), __LINE__);
-    fs::file_time_type lastWriteTime;
-    if (fs::exists(g_jsonMasterIniPath)) {
-        lastWriteTime = fs::last_write_time(g_jsonMasterIniPath);
-    } else {
-        lastWriteTime = fs::file_time_type::min();
-    }
-
-    while (g_monitoringJsonMaster.load() && !g_isShuttingDown.load()) {
-        try {
-            if (fs::exists(g_jsonMasterIniPath)) {
-                auto currentWriteTime = fs::last_write_time(g_jsonMasterIniPath);
-                if (currentWriteTime != lastWriteTime) {
-                    lastWriteTime = currentWriteTime;
-
-                    bool currentStatus = GetJsonMasterStatus();
+// Runs on the file watcher thread once the INI has settled
+void OnJsonMasterIniChanged() {
+    if (!fs::exists(g_jsonMasterIniPath)) return;
+    if (!IniDocument::ContentChanged(g_jsonMasterIniPath)) return;
 
-                    if (lastStatus != currentStatus) {
-                        WriteToAdvancedLog("JsonMaster status changed from " + std::string(lastStatus ? "true" : "false") +
-                                          " to " + std::string(currentStatus ? "true" : "false"), __LINE__);
-                    }
+    bool currentStatus = GetJsonMasterStatus();
 
-                    if (!lastStatus && currentStatus) {
-                        WriteToAdvancedLog("JsonMaster status changed from false to true, initiating JSON copy and reset", __LINE__);
+    if (g_jsonMasterLastStatus != currentStatus) {
+        WriteToAdvancedLog("JsonMaster status changed from " + std::string(g_jsonMasterLastStatus ? "true" : "false") +
+                          " to " + std::string(currentStatus ? "true" : "false"), __LINE__);
+    }
 
-                        bool copySuccess = CopyJsonFile();
+    if (!g_jsonMasterLastStatus && currentStatus) {
+        WriteToAdvancedLog("JsonMaster status changed from false to true, initiating JSON copy and reset", __LINE__);
 
-                        if (copySuccess) {
-                            WriteToAdvancedLog("JSON copy completed successfully", __LINE__);
-                            WriteToAdvancedLog("Source: " + g_jsonSourcePath.string(), __LINE__);
-                            WriteToAdvancedLog("Destination: " + g_jsonDestPath.string(), __LINE__);
+        bool copySuccess = CopyJsonFile();
 
-                            bool resetSuccess = SetJsonMasterStatus(false);
-                            if (resetSuccess) {
-                                WriteToAdvancedLog("JsonMaster status reset to false by plugin", __LINE__);
-                            } else {
-                                WriteToAdvancedLog("ERROR: Failed to reset JsonMaster status to false", __LINE__);
-                            }
-                        } else {
-                            WriteToAdvancedLog("ERROR: JSON copy failed", __LINE__);
-                            WriteToAdvancedLog("Source: " + g_jsonSourcePath.string(), __LINE__);
-                            WriteToAdvancedLog("Destination: " + g_jsonDestPath.string(), __LINE__);
-                        }
+        if (copySuccess) {
+            WriteToAdvancedLog("JSON copy completed successfully", __LINE__);
+            WriteToAdvancedLog("Source: " + g_jsonSourcePath.string(), __LINE__);
+            WriteToAdvancedLog("Destination: " + g_jsonDestPath.string(), __LINE__);
 
-                        lastStatus = false;
-                    } else {
-                        lastStatus = currentStatus;
-                    }
-                }
+            bool resetSuccess = SetJsonMasterStatus(false);
+            if (resetSuccess) {
+                WriteToAdvancedLog("JsonMaster status reset to false by plugin", __LINE__);
+            } else {
+                WriteToAdvancedLog("ERROR: Failed to reset JsonMaster status to false", __LINE__);
             }
-        } catch (const std::exception& e) {
-            WriteToAdvancedLog("ERROR in JsonMaster monitor: " + std::string(e.what()), __LINE__);
-        } catch (...) {
-            WriteToAdvancedLog("ERROR in JsonMaster monitor: Unknown exception", __LINE__);
+        } else {
+            WriteToAdvancedLog("ERROR: JSON copy failed", __LINE__);
+            WriteToAdvancedLog("Source: " + g_jsonSourcePath.string(), __LINE__);
+            WriteToAdvancedLog("Destination: " + g_jsonDestPath.string(), __LINE__);
         }
 
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-    }
-
-    logger::info("JsonMaster monitoring thread stopped");
-    WriteToAdvancedLog("JsonMaster monitoring thread stopped", __LINE__);
-}
-
-void JsonRecordMonitorThreadFunction() {
-    logger::info("JsonRecord monitoring thread started");
-    WriteToAdvancedLog("JsonRecord monitoring thread started (1 second interval)", __LINE__);
-
-    bool lastStatus = GetJsonRecordStatus();
-    WriteToAdvancedLog("JsonRecord initial status: " + std::string(lastStatus ? "true" : "false"), __LINE__);
-    fs::file_time_type lastWriteTime;
-    if (fs::exists(g_jsonRecordIniPath)) {
-        lastWriteTime = fs::last_write_time(g_jsonRecordIniPath);
+        g_jsonMasterLastStatus = false;
     } else {
-        lastWriteTime = fs::file_time_type::min();
+        g_jsonMasterLastStatus = currentStatus;
     }
+}
 
-    while (g_monitoringJsonRecord.load() && !g_isShuttingDown.load()) {
-        try {
-            if (fs::exists(g_jsonRecordIniPath)) {
-                auto currentWriteTime = fs::last_write_time(g_jsonRecordIniPath);
-                if (currentWriteTime != lastWriteTime) {
-                    lastWriteTime = currentWriteTime;
-
-                    bool currentStatus = GetJsonRecordStatus();
+// Runs on the file watcher thread once the INI has settled
+void OnJsonRecordIniChanged() {
+    if (!fs::exists(g_jsonRecordIniPath)) return;
+    if (!IniDocument::ContentChanged(g_jsonRecordIniPath)) return;
 
-                    if (lastStatus != currentStatus) {
-                        WriteToAdvancedLog("JsonRecord status changed from " + std::string(lastStatus ? "true" : "false") +
-                                          " to " + std::string(currentStatus ? "true" : "false"), __LINE__);
-                    }
+    bool currentStatus = GetJsonRecordStatus();
 
-                    if (!lastStatus && currentStatus) {
-                        WriteToAdvancedLog("JsonRecord status changed from false to true, initiating JSON record copy and reset", __LINE__);
+    if (g_jsonRecordLastStatus != currentStatus) {
+        WriteToAdvancedLog("JsonRecord status changed from " + std::string(g_jsonRecordLastStatus ? "true" : "false") +
+                          " to " + std::string(currentStatus ? "true" : "false"), __LINE__);
+    }
 
-                        bool copySuccess = CopyJsonRecordFile();
+    if (!g_jsonRecordLastStatus && currentStatus) {
+        WriteToAdvancedLog("JsonRecord status changed from false to true, initiating JSON record copy and reset", __LINE__);
 
-                        if (copySuccess) {
-                            WriteToAdvancedLog("JSON record copy completed successfully", __LINE__);
+        bool copySuccess = CopyJsonRecordFile();
 
-                            bool resetSuccess = SetJsonRecordStatus(false);
-                            if (resetSuccess) {
-                                WriteToAdvancedLog("JsonRecord status reset to false by plugin", __LINE__);
-                            } else {
-                                WriteToAdvancedLog("ERROR: Failed to reset JsonRecord status to false", __LINE__);
-                            }
-                        } else {
-                            WriteToAdvancedLog("ERROR: JSON record copy failed", __LINE__);
-                        }
+        if (copySuccess) {
+            WriteToAdvancedLog("JSON record copy completed successfully", __LINE__);
 
-                        lastStatus = false;
-                    } else {
-                        lastStatus = currentStatus;
-                    }
-                }
+            bool resetSuccess = SetJsonRecordStatus(false);
+            if (resetSuccess) {
+                WriteToAdvancedLog("JsonRecord status reset to false by plugin", __LINE__);
+            } else {
+                WriteToAdvancedLog("ERROR: Failed to reset JsonRecord status to false", __LINE__);
             }
-        } catch (const std::exception& e) {
-            WriteToAdvancedLog("ERROR in JsonRecord monitor: " + std::string(e.what()), __LINE__);
-        } catch (...) {
-            WriteToAdvancedLog("ERROR in JsonRecord monitor: Unknown exception", __LINE__);
+        } else {
+            WriteToAdvancedLog("ERROR: JSON record copy failed", __LINE__);
         }
 
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        g_jsonRecordLastStatus = false;
+    } else {
+        g_jsonRecordLastStatus = currentStatus;
     }
-
-    logger::info("JsonRecord monitoring thread stopped");
-    WriteToAdvancedLog("JsonRecord monitoring thread stopped", __LINE__);
 }
 
 void StartJsonMasterMonitoring() {
     if (!g_monitoringJsonMaster.load() && !g_jsonMasterIniPath.empty() && fs::exists(g_jsonMasterIniPath)) {
         g_monitoringJsonMaster = true;
-        g_jsonMonitorThread = std::thread(JsonMasterMonitorThreadFunction);
+        IniDocument::AcknowledgeContent(g_jsonMasterIniPath);
+        g_jsonMasterLastStatus = GetJsonMasterStatus();
+        WriteToAdvancedLog("JsonMaster initial status: " + std::string(g_jsonMasterLastStatus ? "true" : "false"), __LINE__);
+        g_fileWatcher.Watch(g_jsonMasterIniPath, kFileWatchDebounce, OnJsonMasterIniChanged);
         WriteToAdvancedLog("JsonMaster monitoring started for: " + g_jsonMasterIniPath.string(), __LINE__);
         WriteToAdvancedLog("JSON Source: " + g_jsonSourcePath.string(), __LINE__);
         WriteToAdvancedLog("JSON Destination: " + g_jsonDestPath.string(), __LINE__);
@@ -1109,7 +960,10 @@ void StartJsonMasterMonitoring() {
 void StartJsonRecordMonitoring() {
     if (!g_monitoringJsonRecord.load() && !g_jsonRecordIniPath.empty() && fs::exists(g_jsonRecordIniPath)) {
         g_monitoringJsonRecord = true;
-        g_jsonRecordMonitorThread = std::thread(JsonRecordMonitorThreadFunction);
+        IniDocument::AcknowledgeContent(g_jsonRecordIniPath);
+        g_jsonRecordLastStatus = GetJsonRecordStatus();
+        WriteToAdvancedLog("JsonRecord initial status: " + std::string(g_jsonRecordLastStatus ? "true" : "false"), __LINE__);
+        g_fileWatcher.Watch(g_jsonRecordIniPath, kFileWatchDebounce, OnJsonRecordIniChanged);
         WriteToAdvancedLog("JsonRecord monitoring started for: " + g_jsonRecordIniPath.string(), __LINE__);
     } else {
         if (g_jsonRecordIniPath.empty()) {
@@ -1123,9 +977,7 @@ void StartJsonRecordMonitoring() {
 void StopJsonMasterMonitoring() {
     if (g_monitoringJsonMaster.load()) {
         g_monitoringJsonMaster = false;
-        if (g_jsonMonitorThread.joinable()) {
-            g_jsonMonitorThread.join();
-        }
+        g_fileWatcher.Unwatch(g_jsonMasterIniPath);
         WriteToAdvancedLog("JsonMaster monitoring stopped", __LINE__);
     }
 }
@@ -1133,9 +985,7 @@ void StopJsonMasterMonitoring() {
 void StopJsonRecordMonitoring() {
     if (g_monitoringJsonRecord.load()) {
         g_monitoringJsonRecord = false;
-        if (g_jsonRecordMonitorThread.joinable()) {
-            g_jsonRecordMonitorThread.join();
-        }
+        g_fileWatcher.Unwatch(g_jsonRecordIniPath);
         WriteToAdvancedLog("JsonRecord monitoring stopped", __LINE__);
     }
 }
@@ -1710,7 +1560,7 @@ void ProcessOBodyPDAActivation() {
     WriteToAdvancedLog("MCM BUTTON PRESSED - STANDALONE MODE", __LINE__);
     WriteToAdvancedLog("========================================", __LINE__);
 
-    std::thread([]() {
+    g_scheduler.Post("MCM activation", []() {
         try {
             WriteToAdvancedLog("Executing Standalone Mode.exe", __LINE__);
             ExecuteStandaloneModeEXE();
@@ -1718,20 +1568,18 @@ void ProcessOBodyPDAActivation() {
             WriteToAdvancedLog("MCM activation process finished", __LINE__);
             WriteToAdvancedLog("========================================", __LINE__);
 
-            std::this_thread::sleep_for(std::chrono::seconds(5));
-
-            {
+            g_scheduler.After("MCM activation cooldown", std::chrono::seconds(5), TaskMode::kInline, []() {
                 std::lock_guard<std::mutex> lock(g_mcmActivationMutex);
                 g_mcmActivationBlocked = false;
                 WriteToAdvancedLog("MCM activation cooldown ended - Ready for next activation", __LINE__);
-            }
+            });
 
         } catch (const std::exception& e) {
             WriteToAdvancedLog("ERROR in MCM activation: " + std::string(e.what()), __LINE__);
             std::lock_guard<std::mutex> lock(g_mcmActivationMutex);
             g_mcmActivationBlocked = false;
         }
-    }).detach();
+    });
 }
 
 namespace ObodyPDA_Native {
@@ -2310,7 +2158,10 @@ void InitializePlugin() {
 }
 
 // ===== SHUTDOWN PLUGIN WITH JSON MASTER SUPPORT =====
+// Not called yet: SKSE sends no message when the game exits, so at DLL unload the threads are
+// only stopped by the g_fileWatcher and g_scheduler destructors
 void ShutdownPlugin() {
+    const auto shutdownStart = std::chrono::steady_clock::now();
     logger::info("OBODY PDA PLUGIN SHUTTING DOWN");
     WriteToAdvancedLog("PLUGIN SHUTTING DOWN", __LINE__);
 
@@ -2319,7 +2170,11 @@ void ShutdownPlugin() {
     StopAllSounds();
     StopJsonMasterMonitoring();
     StopJsonRecordMonitoring();
+    g_fileWatcher.Stop();
+    g_scheduler.Stop();
 
+    const auto shutdownMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - shutdownStart);
+    WriteToAdvancedLog("Plugin shutdown took " + std::to_string(shutdownMs.count()) + " ms", __LINE__);
     WriteToAdvancedLog("========================================", __LINE__);
     WriteToAdvancedLog("Plugin shutdown complete at: " + GetCurrentTimeString(), __LINE__);
     WriteToAdvancedLog("========================================", __LINE__);
@@ -0,0 +1,9 @@
+// The benches print what the plugins would write to their advanced log
+
+#include <iostream>
+
+#include "AdvancedLog.h"
+
+void WriteToAdvancedLog(const std::string& message, int lineNumber) {
+    std::cout << "[" << lineNumber << "] " << message << std::endl;
+}
@@ -0,0 +1,198 @@
+// DiffCatalogSnapshots on synthetic load orders from 30k to 300k forms, checked against an oracle
+// that indexes both snapshots in ordered maps and looks every form up on the other side.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "CatalogDiff.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using DiffRecord = std::tuple<CatalogDiffEntry::Kind, std::uint64_t, std::string, std::string>;
+
+struct OracleDiff {
+    std::map<std::string, std::vector<DiffRecord>> entries;  // Plugins present on both sides
+    std::set<std::string> newPlugins;
+    std::set<std::string> removedPlugins;
+    size_t added = 0;
+    size_t removed = 0;
+    size_t renamed = 0;
+};
+
+// (plugin name, key without its plugin bits) -> form name
+std::map<std::pair<std::string, std::uint64_t>, std::string> IndexSnapshot(const CatalogSnapshot& snapshot) {
+    std::map<std::pair<std::string, std::uint64_t>, std::string> index;
+    for (const auto& row : snapshot.rows) {
+        index.emplace(std::make_pair(snapshot.pluginNames[CatalogSnapshot::KeyPlugin(row.key)], row.key & 0xFFFFFFFFull),
+                      std::string(snapshot.Name(row)));
+    }
+    return index;
+}
+
+OracleDiff DiffByLookup(const CatalogSnapshot& previous, const CatalogSnapshot& current) {
+    auto before = IndexSnapshot(previous);
+    auto after = IndexSnapshot(current);
+    std::set<std::string> previousPlugins(previous.pluginNames.begin(), previous.pluginNames.end());
+    std::set<std::string> currentPlugins(current.pluginNames.begin(), current.pluginNames.end());
+
+    OracleDiff oracle;
+    for (const auto& [key, name] : before) {
+        oracle.removed += !after.contains(key);
+        if (!currentPlugins.contains(key.first)) {
+            oracle.removedPlugins.insert(key.first);
+            continue;
+        }
+        auto it = after.find(key);
+        if (it == after.end()) {
+            oracle.entries[key.first].emplace_back(CatalogDiffEntry::Kind::kRemoved, key.second, name, "");
+        } else if (it->second != name) {
+            oracle.entries[key.first].emplace_back(CatalogDiffEntry::Kind::kRenamed, key.second, name, it->second);
+            oracle.renamed++;
+        }
+    }
+    for (const auto& [key, name] : after) {
+        if (before.contains(key)) continue;
+        oracle.added++;
+        if (!previousPlugins.contains(key.first)) {
+            oracle.newPlugins.insert(key.first);
+        } else {
+            oracle.entries[key.first].emplace_back(CatalogDiffEntry::Kind::kAdded, key.second, "", name);
+        }
+    }
+    return oracle;
+}
+
+bool MatchesOracle(const CatalogDiffResult& diff, OracleDiff oracle) {
+    if (diff.totalAdded != oracle.added || diff.totalRemoved != oracle.removed || diff.totalRenamed != oracle.renamed) {
+        return false;
+    }
+
+    size_t changedShared = 0;
+    for (size_t i = 0; i < diff.plugins.size(); ++i) {
+        const auto& plugin = diff.plugins[i];
+        std::string name(plugin.pluginName);
+        size_t entryEnd = (i + 1 < diff.plugins.size()) ? diff.plugins[i + 1].firstEntry : diff.entries.size();
+
+        if (!plugin.inPrevious || !plugin.inCurrent) {
+            auto& expected = plugin.inCurrent ? oracle.newPlugins : oracle.removedPlugins;
+            if (expected.erase(name) != 1 || entryEnd != plugin.firstEntry) return false;
+            continue;
+        }
+
+        std::vector<DiffRecord> records;
+        for (size_t e = plugin.firstEntry; e < entryEnd; ++e) {
+            const auto& entry = diff.entries[e];
+            records.emplace_back(entry.kind, entry.key, std::string(entry.oldName), std::string(entry.newName));
+        }
+        auto expected = oracle.entries.find(name);
+        if (expected == oracle.entries.end()) return false;
+        std::sort(records.begin(), records.end());
+        std::sort(expected->second.begin(), expected->second.end());
+        if (records != expected->second) return false;
+        changedShared++;
+    }
+    return changedShared == oracle.entries.size() && oracle.newPlugins.empty() && oracle.removedPlugins.empty();
+}
+
+}  // namespace
+
+// Plugin 0 disappears and plugin kPlugins is new; every other plugin randomly drops, adds and renames
+// forms. Names with tabs check that a fresh snapshot compares equal to the same snapshot read back.
+bool BenchmarkCatalogDiff() {
+    constexpr int kFormsPerPlugin = 150;
+
+    const fs::path directory = fs::temp_directory_path() / "OBodyPDA_CatalogDiffBenchmark";
+    fs::create_directories(directory);
+    const fs::path snapshotPath = directory / "Act2_CatalogSnapshot.txt";
+
+    std::uint32_t seed = 2828;
+    auto roll = [&seed](std::uint32_t outOf) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % outOf;
+    };
+
+    bool passed = true;
+    for (int plugins : {200, 700, 2000}) {
+        CatalogSnapshot previous;
+        CatalogSnapshot current;
+        previous.timestamp = "synthetic";
+        char pluginName[32];
+        std::string name;
+
+        for (int p = 0; p <= plugins; ++p) {
+            std::snprintf(pluginName, sizeof(pluginName), "SyntheticPlugin_%05d.esp", p);
+            if (p < plugins) previous.pluginNames.emplace_back(pluginName);
+            if (p > 0) current.pluginNames.emplace_back(pluginName);
+
+            for (int i = 0; i < kFormsPerPlugin; ++i) {
+                auto type = static_cast<CatalogFormType>(i % kCatalogFormTypeCount);
+                std::uint32_t localID = 0x800 + static_cast<std::uint32_t>(i / kCatalogFormTypeCount);
+                name = "SynForm_" + std::to_string(p) + "_" + std::to_string(i);
+                if (i % 50 == 7) name += "\tTabbed";
+
+                std::uint32_t change = roll(100);
+                if (p < plugins && change != 0) {
+                    previous.AddRow(static_cast<std::uint16_t>(p), type, localID, name);
+                }
+                if (p > 0 && change != 1) {
+                    if (change == 2) name += "_Renamed";
+                    current.AddRow(static_cast<std::uint16_t>(p - 1), type, localID, name);
+                }
+            }
+        }
+
+        auto byKey = [](const CatalogSnapshotRow& a, const CatalogSnapshotRow& b) { return a.key < b.key; };
+        std::sort(previous.rows.begin(), previous.rows.end(), byKey);
+        std::sort(current.rows.begin(), current.rows.end(), byKey);
+
+        auto diffStart = std::chrono::steady_clock::now();
+        CatalogDiffResult diff = DiffCatalogSnapshots(previous, current);
+        auto diffEnd = std::chrono::steady_clock::now();
+        OracleDiff oracle = DiffByLookup(previous, current);
+        auto oracleEnd = std::chrono::steady_clock::now();
+        bool match = MatchesOracle(diff, std::move(oracle));
+
+        bool saved = SaveCatalogSnapshot(current, snapshotPath);
+        auto saveEnd = std::chrono::steady_clock::now();
+        CatalogSnapshot reloaded;
+        bool loaded = LoadCatalogSnapshot(snapshotPath, reloaded);
+        auto loadEnd = std::chrono::steady_clock::now();
+        CatalogDiffResult roundTrip = DiffCatalogSnapshots(current, reloaded);
+        bool roundTripEqual = saved && loaded && reloaded.rows.size() == current.rows.size() && roundTrip.plugins.empty();
+
+        auto ms = [](auto from, auto to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        ss << "[Benchmark] Catalog diff, " << previous.rows.size() << " -> " << current.rows.size() << " forms, "
+           << diff.plugins.size() << " plugins changed (+" << diff.totalAdded << " -" << diff.totalRemoved << " ~"
+           << diff.totalRenamed << "): merge " << ms(diffStart, diffEnd) << " ms ("
+           << ms(diffStart, diffEnd) * 1e6 / static_cast<double>(current.rows.size()) << " ns/form), map lookup "
+           << ms(diffEnd, oracleEnd) << " ms | save " << ms(oracleEnd, saveEnd) << " ms, load " << ms(saveEnd, loadEnd)
+           << " ms | oracle " << (match ? "match" : "MISMATCH") << ", round trip "
+           << (roundTripEqual ? "unchanged" : "CHANGED");
+        WriteToAdvancedLog(ss.str(), __LINE__);
+        passed = passed && match && roundTripEqual;
+    }
+
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+    return passed;
+}
+
+int main() {
+    return BenchmarkCatalogDiff() ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+// SelectNearestRows (nth_element, then sorting only the closest K) against sorting every candidate,
+// with the ring boundary parser and FindDistanceRing checked against hand-written expectations.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "DistanceRings.h"
+
+namespace {
+
+bool SameBounds(const std::vector<DistanceRing>& rings, const std::vector<float>& expected) {
+    if (expected.empty()) return rings.empty();
+    if (rings.size() + 1 != expected.size()) return false;
+    for (size_t i = 0; i < rings.size(); ++i) {
+        if (rings[i].minDistance != expected[i] || rings[i].maxDistance != expected[i + 1]) return false;
+        if (rings[i].inRange != 0 || rings[i].returned != 0) return false;
+    }
+    return true;
+}
+
+bool ParserChecks() {
+    struct Case {
+        const char* spec;
+        std::vector<float> bounds;
+    };
+    const Case cases[] = {
+        {"500,1500", {0.0f, 500.0f, 1500.0f, 3000.0f}},
+        {" 1500 ,\t500,500\r", {0.0f, 500.0f, 1500.0f, 3000.0f}},
+        {"abc,0,-5,3000,4000,700", {0.0f, 700.0f, 3000.0f}},
+        {"", {}},
+        {",,", {}},
+        {"2999.5", {0.0f, 2999.5f, 3000.0f}},
+    };
+
+    bool passed = true;
+    for (const auto& c : cases) {
+        bool ok = SameBounds(ParseDistanceRings(c.spec, 3000.0f), c.bounds);
+        if (!ok) WriteToAdvancedLog("MISMATCH: ring spec \"" + std::string(c.spec) + "\"", __LINE__);
+        passed = passed && ok;
+    }
+
+    // A distance on a boundary belongs to the outer ring; anything past the radius to the last one
+    auto rings = ParseDistanceRings("500,1500", 3000.0f);
+    const std::pair<float, size_t> lookups[] = {
+        {0.0f, 0}, {499.9f, 0}, {500.0f, 1}, {1499.0f, 1}, {1500.0f, 2}, {2999.0f, 2}, {3500.0f, 2},
+    };
+    for (const auto& [distance, ring] : lookups) {
+        bool ok = FindDistanceRing(rings, distance) == ring;
+        if (!ok) WriteToAdvancedLog("MISMATCH: ring for " + std::to_string(distance), __LINE__);
+        passed = passed && ok;
+    }
+    return passed;
+}
+
+// Every candidate fully sorted by (distance, row), which is the order the top K must come out in
+std::vector<std::uint32_t> SortedRows(const std::vector<GridHit>& hits) {
+    std::vector<std::uint32_t> rows(hits.size());
+    std::iota(rows.begin(), rows.end(), 0u);
+    std::sort(rows.begin(), rows.end(), [&hits](std::uint32_t a, std::uint32_t b) {
+        if (hits[a].distanceSquared != hits[b].distanceSquared) return hits[a].distanceSquared < hits[b].distanceSquared;
+        return a < b;
+    });
+    return rows;
+}
+
+// Distances are coarse so many candidates tie and the row order has to break the ties
+std::vector<GridHit> RandomHits(size_t count, std::uint32_t& seed) {
+    std::vector<GridHit> hits(count);
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float distance = static_cast<float>((seed >> 8) % 3000u);
+        hits[i] = {static_cast<std::uint32_t>(i), distance * distance};
+    }
+    return hits;
+}
+
+bool SelectionChecks(std::uint32_t& seed, size_t& runs) {
+    bool passed = true;
+    for (size_t count : {0, 1, 2, 7, 64, 500}) {
+        auto hits = RandomHits(count, seed);
+        auto sorted = SortedRows(hits);
+        for (size_t k : {size_t{0}, size_t{1}, size_t{5}, count / 2, count, count + 3}) {
+            std::vector<std::uint32_t> rows(count);
+            std::iota(rows.begin(), rows.end(), 0u);
+            std::reverse(rows.begin(), rows.end());
+
+            size_t selected = SelectNearestRows(rows, hits, k);
+            bool ok = selected == std::min(k, count) && std::equal(rows.begin(), rows.begin() + selected, sorted.begin());
+            std::sort(rows.begin(), rows.end());
+            for (size_t i = 0; ok && i < count; ++i) ok = rows[i] == i;
+
+            if (!ok) {
+                WriteToAdvancedLog("MISMATCH: nearest " + std::to_string(k) + " of " + std::to_string(count), __LINE__);
+            }
+            passed = passed && ok;
+            runs++;
+        }
+    }
+    return passed;
+}
+
+}  // namespace
+
+bool BenchmarkDistanceRings() {
+    constexpr int kRepeats = 200;
+
+    bool passed = ParserChecks();
+    std::uint32_t seed = 4040;
+    size_t selectionRuns = 0;
+    passed = SelectionChecks(seed, selectionRuns) && passed;
+
+    std::stringstream checks;
+    checks << "[Benchmark] Distance rings: ring parser, ring lookup and " << selectionRuns
+           << " nearest-K selections against a full sort: " << (passed ? "match" : "MISMATCH");
+    WriteToAdvancedLog(checks.str(), __LINE__);
+
+    for (size_t count : {500, 2000, 10000}) {
+        auto hits = RandomHits(count, seed);
+        std::vector<std::uint32_t> identity(count);
+        std::iota(identity.begin(), identity.end(), 0u);
+
+        for (size_t k : {10, 50}) {
+            std::vector<std::uint32_t> rows;
+            auto sortStart = std::chrono::steady_clock::now();
+            for (int r = 0; r < kRepeats; ++r) {
+                rows = identity;
+                SelectNearestRows(rows, hits, count);
+            }
+            auto sortEnd = std::chrono::steady_clock::now();
+            std::vector<std::uint32_t> fullSort(rows.begin(), rows.begin() + k);
+
+            for (int r = 0; r < kRepeats; ++r) {
+                rows = identity;
+                SelectNearestRows(rows, hits, k);
+            }
+            auto selectEnd = std::chrono::steady_clock::now();
+            bool match = std::equal(fullSort.begin(), fullSort.end(), rows.begin());
+
+            auto us = [](auto from, auto to) {
+                return std::chrono::duration<double, std::micro>(to - from).count() / kRepeats;
+            };
+
+            std::stringstream ss;
+            ss << std::fixed << std::setprecision(1);
+            ss << "[Benchmark] Nearest " << k << " of " << count << " candidates: full sort " << us(sortStart, sortEnd)
+               << " us, nth_element " << us(sortEnd, selectEnd) << " us (" << us(sortStart, sortEnd) / us(sortEnd, selectEnd)
+               << "x) | " << (match ? "match" : "MISMATCH");
+            WriteToAdvancedLog(ss.str(), __LINE__);
+            passed = passed && match;
+        }
+    }
+    return passed;
+}
+
+int main() {
+    return BenchmarkDistanceRings() ? 0 : 1;
+}
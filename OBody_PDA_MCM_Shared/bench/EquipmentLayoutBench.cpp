@@ -0,0 +1,118 @@
+// EquippedItems (a fixed array in kEquipSlotTable order) against the string-keyed map it replaced:
+// memory and allocations per actor, and the cost of building and exporting a 300-actor crowd. Both
+// exports must produce the same JSON, byte for byte.
+
+#include <chrono>
+#include <iomanip>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "EquipmentSlots.h"
+#include "FormCatalog.h"
+
+namespace {
+
+using LegacyEquipment = std::pmr::unordered_map<std::pmr::string, EquippedItemData>;
+
+// Roughly a fifth of the slots worn, with names and plugins long enough to leave the small-string buffer
+EquippedItemData SyntheticItem(size_t actor, size_t index) {
+    EquippedItemData item;
+    item.slot = kEquipSlotTable[index].slot;
+    if ((actor + index) % 5 == 0) {
+        item.equipped = true;
+        item.name = "Synthetic Armor Piece " + std::to_string((actor * 7 + index) % 40);
+        item.formID = 0x02000800u + static_cast<std::uint32_t>((actor * 7 + index) % 40);
+        item.pluginName = "SyntheticArmors_" + std::to_string(actor % 12) + ".esp";
+    }
+    return item;
+}
+
+// The old writer: keys in export order, each looked up in the map
+void WriteLegacyEquipmentJSON(std::ostream& out, const LegacyEquipment& equipment, const std::string& indent) {
+    std::vector<std::string> slotOrder;
+    for (const auto& info : kEquipSlotTable) slotOrder.emplace_back(info.jsonKey);
+
+    for (size_t i = 0; i < slotOrder.size(); ++i) {
+        auto it = equipment.find(std::pmr::string(slotOrder[i], equipment.get_allocator()));
+        if (it == equipment.end()) continue;
+        const auto& item = it->second;
+        out << indent << "\"" << slotOrder[i] << "\": {\n";
+        out << indent << "  \"equipped\": " << (item.equipped ? "true" : "false");
+        if (item.equipped) {
+            out << ",\n";
+            out << indent << "  \"name\": \"" << item.name << "\",\n";
+            out << indent << "  \"form_id\": \"0x" << std::hex << std::uppercase << item.formID << std::dec << "\",\n";
+            out << indent << "  \"plugin\": \"" << item.pluginName << "\"\n";
+        } else {
+            out << "\n";
+        }
+        out << indent << "}" << (i + 1 < slotOrder.size() ? "," : "") << "\n";
+    }
+}
+
+}  // namespace
+
+bool BenchmarkEquipmentLayout() {
+    constexpr size_t kActors = 300;
+    constexpr int kTicks = 20;
+
+    // Only the map's own nodes, keys and buckets go through the counter; the item strings are
+    // the same in both layouts
+    CountingMemoryResource mapHeap;
+    std::vector<LegacyEquipment> legacy;
+    std::string legacyJson;
+
+    auto legacyStart = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < kTicks; ++tick) {
+        legacy.clear();
+        legacy.reserve(kActors);
+        for (size_t a = 0; a < kActors; ++a) {
+            LegacyEquipment& equipment = legacy.emplace_back(&mapHeap);
+            for (size_t i = 0; i < kEquipSlotCount; ++i) {
+                equipment[std::pmr::string(kEquipSlotTable[i].jsonKey, &mapHeap)] = SyntheticItem(a, i);
+            }
+        }
+        std::ostringstream out;
+        for (const auto& equipment : legacy) WriteLegacyEquipmentJSON(out, equipment, "        ");
+        legacyJson = out.str();
+    }
+    auto legacyEnd = std::chrono::steady_clock::now();
+    size_t legacyAllocations = mapHeap.Allocations() / kTicks;
+    size_t legacyBytes = sizeof(LegacyEquipment) + mapHeap.BytesInUse() / kActors;
+
+    std::vector<EquippedItems> current;
+    std::string currentJson;
+    for (int tick = 0; tick < kTicks; ++tick) {
+        current.assign(kActors, EquippedItems{});
+        for (size_t a = 0; a < kActors; ++a) {
+            for (size_t i = 0; i < kEquipSlotCount; ++i) current[a][i] = SyntheticItem(a, i);
+        }
+        std::ostringstream out;
+        for (const auto& equipment : current) WriteEquippedItemsJSON(out, equipment, "        ");
+        currentJson = out.str();
+    }
+    auto currentEnd = std::chrono::steady_clock::now();
+
+    bool identical = !currentJson.empty() && legacyJson == currentJson;
+    double legacyMs = std::chrono::duration<double, std::milli>(legacyEnd - legacyStart).count() / kTicks;
+    double currentMs = std::chrono::duration<double, std::milli>(currentEnd - legacyEnd).count() / kTicks;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "[Benchmark] Equipment layout, " << kActors << " actors: map " << legacyBytes << " bytes/actor ("
+       << legacyAllocations / kActors << " allocations), array " << sizeof(EquippedItems)
+       << " bytes/actor (0 allocations) | build and export " << legacyMs << " -> " << currentMs << " ms/tick ("
+       << std::setprecision(1) << legacyMs / currentMs << "x) | JSON " << currentJson.size() / 1024 << " KB, "
+       << (identical ? "identical" : "DIFFERS");
+    WriteToAdvancedLog(ss.str(), __LINE__);
+
+    return identical;
+}
+
+int main() {
+    return BenchmarkEquipmentLayout() ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+// Any-of faction queries over FactionMembership bitsets against the per-actor string records kept
+// before the dictionary existed: time per query, memory per crowd, and the same actors selected
+// by both for every query. Interning checks that a loaded faction binds its CSV row by editor ID.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "FactionDictionary.h"
+
+namespace {
+
+// Same shape as the per-actor records written before the dictionary existed
+struct LegacyFaction {
+    std::string name;
+    std::string editorID;
+    std::uint32_t formID;
+    int rank;
+    bool isMember;
+};
+
+// CSV rows have no FormID until the game data is read; a second form reusing an editor ID, or one
+// without any, gets an entry of its own
+bool InternChecks() {
+    FactionDictionary dictionary;
+    std::uint32_t seeded = dictionary.Add(0, "BanditFaction", "Bandits");
+    bool passed = dictionary.Intern(0x0001BCC0, "BanditFaction", "") == seeded;
+    passed = passed && dictionary.Intern(0x0001BCC0, "BanditFaction", "Bandits") == seeded;
+    passed = passed && dictionary.Intern(0x0A000800, "BanditFaction", "Modded bandits") != seeded;
+    passed = passed && dictionary.Intern(0x0A000801, "", "") == 2;
+    passed = passed && dictionary.Size() == 3 && dictionary.ResolvedCount() == 3;
+
+    FactionBitset mask = dictionary.MaskForEditorIDs({"BanditFaction", "UnknownFaction"});
+    auto collected = dictionary.Collect(mask);
+    passed = passed && collected.size() == 1 && collected[0].first == seeded &&
+             collected[0].second.formID == 0x0001BCC0 && collected[0].second.name == "Bandits";
+    return passed;
+}
+
+}  // namespace
+
+bool BenchmarkFactionMembership() {
+    constexpr std::uint32_t kFactions = 1600;
+    constexpr size_t kActors = 1000;
+    constexpr size_t kFactionsPerActor = 6;
+    constexpr int kQueries = 200;
+
+    std::uint32_t seed = 3434;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+
+    FactionDictionary dictionary;
+    std::vector<std::string> editorIDs;
+    for (std::uint32_t i = 0; i < kFactions; ++i) {
+        editorIDs.push_back("BenchFaction" + std::to_string(i));
+        dictionary.Add(0x01000000 + i, editorIDs.back(), "Bench faction number " + std::to_string(i));
+    }
+
+    // A few town and crime factions are shared by most actors, the rest are spread thin
+    std::vector<std::vector<LegacyFaction>> legacy(kActors);
+    std::vector<FactionMembership> compact(kActors);
+    for (size_t a = 0; a < kActors; ++a) {
+        for (size_t f = 0; f < kFactionsPerActor; ++f) {
+            std::uint32_t index = (f < 2) ? next() % 32 : next() % kFactions;
+            auto rank = static_cast<std::int8_t>(next() % 4);
+            legacy[a].push_back({"Bench faction number " + std::to_string(index), editorIDs[index], 0x01000000 + index, rank, true});
+            compact[a].Add(index, rank);
+        }
+    }
+
+    // One common faction, two rare ones, and now and then a name the dictionary does not know
+    std::vector<std::vector<std::string>> queries;
+    for (int q = 0; q < kQueries; ++q) {
+        queries.push_back({editorIDs[next() % 32], editorIDs[next() % kFactions], editorIDs[next() % kFactions]});
+        if (q % 10 == 0) queries.back().push_back("NotAFaction" + std::to_string(q));
+    }
+
+    std::vector<std::vector<size_t>> legacySelected(kQueries);
+    auto start = std::chrono::steady_clock::now();
+    for (int q = 0; q < kQueries; ++q) {
+        const auto& query = queries[q];
+        for (size_t a = 0; a < kActors; ++a) {
+            bool match = std::any_of(legacy[a].begin(), legacy[a].end(), [&](const LegacyFaction& faction) {
+                return std::find(query.begin(), query.end(), faction.editorID) != query.end();
+            });
+            if (match) legacySelected[q].push_back(a);
+        }
+    }
+    auto legacyEnd = std::chrono::steady_clock::now();
+
+    std::vector<std::vector<size_t>> bitsetSelected(kQueries);
+    for (int q = 0; q < kQueries; ++q) {
+        FactionBitset mask = dictionary.MaskForEditorIDs(queries[q]);
+        for (size_t a = 0; a < kActors; ++a) {
+            if (FactionBitsIntersect(compact[a].bits, mask)) bitsetSelected[q].push_back(a);
+        }
+    }
+    auto bitsetEnd = std::chrono::steady_clock::now();
+
+    size_t legacyMatches = 0;
+    size_t bitsetMatches = 0;
+    size_t mismatchedQueries = 0;
+    for (int q = 0; q < kQueries; ++q) {
+        legacyMatches += legacySelected[q].size();
+        bitsetMatches += bitsetSelected[q].size();
+        mismatchedQueries += legacySelected[q] != bitsetSelected[q];
+    }
+
+    size_t legacyBytes = 0;
+    size_t compactBytes = 0;
+    for (size_t a = 0; a < kActors; ++a) {
+        legacyBytes += legacy[a].capacity() * sizeof(LegacyFaction);
+        for (const auto& faction : legacy[a]) {
+            if (faction.name.capacity() > 15) legacyBytes += faction.name.capacity() + 1;
+            if (faction.editorID.capacity() > 15) legacyBytes += faction.editorID.capacity() + 1;
+        }
+        compactBytes += compact[a].ranks.capacity() * sizeof(FactionRank) + compact[a].bits.capacity() * sizeof(std::uint64_t);
+    }
+
+    bool interned = InternChecks();
+    auto us = [](auto from, auto to) { return std::chrono::duration<double, std::micro>(to - from).count(); };
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "[Benchmark] Faction membership, " << kActors << " actors x " << kFactionsPerActor << " factions, "
+       << kQueries << " any-of queries: strings " << us(start, legacyEnd) / kQueries << " us/query, bitset "
+       << us(legacyEnd, bitsetEnd) / kQueries << " us/query | matches " << legacyMatches << "/" << bitsetMatches << ", "
+       << mismatchedQueries << " queries mismatched | memory " << legacyBytes / 1024 << " KB -> " << compactBytes / 1024
+       << " KB | interning " << (interned ? "ok" : "MISMATCH");
+    WriteToAdvancedLog(ss.str(), __LINE__);
+
+    return mismatchedQueries == 0 && legacyMatches > 0 && interned;
+}
+
+int main() {
+    return BenchmarkFactionMembership() ? 0 : 1;
+}
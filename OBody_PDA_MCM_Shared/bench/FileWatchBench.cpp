@@ -0,0 +1,118 @@
+// FileWatchService against the 1 s polling loops it replaced: edit-to-handler latency and idle
+// wakeups. On Linux this runs the inotify backend, on Windows ReadDirectoryChangesW.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+#include "FileWatchService.h"
+
+namespace fs = std::filesystem;
+
+// Edits a scratch file at random moments and measures how long the change takes to reach a
+// 1 s polling loop (the old monitor threads) and a FileWatchService handler, then counts how
+// often each wakes up while the file is left alone
+bool BenchmarkFileWatch() {
+    constexpr int kEdits = 5;
+    constexpr std::chrono::milliseconds kPollInterval(1000);
+    constexpr std::chrono::milliseconds kIdleWindow(2000);
+
+    const fs::path directory = fs::temp_directory_path() / "OBodyPDA_FileWatchBenchmark";
+    const fs::path file = directory / "watched.ini";
+    fs::create_directories(directory);
+
+    std::uint32_t seed = 777;
+    auto pause = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return std::chrono::milliseconds(100 + (seed >> 8) % 900);
+    };
+    auto edit = [&file](int round) {
+        std::ofstream out(file, std::ios::trunc);
+        out << "[Benchmark]\nround = " << round << "\n";
+    };
+
+    std::mutex mutex;
+    std::condition_variable seen;
+    std::optional<std::chrono::steady_clock::time_point> seenAt;
+    auto notify = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        seenAt = std::chrono::steady_clock::now();
+        seen.notify_one();
+    };
+
+    // A missed edit counts as -1 ms and shows up in the mean
+    auto measure = [&](auto&& wakeupCount, double& meanMs, double& maxMs, size_t& idleWakeups) {
+        meanMs = 0.0;
+        maxMs = 0.0;
+        for (int round = 0; round < kEdits; ++round) {
+            std::this_thread::sleep_for(pause());
+            std::unique_lock<std::mutex> lock(mutex);
+            seenAt.reset();
+            lock.unlock();
+            auto editedAt = std::chrono::steady_clock::now();
+            edit(round);
+            lock.lock();
+            seen.wait_for(lock, kPollInterval * 3, [&] { return seenAt.has_value(); });
+            double latency = seenAt ? std::chrono::duration<double, std::milli>(*seenAt - editedAt).count() : -1.0;
+            meanMs += latency / kEdits;
+            maxMs = std::max(maxMs, latency);
+        }
+        std::this_thread::sleep_for(kPollInterval);
+        size_t before = wakeupCount();
+        std::this_thread::sleep_for(kIdleWindow);
+        idleWakeups = wakeupCount() - before;
+    };
+
+    edit(-1);
+
+    std::atomic<bool> polling(true);
+    std::atomic<size_t> pollWakeups(0);
+    std::thread poller([&]() {
+        auto lastWrite = fs::last_write_time(file);
+        while (polling.load()) {
+            pollWakeups++;
+            std::error_code ec;
+            auto current = fs::last_write_time(file, ec);
+            if (!ec && current != lastWrite) {
+                lastWrite = current;
+                notify();
+            }
+            std::this_thread::sleep_for(kPollInterval);
+        }
+    });
+    double pollMean = 0.0, pollMax = 0.0;
+    size_t pollIdle = 0;
+    measure([&] { return pollWakeups.load(); }, pollMean, pollMax, pollIdle);
+    polling = false;
+    poller.join();
+
+    FileWatchService watcher;
+    watcher.Watch(file, kFileWatchDebounce, notify);
+    double eventMean = 0.0, eventMax = 0.0;
+    size_t eventIdle = 0;
+    measure([&] { return watcher.Wakeups(); }, eventMean, eventMax, eventIdle);
+    watcher.Stop();
+
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "[Benchmark] File watch, " << kEdits << " edits: " << kPollInterval.count() << " ms polling mean " << pollMean
+       << " ms / max " << pollMax << " ms, events mean " << eventMean << " ms / max " << eventMax << " ms (debounce "
+       << kFileWatchDebounce.count() << " ms) | idle " << kIdleWindow.count() << " ms: polling " << pollIdle
+       << " wakeups, events " << eventIdle;
+    WriteToAdvancedLog(ss.str(), __LINE__);
+    return eventMean >= 0.0 && eventIdle == 0;
+}
+
+int main() {
+    return BenchmarkFileWatch() ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+// 5,000-plugin Act2_Plugins.ini and 60,000 form lookups: the previous IniDocument load into a
+// case-sensitive string map with one std::string per lookup, against PluginFilterList bound
+// to synthetic load-order IDs. Both must keep the same forms. Reloads of unchanged content must
+// be skipped, by content hash in Parse and by timestamp and size in Load.
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "PluginFilterList.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void WriteFile(const fs::path& path, const std::string& content) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+// Load through the mapped file: missing, empty, loaded, then untouched and rewritten with the same bytes
+bool LoadChecks(const fs::path& directory, const std::string& content, size_t plugins) {
+    using LoadResult = PluginFilterList::LoadResult;
+    const fs::path path = directory / "Act2_Plugins.ini";
+    PluginFilterList list;
+
+    bool passed = list.Load(path) == LoadResult::kMissing && list.Empty();
+    WriteFile(path, "");
+    passed = passed && list.Load(path) == LoadResult::kLoaded && list.Empty();
+    WriteFile(path, content);
+    passed = passed && list.Load(path) == LoadResult::kLoaded && list.Size() == plugins;
+    passed = passed && list.Load(path) == LoadResult::kUnchanged;
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(2));
+    passed = passed && list.Load(path) == LoadResult::kUnchanged && list.Size() == plugins;
+
+    // Names fold case, later lines win, and comments, sections and lines without '=' are skipped
+    passed = passed && list.Parse("[Plugins]\r\n; Skyrim.esm = true\r\nUpdate.esm = true\r\nUPDATE.ESM = false\r\n"
+                                  "Dawnguard.esm = 1\r\nbroken line\r\n") == LoadResult::kLoaded;
+    passed = passed && list.Size() == 2 && !list.Find("Skyrim.esm") && !list.Enabled("update.esm") &&
+             list.Enabled("DAWNGUARD.ESM");
+    passed = passed && list.Parse("[Plugins]\r\n; SKYRIM.ESM = TRUE\r\nUpdate.esm = true\r\nUPDATE.ESM = false\r\n"
+                                  "Dawnguard.esm = 1\r\nbroken line\r\n") == LoadResult::kUnchanged;
+    return passed;
+}
+
+}  // namespace
+
+bool BenchmarkFilterList() {
+    constexpr int kPlugins = 5000;
+    constexpr int kForms = 60000;
+    constexpr int kRounds = 10;
+
+    std::string content = "; Act2 plugin filter\r\n[Plugins]\r\n";
+    std::vector<std::string> loadOrder;
+    for (int i = 0; i < kPlugins; ++i) {
+        loadOrder.push_back("Synthetic Plugin " + std::to_string(i) + (i % 3 ? ".esp" : ".esl"));
+        content += loadOrder.back() + " = " + (i % 4 ? "true" : "false") + "\r\n";
+    }
+    std::vector<std::uint32_t> formPlugins(kForms);
+    std::uint32_t seed = 4242;
+    for (auto& plugin : formPlugins) {
+        seed = seed * 1664525u + 1013904223u;
+        plugin = (seed >> 8) % kPlugins;
+    }
+
+    auto legacyStart = std::chrono::steady_clock::now();
+    size_t legacyKept = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        IniDocument ini;
+        ini.Parse(content);
+        std::unordered_map<std::string, bool> filterMap;
+        filterMap.reserve(ini.EntryCount());
+        ini.ForEachEntry([&](const IniDocument::Entry& entry) {
+            filterMap[std::string(entry.key)] = IniDocument::ToBool(entry.value);
+        });
+        legacyKept = 0;
+        for (auto plugin : formPlugins) {
+            std::string pluginName = loadOrder[plugin];
+            auto it = filterMap.find(pluginName);
+            legacyKept += it != filterMap.end() && it->second;
+        }
+    }
+
+    // Load order IDs stand in for GetLoadedPluginID
+    std::unordered_map<std::string, std::uint32_t> idByName;
+    for (size_t i = 0; i < loadOrder.size(); ++i) idByName[IniDocument::ToLower(loadOrder[i])] = static_cast<std::uint32_t>(i);
+    auto resolve = [&idByName](std::string_view name) {
+        auto it = idByName.find(std::string(name));
+        return it != idByName.end() ? it->second : kNoPluginID;
+    };
+
+    auto listStart = std::chrono::steady_clock::now();
+    size_t listKept = 0;
+    double bindUs = 0.0;
+    for (int round = 0; round < kRounds; ++round) {
+        PluginFilterList list;
+        list.Parse(content);
+        auto bindStart = std::chrono::steady_clock::now();
+        list.BindLoadOrder(resolve);
+        bindUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - bindStart).count();
+        listKept = 0;
+        for (auto plugin : formPlugins) listKept += list.EnabledByID(plugin);
+    }
+    auto listEnd = std::chrono::steady_clock::now();
+
+    PluginFilterList cached;
+    cached.Parse(content);
+    size_t unchanged = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        unchanged += cached.Parse(content) == PluginFilterList::LoadResult::kUnchanged;
+    }
+    auto unchangedEnd = std::chrono::steady_clock::now();
+
+    size_t byName = 0;
+    for (const auto& name : loadOrder) byName += cached.Enabled(IniDocument::ToLower(name));
+
+    const fs::path directory = fs::temp_directory_path() / "OBodyPDA_FilterListBenchmark";
+    fs::create_directories(directory);
+    bool loads = LoadChecks(directory, content, kPlugins);
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+
+    auto ms = [](auto from, auto to) { return std::chrono::duration<double, std::milli>(to - from).count() / kRounds; };
+    double legacyMs = ms(legacyStart, listStart);
+    double listMs = ms(listStart, listEnd);
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "[Benchmark] Filter list, " << kPlugins << " plugins x " << kForms << " lookups: load + lookups " << legacyMs
+       << " -> " << listMs << " ms (x" << (listMs > 0.0 ? legacyMs / listMs : 0.0) << ", bind " << bindUs / kRounds / 1000.0
+       << " ms) | unchanged reload " << ms(listEnd, unchangedEnd) << " ms (" << unchanged << "/" << kRounds << " skipped) | kept "
+       << legacyKept << "/" << listKept << ", " << byName << " enabled by name | file loads " << (loads ? "ok" : "MISMATCH");
+    WriteToAdvancedLog(ss.str(), __LINE__);
+
+    // Every fourth plugin is disabled
+    return legacyKept == listKept && legacyKept > 0 && unchanged == kRounds && byName == cached.EnabledCount() &&
+           byName == static_cast<size_t>(kPlugins - (kPlugins + 3) / 4) && loads;
+}
+
+int main() {
+    return BenchmarkFilterList() ? 0 : 1;
+}
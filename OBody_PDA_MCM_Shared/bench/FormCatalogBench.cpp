@@ -0,0 +1,211 @@
+// FormCatalog against the layout it replaced: a map from plugin name to vectors of name strings,
+// copied into a vector of those structs at the end of the scan. Both are filled from the same
+// synthetic 100k-form load order, phase by phase as the scan reads the form arrays. The old layout
+// is built from pmr containers with a CountingMemoryResource as the default resource, so both report
+// upstream allocations and peak bytes from the same counter.
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "FormCatalog.h"
+
+namespace {
+
+struct SyntheticForm {
+    size_t plugin;
+    CatalogFormType type;
+    std::uint32_t formID;
+    std::string name;
+    std::vector<std::pair<std::uint32_t, std::string>> items;
+};
+
+struct LegacyItem {
+    std::pmr::string name;
+    std::uint32_t formID;
+};
+
+struct LegacyOutfit {
+    std::pmr::string name;
+    std::uint32_t formID;
+    std::pmr::vector<LegacyItem> items;
+};
+
+struct LegacyPlugin {
+    std::pmr::string pluginName;
+    std::pmr::vector<LegacyItem> armors;
+    std::pmr::vector<LegacyOutfit> outfits;
+    std::pmr::vector<LegacyItem> weapons;
+};
+
+// Rows of one plugin and type must be the legacy vector's entries, in the same order
+template <typename Entry>
+bool SameRows(const FormCatalog& catalog, const FormCatalog::Grouping& grouping, std::uint16_t pluginID,
+              CatalogFormType type, const std::pmr::vector<Entry>& entries) {
+    std::uint32_t begin = grouping.Begin(pluginID, type);
+    if (grouping.End(pluginID, type) - begin != entries.size()) return false;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        size_t row = grouping.rows[begin + i];
+        if (catalog.GetFormID(row) != entries[i].formID || catalog.GetName(row) != entries[i].name) return false;
+    }
+    return true;
+}
+
+bool SameContents(FormCatalog& catalog, const std::pmr::vector<LegacyPlugin>& legacy) {
+    if (catalog.PluginCount() != legacy.size()) return false;
+
+    std::unordered_map<std::string_view, std::uint16_t> pluginIDs;
+    for (std::uint16_t id = 0; id < catalog.PluginCount(); ++id) pluginIDs.emplace(catalog.GetPluginName(id), id);
+
+    auto grouping = catalog.GroupByPluginAndType();
+    for (const auto& plugin : legacy) {
+        auto it = pluginIDs.find(plugin.pluginName);
+        if (it == pluginIDs.end()) return false;
+        std::uint16_t pluginID = it->second;
+
+        if (!SameRows(catalog, grouping, pluginID, CatalogFormType::kArmor, plugin.armors) ||
+            !SameRows(catalog, grouping, pluginID, CatalogFormType::kOutfit, plugin.outfits) ||
+            !SameRows(catalog, grouping, pluginID, CatalogFormType::kWeapon, plugin.weapons)) {
+            return false;
+        }
+
+        std::uint32_t outfitBegin = grouping.Begin(pluginID, CatalogFormType::kOutfit);
+        for (size_t i = 0; i < plugin.outfits.size(); ++i) {
+            size_t row = grouping.rows[outfitBegin + i];
+            const auto& items = plugin.outfits[i].items;
+            if (catalog.ItemEnd(row) - catalog.ItemBegin(row) != items.size()) return false;
+            for (size_t k = 0; k < items.size(); ++k) {
+                size_t item = catalog.ItemBegin(row) + k;
+                if (catalog.GetItemFormID(item) != items[k].formID || catalog.GetItemName(item) != items[k].name) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+bool BenchmarkFormCatalog() {
+    constexpr size_t kPlugins = 500;
+    constexpr int kArmorsPerPlugin = 120;
+    constexpr int kOutfitsPerPlugin = 20;
+    constexpr int kItemsPerOutfit = 4;
+    constexpr int kWeaponsPerPlugin = 60;
+
+    std::vector<std::string> pluginNames;
+    for (size_t p = 0; p < kPlugins; ++p) pluginNames.push_back("SyntheticPlugin_" + std::to_string(p) + ".esp");
+
+    auto armorName = [](size_t p, int i) { return "SynArmor_" + std::to_string(p) + "_" + std::to_string(i); };
+    std::vector<SyntheticForm> forms;
+    for (size_t p = 0; p < kPlugins; ++p) {
+        std::uint32_t base = static_cast<std::uint32_t>(p & 0xFF) << 24;
+        for (int i = 0; i < kArmorsPerPlugin; ++i) {
+            forms.push_back({p, CatalogFormType::kArmor, base | (0x1000 + i), armorName(p, i), {}});
+        }
+    }
+    for (size_t p = 0; p < kPlugins; ++p) {
+        std::uint32_t base = static_cast<std::uint32_t>(p & 0xFF) << 24;
+        for (int i = 0; i < kOutfitsPerPlugin; ++i) {
+            SyntheticForm outfit{p, CatalogFormType::kOutfit, base | (0x2000 + i),
+                                 "SynOutfit_" + std::to_string(p) + "_" + std::to_string(i), {}};
+            for (int k = 0; k < kItemsPerOutfit; ++k) {
+                int armor = (i * kItemsPerOutfit + k) % kArmorsPerPlugin;
+                outfit.items.emplace_back(base | (0x1000 + armor), armorName(p, armor));
+            }
+            forms.push_back(std::move(outfit));
+        }
+    }
+    for (size_t p = 0; p < kPlugins; ++p) {
+        std::uint32_t base = static_cast<std::uint32_t>(p & 0xFF) << 24;
+        for (int i = 0; i < kWeaponsPerPlugin; ++i) {
+            forms.push_back({p, CatalogFormType::kWeapon, base | (0x3000 + i),
+                             "SynWeapon_" + std::to_string(p) + "_" + std::to_string(i), {}});
+        }
+    }
+    size_t outfitCount = kPlugins * kOutfitsPerPlugin;
+
+    auto catalogStart = std::chrono::steady_clock::now();
+    auto catalog = std::make_unique<FormCatalog>();
+    catalog->Reserve(forms.size(), outfitCount * 4, forms.size() * 32);
+    std::vector<std::uint16_t> pluginCache(kPlugins, FormCatalog::kNoPlugin);
+    for (const auto& form : forms) {
+        std::uint16_t& pluginID = pluginCache[form.plugin];
+        if (pluginID == FormCatalog::kNoPlugin) pluginID = catalog->InternPlugin(pluginNames[form.plugin]);
+        catalog->AddForm(form.formID, pluginID, form.type, form.name);
+        for (const auto& [itemFormID, itemName] : form.items) catalog->AddOutfitItem(itemFormID, itemName);
+    }
+    auto catalogEnd = std::chrono::steady_clock::now();
+
+    CountingMemoryResource legacyCounter;
+    std::pmr::memory_resource* previousDefault = std::pmr::set_default_resource(&legacyCounter);
+    auto legacyStart = std::chrono::steady_clock::now();
+    std::pmr::vector<LegacyPlugin> legacy;
+    {
+        std::pmr::unordered_map<std::pmr::string, LegacyPlugin> pluginMap;
+        for (const auto& form : forms) {
+            std::pmr::string pluginName(pluginNames[form.plugin]);  // The old scan copied file->fileName per form
+            auto& plugin = pluginMap[pluginName];
+            if (plugin.pluginName.empty()) plugin.pluginName = pluginName;
+
+            if (form.type == CatalogFormType::kArmor) {
+                plugin.armors.push_back({std::pmr::string(form.name), form.formID});
+            } else if (form.type == CatalogFormType::kWeapon) {
+                plugin.weapons.push_back({std::pmr::string(form.name), form.formID});
+            } else {
+                LegacyOutfit outfit{std::pmr::string(form.name), form.formID, {}};
+                for (const auto& [itemFormID, itemName] : form.items) {
+                    outfit.items.push_back({std::pmr::string(itemName), itemFormID});
+                }
+                plugin.outfits.push_back(std::move(outfit));
+            }
+        }
+        for (const auto& [pluginName, plugin] : pluginMap) legacy.push_back(plugin);
+    }
+    auto legacyEnd = std::chrono::steady_clock::now();
+    size_t legacyAllocations = legacyCounter.Allocations();
+    size_t legacyPeak = legacyCounter.PeakBytes();
+
+    bool contentsMatch = catalog->Size() == forms.size() && catalog->ItemCount() == outfitCount * kItemsPerOutfit &&
+                         catalog->CountOfType(CatalogFormType::kOutfit) == outfitCount && SameContents(*catalog, legacy);
+
+    size_t formCount = catalog->Size();
+    size_t itemCount = catalog->ItemCount();
+    size_t allocations = catalog->UpstreamAllocations();
+    size_t peakBytes = catalog->PeakBytes();
+
+    auto releaseStart = std::chrono::steady_clock::now();
+    catalog.reset();
+    auto catalogReleased = std::chrono::steady_clock::now();
+    legacy = std::pmr::vector<LegacyPlugin>();
+    auto legacyReleased = std::chrono::steady_clock::now();
+    bool legacyFreed = legacyCounter.BytesInUse() == 0;
+    std::pmr::set_default_resource(previousDefault);
+
+    auto ms = [](auto from, auto to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "[Benchmark] Form catalog, " << kPlugins << " plugins, " << formCount << " forms, " << itemCount
+       << " outfit items: catalog build " << ms(catalogStart, catalogEnd) << " ms, release "
+       << ms(releaseStart, catalogReleased) << " ms, " << allocations << " upstream allocations, peak "
+       << (peakBytes / 1024) << " KB (" << (peakBytes / formCount) << " bytes/form) | vector of strings build "
+       << ms(legacyStart, legacyEnd) << " ms, release " << ms(catalogReleased, legacyReleased) << " ms, "
+       << legacyAllocations << " allocations, peak " << (legacyPeak / 1024) << " KB (" << (legacyPeak / formCount)
+       << " bytes/form) | contents " << (contentsMatch ? "match" : "MISMATCH");
+    WriteToAdvancedLog(ss.str(), __LINE__);
+
+    return contentsMatch && legacyFreed && allocations < legacyAllocations && peakBytes < legacyPeak;
+}
+
+int main() {
+    return BenchmarkFormCatalog() ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+// The mapped SkyrimSwitch heartbeat against rewriting the tail of a log file on every beat.
+
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "AdvancedLog.h"
+#include "Heartbeat.h"
+
+namespace fs = std::filesystem;
+
+// Same format as the plugins' log timestamps
+std::string CurrentTimeString() {
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    std::stringstream ss;
+    ss << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
+    return ss.str();
+}
+
+// Beats a scratch heartbeat the old way (the last 20 lines rewritten into a log file) and through a
+// mapped HeartbeatRegion, and checks that a second mapping of the same file sees every beat
+bool BenchmarkHeartbeat() {
+    constexpr int kFileBeats = 2000;
+    constexpr int kMappedBeats = 1000000;
+
+    const fs::path directory = fs::temp_directory_path() / "OBodyPDA_HeartbeatBenchmark";
+    fs::create_directories(directory);
+
+    auto fileStart = std::chrono::steady_clock::now();
+    {
+        std::deque<std::string> lines;
+        const fs::path logPath = directory / "SkyrimSwitch.log";
+        for (int i = 0; i < kFileBeats; ++i) {
+            if (lines.size() >= 20) lines.pop_front();
+            lines.push_back(std::string("[").append(CurrentTimeString()).append("] [log] [info] the game is on"));
+            std::ofstream logFile(logPath, std::ios::trunc);
+            for (const auto& line : lines) logFile << line << "\n";
+        }
+    }
+    auto fileEnd = std::chrono::steady_clock::now();
+
+    HeartbeatRegion writer;
+    HeartbeatRegion reader;
+    const fs::path heartbeatPath = directory / "SkyrimSwitch.heartbeat";
+    bool mapped = writer.Open(heartbeatPath, kHeartbeatInterval) && reader.Open(heartbeatPath, kHeartbeatInterval);
+    std::uint64_t firstSequence = writer.Sequence();
+    auto mappedStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < kMappedBeats && mapped; ++i) writer.Beat(HeartbeatGameState::kInGame, kHeartbeatIniMonitor);
+    auto mappedEnd = std::chrono::steady_clock::now();
+    std::uint64_t seenBeats = (reader.Sequence() - firstSequence) / 2;
+    writer.Close();
+    reader.Close();
+
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+
+    auto perBeat = [](auto from, auto to, int beats) {
+        return std::chrono::duration<double, std::nano>(to - from).count() / beats;
+    };
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "[Benchmark] Heartbeat: log rewrite " << perBeat(fileStart, fileEnd, kFileBeats) / 1000.0 << " us/beat ("
+       << kFileBeats << " beats), mapped block " << perBeat(mappedStart, mappedEnd, kMappedBeats) << " ns/beat ("
+       << kMappedBeats << " beats, " << (mapped ? std::to_string(seenBeats) : std::string("mapping failed"))
+       << " seen through a second mapping)";
+    WriteToAdvancedLog(ss.str(), __LINE__);
+    return mapped && seenBeats == std::uint64_t(kMappedBeats);
+}
+
+int main() {
+    return BenchmarkHeartbeat() ? 0 : 1;
+}
@@ -0,0 +1,317 @@
+// IniDocument and IniSchema: tokenizing against the getline loop they replaced, schema dispatch
+// against a linear compare, and content-hash change detection against write-time seconds.
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "FileWatchService.h"
+#include "IniDocument.h"
+
+namespace fs = std::filesystem;
+
+// 5,000-line Act2_Plugins.ini: the old getline/erase/substr/transform loop against IniDocument,
+// once for tokenizing alone and once including the filter map the loader fills
+bool BenchmarkIniParser() {
+    constexpr int kLines = 5000;
+    constexpr int kRounds = 20;
+
+    std::string content = "; Act2 plugin filter\r\n[Plugins]\r\n";
+    for (int i = 0; i < kLines; ++i) {
+        content += "[Synthetic] Plugin Number " + std::to_string(i) + (i % 3 ? ".esp" : ".esl") + " = " +
+                   (i % 4 ? "true" : "False") + "\r\n";
+    }
+
+    auto legacyParse = [&](std::unordered_map<std::string, bool>* filterMap) {
+        std::istringstream iniFile(content);
+        std::string line;
+        while (std::getline(iniFile, line)) {
+            line.erase(0, line.find_first_not_of(" \t\r\n"));
+            line.erase(line.find_last_not_of(" \t\r\n") + 1);
+            if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+            if (line[0] == '[' && line[line.length() - 1] == ']' && line.find('=') == std::string::npos) continue;
+            size_t equalPos = line.find('=');
+            if (equalPos == std::string::npos) continue;
+            std::string pluginName = line.substr(0, equalPos);
+            std::string value = line.substr(equalPos + 1);
+            pluginName.erase(0, pluginName.find_first_not_of(" \t"));
+            pluginName.erase(pluginName.find_last_not_of(" \t") + 1);
+            value.erase(0, value.find_first_not_of(" \t"));
+            value.erase(value.find_last_not_of(" \t") + 1);
+            std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+            bool enabled = (value == "true" || value == "1" || value == "yes");
+            if (filterMap) (*filterMap)[pluginName] = enabled;
+        }
+    };
+
+    auto documentParse = [&](std::unordered_map<std::string, bool>* filterMap) {
+        IniDocument ini;
+        ini.Parse(content);
+        if (!filterMap) return;
+        filterMap->reserve(ini.EntryCount());
+        ini.ForEachEntry([&](const IniDocument::Entry& entry) {
+            (*filterMap)[std::string(entry.key)] = IniDocument::ToBool(entry.value);
+        });
+    };
+
+    std::unordered_map<std::string, bool> legacyMap;
+    std::unordered_map<std::string, bool> documentMap;
+    auto timeRounds = [&](auto&& parse, std::unordered_map<std::string, bool>* filterMap) {
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            if (filterMap) *filterMap = {};
+            parse(filterMap);
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kRounds;
+    };
+
+    double legacyTokenizeUs = timeRounds(legacyParse, nullptr);
+    double documentTokenizeUs = timeRounds(documentParse, nullptr);
+    double legacyLoadUs = timeRounds(legacyParse, &legacyMap);
+    double documentLoadUs = timeRounds(documentParse, &documentMap);
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "[Benchmark] INI parser, " << kLines << " lines: tokenize " << legacyTokenizeUs << " -> " << documentTokenizeUs
+       << " us (x" << (documentTokenizeUs > 0.0 ? legacyTokenizeUs / documentTokenizeUs : 0.0) << ") | filter list load "
+       << legacyLoadUs << " -> " << documentLoadUs << " us (x" << (documentLoadUs > 0.0 ? legacyLoadUs / documentLoadUs : 0.0)
+       << ") | " << (legacyMap == documentMap ? "same" : "DIFFERENT") << " result, " << documentMap.size() << " entries";
+    WriteToAdvancedLog(ss.str(), __LINE__);
+    return legacyMap == documentMap;
+}
+
+// One config file: parse its default text, then dispatch every entry through the schema's
+// perfect hash and through a linear section/key compare over the same rows. Lookups only,
+// nothing is assigned, so live config is untouched.
+template <size_t N>
+bool BenchmarkSchemaFile(std::stringstream& ss, const char* label, const IniSchema<N>& schema) {
+    constexpr int kRounds = 5000;
+
+    std::stringstream file;
+    schema.Write(file, true);
+    const std::string content = file.str();
+
+    auto parseStart = std::chrono::steady_clock::now();
+    size_t parsedEntries = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        IniDocument ini;
+        ini.Parse(content);
+        parsedEntries = ini.EntryCount();
+    }
+
+    IniDocument ini;
+    ini.Parse(content);
+
+    auto linearStart = std::chrono::steady_clock::now();
+    size_t linearHits = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        for (const auto& section : ini.Sections()) {
+            ini.ForEachEntry(section, [&](const IniDocument::Entry& entry) {
+                for (const auto& field : schema.Fields()) {
+                    if (IniDocument::EqualsNoCase(field.section, section.name) && IniDocument::EqualsNoCase(field.key, entry.key)) {
+                        linearHits++;
+                        break;
+                    }
+                }
+            });
+        }
+    }
+
+    auto hashStart = std::chrono::steady_clock::now();
+    size_t hashHits = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        for (const auto& section : ini.Sections()) {
+            ini.ForEachEntry(section, [&](const IniDocument::Entry& entry) {
+                hashHits += schema.Find(section.nameHash, entry.keyHash) != nullptr;
+            });
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto ns = [](auto from, auto to) { return std::chrono::duration<double, std::nano>(to - from).count() / kRounds; };
+    double linearNs = ns(linearStart, hashStart);
+    double hashNs = ns(hashStart, end);
+    const bool match = linearHits == hashHits && hashHits == size_t(kRounds) * N;
+    ss << " | " << label << " (" << parsedEntries << " keys): parse " << ns(parseStart, linearStart) << " ns, dispatch "
+       << linearNs << " -> " << hashNs << " ns (x" << (hashNs > 0.0 ? linearNs / hashNs : 0.0) << ")"
+       << (match ? "" : " MISMATCH");
+    return match;
+}
+
+// Scratch targets with the key layouts of the plugins' config files, so nothing live is assigned
+struct ScratchConfig {
+    bool npcStart = false;
+    int radio = 0;
+    bool continuous = false;
+    int intervalMs = 0;
+    float distanceThreshold = 0.0f;
+    int maxResults = 0;
+    std::string rings;
+    std::string factionQuery;
+    bool outfitsStart = false;
+    bool pluginList = false;
+    bool startNPCs = false;
+    bool pluginListNPCs = false;
+    double frameBudgetMs = 0.0;
+    bool record = false;
+    int flushIntervalS = 0;
+    std::string query;
+    std::string target;
+    std::string sex;
+    std::string races;
+    std::string plugins;
+    bool excludeVanilla = false;
+    float maxDistance = 0.0f;
+    bool startupSound = false;
+    bool topNotifications = false;
+    bool startAct3 = false;
+    bool startAct4 = false;
+};
+
+static ScratchConfig g_scratch;
+
+bool BenchmarkConfigSchema() {
+    constexpr IniSchema act2ManagerLayout(std::to_array<IniField>({
+        {"NPC_tracking", "start", &g_scratch.npcStart, "false"},
+        {"NPC_tracking", "radio", &g_scratch.radio, "3000"},
+        {"NPC_tracking", "continuous", &g_scratch.continuous, "false"},
+        {"NPC_tracking", "interval_ms", &g_scratch.intervalMs, "2000", 100, 60000},
+        {"NPC_tracking", "distance_threshold", &g_scratch.distanceThreshold, "128", 0},
+        {"NPC_tracking", "max_results", &g_scratch.maxResults, "0", 0},
+        {"NPC_tracking", "rings", &g_scratch.rings, ""},
+        {"NPC_tracking", "faction_query", &g_scratch.factionQuery, ""},
+        {"Plugin_Outfits", "start", &g_scratch.outfitsStart, "false"},
+        {"Plugin_Outfits", "Plugin_list", &g_scratch.pluginList, "false"},
+        {"Plugin_NPCs", "startNPCs", &g_scratch.startNPCs, "false"},
+        {"Plugin_NPCs", "Plugin_listNPCs", &g_scratch.pluginListNPCs, "false"},
+        {"Scheduler", "frame_budget_ms", &g_scratch.frameBudgetMs, "0.5", 0.05, 16},
+        {"History", "record", &g_scratch.record, "true"},
+        {"History", "flush_interval_s", &g_scratch.flushIntervalS, "60", 5, 3600},
+        {.section = "History", .key = "query", .target = &g_scratch.query, .defaultValue = "none",
+         .choices = "none|last_seen|cell|equipment_changes", .lowerCase = true},
+        {"History", "target", &g_scratch.target, ""},
+        {.section = "Filter", .key = "sex", .target = &g_scratch.sex, .defaultValue = "any",
+         .choices = "any|male|female", .lowerCase = true},
+        {"Filter", "races", &g_scratch.races, ""},
+        {"Filter", "plugins", &g_scratch.plugins, ""},
+        {"Filter", "exclude_vanilla", &g_scratch.excludeVanilla, "false"},
+        {"Filter", "max_distance", &g_scratch.maxDistance, "0", 0},
+    }));
+    constexpr IniSchema pdaSettingsLayout(std::to_array<IniField>({
+        {"Advanced_Manager", "Startup", &g_scratch.startupSound, "true"},
+        {"Top Notifications", "Visible", &g_scratch.topNotifications, "true"},
+    }));
+    constexpr IniSchema jsonMasterLayout(std::to_array<IniField>({
+        {"Act3_JSON", "startAct3", &g_scratch.startAct3, "false"},
+    }));
+    constexpr IniSchema jsonRecordLayout(std::to_array<IniField>({
+        {"Act4_JSON", "startAct4", &g_scratch.startAct4, "false"},
+    }));
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "[Benchmark] Config schema";
+    bool match = BenchmarkSchemaFile(ss, "Act2_Manager.ini", act2ManagerLayout);
+    match = BenchmarkSchemaFile(ss, "MCM.ini", pdaSettingsLayout) && match;
+    match = BenchmarkSchemaFile(ss, "JsonMaster.ini", jsonMasterLayout) && match;
+    match = BenchmarkSchemaFile(ss, "JsonRecord.ini", jsonRecordLayout) && match;
+    WriteToAdvancedLog(ss.str(), __LINE__);
+    return match;
+}
+
+// Replays a UI that rewrites a watched INI as fast as it can: every logical edit is followed by
+// a repeated event, a rewrite with the same bytes and a flag reset saved by the plugin. A
+// one-second time_t comparison (the old monitor threads) and IniDocument::ContentChanged are
+// asked after each step; exactly one reload per edit is expected. A second pass sends bursts of
+// edits through a FileWatchService to check the same through the debounce.
+bool BenchmarkChangeDetection() {
+    constexpr int kEdits = 200;
+    constexpr int kBursts = 10;
+    constexpr std::chrono::milliseconds kSettle(200);
+
+    const fs::path directory = fs::temp_directory_path() / "OBodyPDA_ChangeDetectionBenchmark";
+    const fs::path file = directory / "Act2_Manager.ini";
+    fs::create_directories(directory);
+
+    auto uiWrite = [&file](int edit) {
+        std::ofstream out(file, std::ios::binary | std::ios::trunc);
+        out << "[NPC_Tracking]\r\nstart = true\r\nradio = " << 1000 + edit << "\r\n";
+    };
+    auto pluginReset = [&file]() {
+        IniDocument ini;
+        ini.Load(file);
+        ini.Set("NPC_Tracking", "start", "false");
+        ini.Save(file);
+    };
+
+    uiWrite(-1);
+    IniDocument::AcknowledgeContent(file);
+    std::time_t lastSecond = std::chrono::duration_cast<std::chrono::seconds>(fs::last_write_time(file).time_since_epoch()).count();
+    size_t secondReloads = 0;
+    size_t contentReloads = 0;
+    size_t checks = 0;
+    auto check = [&]() {
+        checks++;
+        const std::time_t second =
+            std::chrono::duration_cast<std::chrono::seconds>(fs::last_write_time(file).time_since_epoch()).count();
+        if (second != lastSecond) {
+            lastSecond = second;
+            secondReloads++;
+        }
+        if (IniDocument::ContentChanged(file)) contentReloads++;
+    };
+
+    auto replayStart = std::chrono::steady_clock::now();
+    for (int edit = 0; edit < kEdits; ++edit) {
+        uiWrite(edit);
+        check();
+        check();
+        uiWrite(edit);
+        check();
+        pluginReset();
+        check();
+    }
+    auto replayEnd = std::chrono::steady_clock::now();
+
+    std::atomic<size_t> events(0);
+    std::atomic<size_t> watchedReloads(0);
+    FileWatchService watcher;
+    watcher.Watch(file, kFileWatchDebounce, [&]() {
+        events++;
+        if (IniDocument::ContentChanged(file)) watchedReloads++;
+    });
+    for (int burst = 0; burst < kBursts; ++burst) {
+        for (int step = 0; step < 3; ++step) uiWrite(kEdits + burst * 3 + step);
+        std::this_thread::sleep_for(kSettle);
+        uiWrite(kEdits + burst * 3 + 2);
+        std::this_thread::sleep_for(kSettle);
+        pluginReset();
+        std::this_thread::sleep_for(kSettle);
+    }
+    watcher.Stop();
+
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "[Benchmark] Change detection, " << kEdits << " edits (" << checks << " checks, expected " << kEdits
+       << " reloads): time_t seconds " << secondReloads << " reloads, content " << contentReloads << " reloads ("
+       << std::chrono::duration<double, std::micro>(replayEnd - replayStart).count() / checks
+       << " us per write+check) | watched, " << kBursts << " bursts: " << events.load() << " events, "
+       << watchedReloads.load() << " reloads (expected " << kBursts << ")";
+    WriteToAdvancedLog(ss.str(), __LINE__);
+    return contentReloads == kEdits && watchedReloads.load() == kBursts;
+}
+
+int main() {
+    bool passed = BenchmarkIniParser();
+    passed = BenchmarkConfigSchema() && passed;
+    passed = BenchmarkChangeDetection() && passed;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+// LiveEquipmentTable fed by equip events against walking every actor's inventory on each tracking
+// tick. The synthetic inventories mirror GetInventory(): a fresh ordered map per call, worn armor
+// claiming biped slots through ClaimBipedSlots. After a stream of random equip and unequip events
+// the table must agree with a fresh walk for every actor.
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "LiveEquipmentTable.h"
+
+namespace {
+
+struct SyntheticInventoryEntry {
+    std::uint32_t formID;
+    std::uint32_t slotMask;
+    bool isArmor;
+    bool worn;
+};
+
+EquippedFormIDs WalkInventory(const std::vector<SyntheticInventoryEntry>& inventory) {
+    std::map<std::uint32_t, const SyntheticInventoryEntry*> items;
+    for (const auto& entry : inventory) {
+        if (entry.isArmor) items.emplace(entry.formID, &entry);
+    }
+    std::array<const SyntheticInventoryEntry*, kBipedSlotCount> slotTable{};
+    for (const auto& [formID, entry] : items) {
+        if (entry->worn) ClaimBipedSlots(slotTable, entry, entry->slotMask);
+    }
+    EquippedFormIDs ids{};
+    for (size_t i = 0; i < kBipedSlotCount; ++i) {
+        ids[kFirstBipedEquipSlot + i] = slotTable[i] ? slotTable[i]->formID : 0;
+    }
+    return ids;
+}
+
+}  // namespace
+
+bool BenchmarkLiveEquipment() {
+    constexpr int kActors = 300;
+    constexpr int kItemsPerActor = 120;
+    constexpr int kEvents = 5000;
+    constexpr int kTicks = 20;
+
+    std::uint32_t seed = 5150;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 4;
+    };
+
+    // Worn armor never overlaps, as in game; FormIDs are unique within an inventory
+    std::vector<std::vector<SyntheticInventoryEntry>> inventories(kActors);
+    for (auto& inventory : inventories) {
+        std::uint32_t wornMask = 0;
+        for (int i = 0; i < kItemsPerActor; ++i) {
+            bool isArmor = (next() % 3) != 0;
+            std::uint32_t mask = 0;
+            if (isArmor) {
+                mask = 1u << (next() % kBipedSlotCount);
+                if (next() % 4 == 0) mask |= 1u << (next() % kBipedSlotCount);
+            }
+            bool worn = isArmor && (wornMask & mask) == 0 && next() % 8 == 0;
+            if (worn) wornMask |= mask;
+            inventory.push_back({0x01000000u + static_cast<std::uint32_t>(i) * 0x101u + next() % 0x100u, mask, isArmor, worn});
+        }
+    }
+
+    LiveEquipmentTable table;
+    for (int a = 0; a < kActors; ++a) {
+        table.Seed(static_cast<std::uint32_t>(a + 1), WalkInventory(inventories[a]));
+    }
+
+    // The game sends an unequip for whatever an equip displaces, then the equip itself
+    auto eventsStart = std::chrono::steady_clock::now();
+    for (int e = 0; e < kEvents; ++e) {
+        int a = static_cast<int>(next() % kActors);
+        auto& inventory = inventories[a];
+        auto& item = inventory[next() % inventory.size()];
+        if (!item.isArmor) continue;
+
+        auto refID = static_cast<std::uint32_t>(a + 1);
+        if (item.worn) {
+            item.worn = false;
+            table.OnArmorEvent(refID, item.formID, item.slotMask, false);
+            continue;
+        }
+        for (auto& other : inventory) {
+            if (other.worn && (other.slotMask & item.slotMask) != 0) {
+                other.worn = false;
+                table.OnArmorEvent(refID, other.formID, other.slotMask, false);
+            }
+        }
+        item.worn = true;
+        table.OnArmorEvent(refID, item.formID, item.slotMask, true);
+    }
+    auto eventsEnd = std::chrono::steady_clock::now();
+
+    size_t mismatches = 0;
+    for (int a = 0; a < kActors; ++a) {
+        EquippedFormIDs fromTable{};
+        if (!table.Lookup(static_cast<std::uint32_t>(a + 1), fromTable) || fromTable != WalkInventory(inventories[a])) {
+            mismatches++;
+        }
+    }
+
+    auto walkStart = std::chrono::steady_clock::now();
+    size_t walkFilled = 0;
+    for (int t = 0; t < kTicks; ++t) {
+        for (const auto& inventory : inventories) {
+            for (auto id : WalkInventory(inventory)) walkFilled += id != 0;
+        }
+    }
+    auto walkEnd = std::chrono::steady_clock::now();
+
+    size_t tableFilled = 0;
+    for (int t = 0; t < kTicks; ++t) {
+        for (int a = 0; a < kActors; ++a) {
+            EquippedFormIDs ids{};
+            table.Lookup(static_cast<std::uint32_t>(a + 1), ids);
+            for (auto id : ids) tableFilled += id != 0;
+        }
+    }
+    auto tableEnd = std::chrono::steady_clock::now();
+
+    EquippedFormIDs unused{};
+    bool unknownMisses = !table.Lookup(static_cast<std::uint32_t>(kActors + 1), unused);
+    table.Clear("bench");
+    bool clearedMisses = !table.Lookup(1, unused);
+
+    auto ms = [](auto from, auto to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "[Benchmark] Live equipment, " << kActors << " actors x " << kTicks << " reads: inventory walks "
+       << ms(walkStart, walkEnd) / kTicks << " ms/tick, table " << ms(walkEnd, tableEnd) / kTicks << " ms/tick | "
+       << kEvents << " events applied in " << ms(eventsStart, eventsEnd) << " ms | slots " << walkFilled << "/"
+       << tableFilled << ", " << mismatches << " actors mismatched";
+    WriteToAdvancedLog(ss.str(), __LINE__);
+
+    return mismatches == 0 && walkFilled == tableFilled && unknownMisses && clearedMisses;
+}
+
+int main() {
+    return BenchmarkLiveEquipment() ? 0 : 1;
+}
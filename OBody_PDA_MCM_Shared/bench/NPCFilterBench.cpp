@@ -0,0 +1,179 @@
+// The SSE2 FilterRows kernel against calling the scalar CompiledNPCFilter::Matches per row. Every
+// filter shape is first checked row for row against Matches on random columns of 0 to 67 rows, so
+// each remainder 0-3 left for the scalar tail is covered; the timed runs compare the two as well.
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "NPCFilter.h"
+
+namespace {
+
+constexpr float kRadius = 4000.0f;
+constexpr std::uint32_t kRaceCount = 10;
+constexpr std::uint32_t kPluginCount = 20;
+
+class Random {
+public:
+    explicit Random(std::uint32_t seed) : seed(seed) {}
+
+    std::uint32_t Next(std::uint32_t outOf) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % outOf;
+    }
+
+    float Unit() { return static_cast<float>(Next(1u << 24)) / static_cast<float>(1u << 24); }
+
+private:
+    std::uint32_t seed;
+};
+
+// Race FormIDs and load-order plugin IDs as the scan gathers them, with an unresolved row now and then
+FilterColumns RandomColumns(size_t rows, Random& random) {
+    FilterColumns columns;
+    columns.Reserve(rows);
+    for (size_t row = 0; row < rows; ++row) {
+        if (random.Next(50) == 0) {
+            columns.Push(std::numeric_limits<float>::infinity(), false, 0, 0xFFFFFFFF);
+            continue;
+        }
+        float distance = random.Unit() * kRadius;
+        std::uint32_t plugin = random.Next(kPluginCount);
+        columns.Push(distance * distance, random.Next(2) == 1, 0x00013740 + random.Next(kRaceCount),
+                     plugin < 16 ? plugin : 0xFE000 | plugin);
+    }
+    return columns;
+}
+
+// What the scan did before the kernel, and what the kernel does for its tail
+void ScalarRows(const CompiledNPCFilter& filter, const FilterColumns& columns, std::vector<std::uint32_t>& matches) {
+    for (size_t row = 0; row < columns.Size(); ++row) {
+        if (filter.Matches(columns.distanceSquared[row], columns.female[row], columns.raceIDs[row], columns.pluginIDs[row])) {
+            matches.push_back(static_cast<std::uint32_t>(row));
+        }
+    }
+}
+
+struct NamedFilter {
+    const char* name;
+    CompiledNPCFilter filter;
+};
+
+// The shapes [Filter] compiles to, from a lone distance cap to every restriction at once
+std::vector<NamedFilter> FilterShapes() {
+    std::vector<NamedFilter> shapes;
+    auto add = [&shapes](const char* name) -> CompiledNPCFilter& {
+        shapes.push_back({name, CompiledNPCFilter{}});
+        shapes.back().filter.active = true;
+        return shapes.back().filter;
+    };
+
+    add("distance 1/2").maxDistanceSquared = (kRadius * 0.5f) * (kRadius * 0.5f);
+    add("female").sex = FilterSex::kFemale;
+    add("male").sex = FilterSex::kMale;
+
+    auto& races = add("3 races");
+    races.restrictRaces = true;
+    races.raceIDs = {0x00013740, 0x00013743, 0x00013749};
+
+    auto& plugins = add("2 plugins");
+    plugins.restrictPlugins = true;
+    plugins.pluginIDs = {3, 0xFE000 | 17};
+
+    auto& vanilla = add("exclude vanilla");
+    vanilla.excludedPluginIDs = {0, 1, 2, 3, 4};
+
+    auto& narrow = add("female, 2 races, distance 1/4");
+    narrow.sex = FilterSex::kFemale;
+    narrow.restrictRaces = true;
+    narrow.raceIDs = {0x00013741, 0x00013742};
+    narrow.maxDistanceSquared = (kRadius * 0.25f) * (kRadius * 0.25f);
+
+    auto& everything = add("all restrictions");
+    everything.sex = FilterSex::kMale;
+    everything.restrictRaces = true;
+    everything.raceIDs = {0x00013740, 0x00013744, 0x00013745, 0x00013748};
+    everything.restrictPlugins = true;
+    everything.pluginIDs = {5, 6, 7, 8, 9, 0xFE000 | 18};
+    everything.excludedPluginIDs = {6, 0xFE000 | 18};
+    everything.maxDistanceSquared = (kRadius * 0.75f) * (kRadius * 0.75f);
+
+    add("empty races").restrictRaces = true;
+    return shapes;
+}
+
+}  // namespace
+
+bool BenchmarkNPCFilter() {
+    constexpr size_t kRows = 4096;
+    constexpr int kRepeats = 2000;
+
+    Random random(3939);
+    auto shapes = FilterShapes();
+
+    size_t equivalenceRuns = 0;
+    bool equivalent = true;
+    for (const auto& shape : shapes) {
+        for (size_t rows = 0; rows < 68; ++rows) {
+            for (int trial = 0; trial < 20; ++trial) {
+                FilterColumns columns = RandomColumns(rows, random);
+                std::vector<std::uint32_t> scalar;
+                std::vector<std::uint32_t> kernel;
+                ScalarRows(shape.filter, columns, scalar);
+                FilterRows(shape.filter, columns, kernel);
+                equivalent = equivalent && scalar == kernel;
+                equivalenceRuns++;
+            }
+        }
+    }
+
+    std::stringstream ss;
+    ss << "[Benchmark] NPC filter: SSE2 kernel against Matches on " << equivalenceRuns
+       << " random column sets of 0-67 rows, " << shapes.size() << " filters: " << (equivalent ? "match" : "MISMATCH");
+    WriteToAdvancedLog(ss.str(), __LINE__);
+
+    FilterColumns columns = RandomColumns(kRows, random);
+    bool timedMatch = true;
+    for (const auto& shape : shapes) {
+        auto scalarStart = std::chrono::steady_clock::now();
+        std::vector<std::uint32_t> scalar;
+        for (int r = 0; r < kRepeats; ++r) {
+            scalar.clear();
+            ScalarRows(shape.filter, columns, scalar);
+        }
+        auto scalarEnd = std::chrono::steady_clock::now();
+
+        std::vector<std::uint32_t> kernel;
+        for (int r = 0; r < kRepeats; ++r) {
+            kernel.clear();
+            FilterRows(shape.filter, columns, kernel);
+        }
+        auto kernelEnd = std::chrono::steady_clock::now();
+        timedMatch = timedMatch && scalar == kernel;
+
+        auto nsPerRow = [](auto from, auto to) {
+            return std::chrono::duration<double, std::nano>(to - from).count() / static_cast<double>(kRows * kRepeats);
+        };
+
+        std::stringstream row;
+        row << std::fixed << std::setprecision(1);
+        row << "[Benchmark] NPC filter, " << shape.name << ", " << kRows << " rows, "
+            << 100.0 * static_cast<double>(kernel.size()) / static_cast<double>(kRows) << "% selected: Matches "
+            << nsPerRow(scalarStart, scalarEnd) << " ns/row, SSE2 " << nsPerRow(scalarEnd, kernelEnd) << " ns/row ("
+            << nsPerRow(scalarStart, scalarEnd) / nsPerRow(scalarEnd, kernelEnd) << "x) | "
+            << (scalar == kernel ? "match" : "MISMATCH");
+        WriteToAdvancedLog(row.str(), __LINE__);
+    }
+
+    return equivalent && timedMatch;
+}
+
+int main() {
+    return BenchmarkNPCFilter() ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+// SpatialGridIndex radius and nearest-N queries against the linear walk over every actor.
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "SpatialGridIndex.h"
+
+// Compares the grid with the linear sqrt walk it replaced, and checks both give the same answers
+bool BenchmarkSpatialGrid() {
+    constexpr int kQueries = 200;
+    constexpr float kRadius = 3000.0f;
+    constexpr size_t kNearest = 10;
+
+    std::uint32_t seed = 4242;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+
+    bool passed = true;
+    for (int crowd : {50, 200, 500, 1000, 2000}) {
+        std::vector<GridPoint> points;
+        for (int i = 0; i < crowd; ++i) {
+            points.push_back({(next() - 0.5f) * 40000.0f, (next() - 0.5f) * 40000.0f, (next() - 0.5f) * 2000.0f,
+                              static_cast<std::uint32_t>(i)});
+        }
+        std::vector<GridPoint> queries;
+        for (int q = 0; q < kQueries; ++q) {
+            queries.push_back({(next() - 0.5f) * 40000.0f, (next() - 0.5f) * 40000.0f, 0.0f, 0});
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        size_t linearHits = 0;
+        std::vector<std::pair<float, std::uint32_t>> sortedAll;
+        std::vector<float> linearNearest;
+        for (const auto& q : queries) {
+            sortedAll.clear();
+            for (const auto& point : points) {
+                float distance = std::sqrt((point.x - q.x) * (point.x - q.x) + (point.y - q.y) * (point.y - q.y) +
+                                           (point.z - q.z) * (point.z - q.z));
+                if (distance <= kRadius) linearHits++;
+                sortedAll.emplace_back(distance, point.id);
+            }
+            std::sort(sortedAll.begin(), sortedAll.end());
+            for (size_t k = 0; k < kNearest && k < sortedAll.size(); ++k) linearNearest.push_back(sortedAll[k].first);
+        }
+        auto linearEnd = std::chrono::steady_clock::now();
+
+        SpatialGridIndex grid;
+        grid.Build(points);
+        auto buildEnd = std::chrono::steady_clock::now();
+
+        size_t gridHits = 0;
+        std::vector<GridHit> hits;
+        std::vector<float> gridNearest;
+        for (const auto& q : queries) {
+            hits.clear();
+            grid.QueryRadius(q.x, q.y, q.z, kRadius, hits);
+            gridHits += hits.size();
+            grid.QueryNearest(q.x, q.y, q.z, kNearest, std::numeric_limits<float>::max(), hits);
+            for (const auto& hit : hits) gridNearest.push_back(std::sqrt(hit.distanceSquared));
+        }
+        auto gridEnd = std::chrono::steady_clock::now();
+
+        bool nearestMatch = linearNearest.size() == gridNearest.size();
+        for (size_t i = 0; nearestMatch && i < linearNearest.size(); ++i) {
+            nearestMatch = std::abs(linearNearest[i] - gridNearest[i]) <= 0.01f * std::max(1.0f, linearNearest[i]);
+        }
+
+        auto us = [](auto from, auto to) { return std::chrono::duration<double, std::micro>(to - from).count(); };
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        ss << "[Benchmark] Spatial grid, " << crowd << " actors, " << kQueries << " queries: linear "
+           << us(start, linearEnd) / kQueries << " us/query, grid " << us(buildEnd, gridEnd) / kQueries
+           << " us/query (build " << us(linearEnd, buildEnd) << " us, " << grid.CellCount() << " cells) | radius hits "
+           << linearHits << "/" << gridHits << ", nearest " << (nearestMatch ? "match" : "MISMATCH");
+        WriteToAdvancedLog(ss.str(), __LINE__);
+        passed = passed && nearestMatch && linearHits == gridHits;
+    }
+    return passed;
+}
+
+int main() {
+    return BenchmarkSpatialGrid() ? 0 : 1;
+}
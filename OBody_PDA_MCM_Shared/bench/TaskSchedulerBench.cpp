@@ -0,0 +1,105 @@
+// TimerWheel against a binary heap, and periodic tasks on one TaskScheduler against a sleeping
+// thread per task.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <queue>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "TaskScheduler.h"
+
+// Arms random timers in the wheel and in a binary heap and checks that every wheel timer fires on
+// its due tick, then runs a set of periodic tasks once as sleeping threads and once on a scheduler
+bool BenchmarkTaskScheduler() {
+    constexpr int kTimers = 200000;
+    constexpr auto kTaskWindow = std::chrono::milliseconds(1500);
+    constexpr std::array<int, 6> kPeriodsMs = {30, 50, 100, 100, 200, 300};
+
+    std::uint32_t seed = 9001;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 4;
+    };
+
+    // Mostly short delays, as in the plugin, with a tail reaching the upper wheel levels
+    std::vector<std::uint64_t> dues(kTimers);
+    for (auto& due : dues) {
+        std::uint64_t range = next() % 10 == 0 ? TimerWheel::kMaxDelayTicks : 512;
+        due = 1 + next() % range;
+    }
+
+    auto wheelStart = std::chrono::steady_clock::now();
+    TimerWheel wheel;
+    for (int i = 0; i < kTimers; ++i) wheel.Insert(static_cast<std::uint64_t>(i), 0, dues[i]);
+    std::vector<TimerWheel::Timer> fired;
+    fired.reserve(kTimers);
+    size_t misfired = 0;
+    while (auto tick = wheel.NextTick()) {
+        size_t before = fired.size();
+        wheel.Advance(*tick, fired);
+        for (size_t i = before; i < fired.size(); ++i) misfired += fired[i].due != *tick;
+    }
+    auto wheelEnd = std::chrono::steady_clock::now();
+
+    using HeapEntry = std::pair<std::uint64_t, std::uint64_t>;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<>> heap;
+    for (int i = 0; i < kTimers; ++i) heap.push({dues[i], static_cast<std::uint64_t>(i)});
+    size_t heapFired = 0;
+    while (!heap.empty()) {
+        heap.pop();
+        heapFired++;
+    }
+    auto heapEnd = std::chrono::steady_clock::now();
+
+    std::atomic<size_t> threadRuns(0);
+    std::atomic<size_t> threadWakeups(0);
+    {
+        std::atomic<bool> running(true);
+        std::vector<std::thread> threads;
+        for (int period : kPeriodsMs) {
+            threads.emplace_back([&, period]() {
+                while (running.load()) {
+                    threadWakeups++;
+                    threadRuns++;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(period));
+                }
+            });
+        }
+        std::this_thread::sleep_for(kTaskWindow);
+        running = false;
+        for (auto& thread : threads) thread.join();
+    }
+
+    std::atomic<size_t> scheduledRuns(0);
+    std::string schedulerStats;
+    {
+        TaskScheduler scheduler;
+        for (int period : kPeriodsMs) {
+            scheduler.Every("benchmark", std::chrono::milliseconds(period), TaskMode::kInline, [&]() { scheduledRuns++; });
+        }
+        std::this_thread::sleep_for(kTaskWindow);
+        schedulerStats = scheduler.Stats();
+        scheduler.Stop();
+    }
+
+    auto ns = [](auto from, auto to) { return std::chrono::duration<double, std::nano>(to - from).count() / kTimers; };
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "[Benchmark] Task scheduler, " << kTimers << " timers: wheel " << ns(wheelStart, wheelEnd) << " ns/timer ("
+       << fired.size() << " fired, " << misfired << " off their tick), heap " << ns(wheelEnd, heapEnd) << " ns/timer ("
+       << heapFired << ") | " << kPeriodsMs.size() << " periodic tasks for " << kTaskWindow.count() << " ms: "
+       << kPeriodsMs.size() << " threads, " << threadRuns.load() << " runs, " << threadWakeups.load()
+       << " wakeups -> 1 timer thread, " << scheduledRuns.load() << " runs (" << schedulerStats << ")";
+    WriteToAdvancedLog(ss.str(), __LINE__);
+    return fired.size() == size_t(kTimers) && misfired == 0 && scheduledRuns.load() > 0;
+}
+
+int main() {
+    return BenchmarkTaskScheduler() ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <utility>
+
+// ===== ACT2_MANAGER.INI CONFIG =====
+// The sections of Act2_Manager.ini as the Act2 plugin reads them, and the read-copy-update
+// holder that publishes them. The loader fills staging copies and publishes an immutable
+// Act2ManagerConfig with one atomic store; readers take the pointer once and keep it for a
+// consistent view, never wait on a reload, and free an old snapshot with its last reference.
+
+struct NPCTrackingConfig {
+    bool start;
+    int radio;
+    std::time_t lastModified;
+    bool continuous;
+    int intervalMs;
+    float distanceThreshold;
+    int maxResults;        // 0 = every NPC in range
+    std::string rings;     // comma separated ring boundaries, e.g. "500,1500"
+    std::string factionQuery;  // comma separated faction editor IDs, e.g. "BanditFaction,GuardFaction"
+};
+
+struct PluginOutfitsConfig {
+    bool start;
+    bool pluginList;
+    std::time_t lastModified;
+    std::time_t lastPluginListModified;
+};
+
+struct PluginNPCsConfig {
+    bool startNPCs;
+    bool pluginListNPCs;
+    std::time_t lastModified;
+};
+
+struct SchedulerConfig {
+    double frameBudgetMs;
+};
+
+struct HistoryConfig {
+    bool record;
+    int flushIntervalS;
+    std::string query;
+    std::string target;
+};
+
+struct FilterConfig {
+    std::string sex;       // any | male | female
+    std::string races;     // comma separated race editor IDs or Plugin.esp|0xID
+    std::string plugins;   // comma separated plugin file names
+    bool excludeVanilla;
+    float maxDistance;     // 0 = whole scan radius
+};
+
+// One published view of Act2_Manager.ini
+struct Act2ManagerConfig {
+    NPCTrackingConfig npcTracking;
+    PluginOutfitsConfig pluginOutfits;
+    PluginNPCsConfig pluginNPCs;
+    SchedulerConfig scheduler;
+    HistoryConfig history;
+    FilterConfig filter;
+};
+
+class Act2ManagerConfigSnapshot {
+public:
+    explicit Act2ManagerConfigSnapshot(Act2ManagerConfig initial)
+        : current(std::make_shared<const Act2ManagerConfig>(std::move(initial))) {}
+
+    void Publish(Act2ManagerConfig config) {
+        current.store(std::make_shared<const Act2ManagerConfig>(std::move(config)), std::memory_order_release);
+    }
+
+    std::shared_ptr<const Act2ManagerConfig> Get() const {
+        return current.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<std::shared_ptr<const Act2ManagerConfig>> current;
+};
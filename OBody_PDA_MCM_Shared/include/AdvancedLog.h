@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Each plugin defines this (with a default line number) to append to its advanced log; the
+// headers in this folder report through it, and the bench programs print it to stdout
+void WriteToAdvancedLog(const std::string& message, int lineNumber);
+
+// The headers in this folder log through this instead, naming themselves: the plugin log would
+// otherwise print their __LINE__ as a line of plugin.cpp
+inline void WriteToAdvancedLogFrom(std::string_view header, const std::string& message, int lineNumber) {
+    std::string located("[");
+    located.append(header).append(":").append(std::to_string(lineNumber)).append("] ").append(message);
+    WriteToAdvancedLog(located, 0);
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "FormCatalog.h"
+
+// ===== CATALOG DIFF BETWEEN SESSIONS =====
+// At kDataLoaded the current catalog (armors, outfits, weapons, NPCs) is compared with the
+// snapshot saved by the previous session, then saved as the new snapshot. Forms are keyed by
+// plugin name and plugin-local FormID so a changed load order does not show up as a diff.
+// Both sides are kept sorted by (plugin, type, local FormID), which turns the diff into one merge.
+
+struct CatalogSnapshotRow {
+    std::uint64_t key;
+    std::uint32_t nameOffset;
+    std::uint32_t nameLength;
+};
+
+struct CatalogSnapshot {
+    std::string timestamp;
+    std::vector<std::string> pluginNames;
+    std::vector<CatalogSnapshotRow> rows;
+    std::string names;
+
+    std::string_view Name(const CatalogSnapshotRow& row) const {
+        return std::string_view(names).substr(row.nameOffset, row.nameLength);
+    }
+
+    void AddRow(std::uint16_t plugin, CatalogFormType type, std::uint32_t localID, std::string_view name) {
+        rows.push_back({MakeKey(plugin, type, localID), static_cast<std::uint32_t>(names.size()),
+                        static_cast<std::uint32_t>(name.size())});
+        names.append(name);
+        Normalize(names.begin() + rows.back().nameOffset, names.end());
+    }
+
+    // Tabs and line breaks would split a line of the saved file, which stores them as spaces; a
+    // fresh snapshot gets the same treatment so it compares equal to the one read back
+    static void Normalize(std::string::iterator begin, std::string::iterator end) {
+        std::replace_if(begin, end, [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+    }
+
+    static std::uint64_t MakeKey(std::uint16_t plugin, CatalogFormType type, std::uint32_t localID) {
+        return (static_cast<std::uint64_t>(plugin) << 32) | (static_cast<std::uint64_t>(type) << 24) | localID;
+    }
+    static std::uint16_t KeyPlugin(std::uint64_t key) { return static_cast<std::uint16_t>(key >> 32); }
+    static CatalogFormType KeyType(std::uint64_t key) { return static_cast<CatalogFormType>((key >> 24) & 0xFF); }
+    static std::uint32_t KeyLocalID(std::uint64_t key) { return static_cast<std::uint32_t>(key & 0xFFFFFF); }
+};
+
+struct CatalogDiffEntry {
+    enum class Kind : std::uint8_t { kAdded, kRemoved, kRenamed };
+
+    Kind kind;
+    std::uint64_t key;
+    std::string_view oldName;
+    std::string_view newName;
+};
+
+struct CatalogPluginDiff {
+    std::string_view pluginName;
+    bool inPrevious;
+    bool inCurrent;
+    size_t previousForms = 0;
+    size_t currentForms = 0;
+    size_t firstEntry = 0;
+    size_t added = 0;
+    size_t removed = 0;
+    size_t renamed = 0;
+};
+
+struct CatalogDiffResult {
+    std::vector<CatalogPluginDiff> plugins;
+    std::vector<CatalogDiffEntry> entries;
+    size_t totalAdded = 0;
+    size_t totalRemoved = 0;
+    size_t totalRenamed = 0;
+};
+
+// Strips the load order index: 0xFE light plugins keep 12 bits, regular plugins 24 bits
+inline std::uint32_t GetLocalFormID(std::uint32_t formID) {
+    return (formID >> 24) == 0xFE ? (formID & 0xFFF) : (formID & 0xFFFFFF);
+}
+
+inline CatalogSnapshot BuildSnapshotFromCatalog(const FormCatalog& catalog, std::string timestamp) {
+    CatalogSnapshot snapshot;
+    snapshot.timestamp = std::move(timestamp);
+
+    // Plugins are ranked by name so two sessions with different load orders still line up
+    std::vector<std::uint16_t> order(catalog.PluginCount());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<std::uint16_t>(i);
+    std::sort(order.begin(), order.end(), [&](std::uint16_t a, std::uint16_t b) {
+        return catalog.GetPluginName(a) < catalog.GetPluginName(b);
+    });
+
+    std::vector<std::uint16_t> rank(catalog.PluginCount());
+    snapshot.pluginNames.reserve(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        rank[order[i]] = static_cast<std::uint16_t>(i);
+        auto& pluginName = snapshot.pluginNames.emplace_back(catalog.GetPluginName(order[i]));
+        CatalogSnapshot::Normalize(pluginName.begin(), pluginName.end());
+    }
+
+    snapshot.rows.reserve(catalog.Size());
+    for (size_t row = 0; row < catalog.Size(); ++row) {
+        snapshot.AddRow(rank[catalog.GetPluginID(row)], catalog.GetType(row),
+                        GetLocalFormID(catalog.GetFormID(row)), catalog.GetName(row));
+    }
+
+    // Form arrays are almost always in FormID order already, which makes this nearly free
+    auto byKey = [](const CatalogSnapshotRow& a, const CatalogSnapshotRow& b) { return a.key < b.key; };
+    if (!std::is_sorted(snapshot.rows.begin(), snapshot.rows.end(), byKey)) {
+        std::sort(snapshot.rows.begin(), snapshot.rows.end(), byKey);
+    }
+    return snapshot;
+}
+
+inline bool SaveCatalogSnapshot(const CatalogSnapshot& snapshot, const std::filesystem::path& path) {
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        WriteToAdvancedLogFrom("CatalogDiff.h", "ERROR: Could not create " + tempPath.filename().string(), __LINE__);
+        return false;
+    }
+
+    auto writeClean = [&](std::string_view text) {
+        for (char c : text) file.put((c == '\t' || c == '\n' || c == '\r') ? ' ' : c);
+    };
+
+    file << "# OBody PDA catalog snapshot v1\n";
+    file << "timestamp\t" << snapshot.timestamp << "\n";
+
+    std::uint32_t currentPlugin = 0xFFFFFFFF;
+    char idBuffer[16];
+    for (const auto& row : snapshot.rows) {
+        std::uint16_t plugin = CatalogSnapshot::KeyPlugin(row.key);
+        if (plugin != currentPlugin) {
+            currentPlugin = plugin;
+            file << "plugin\t";
+            writeClean(snapshot.pluginNames[plugin]);
+            file << "\n";
+        }
+        std::snprintf(idBuffer, sizeof(idBuffer), "%06X", CatalogSnapshot::KeyLocalID(row.key));
+        file << static_cast<int>(CatalogSnapshot::KeyType(row.key)) << "\t" << idBuffer << "\t";
+        writeClean(snapshot.Name(row));
+        file << "\n";
+    }
+
+    file.close();
+    if (file.fail()) {
+        WriteToAdvancedLogFrom("CatalogDiff.h", "ERROR: Failed writing catalog snapshot", __LINE__);
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        WriteToAdvancedLogFrom("CatalogDiff.h", "ERROR: Could not replace catalog snapshot: " + ec.message(), __LINE__);
+        return false;
+    }
+    return true;
+}
+
+inline bool LoadCatalogSnapshot(const std::filesystem::path& path, CatalogSnapshot& snapshot) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    std::string line;
+    bool hasPlugin = false;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::string_view view(line);
+        size_t firstTab = view.find('\t');
+        if (firstTab == std::string_view::npos) continue;
+        std::string_view head = view.substr(0, firstTab);
+        std::string_view rest = view.substr(firstTab + 1);
+
+        if (head == "timestamp") {
+            snapshot.timestamp = rest;
+        } else if (head == "plugin") {
+            if (!snapshot.pluginNames.empty() && !(snapshot.pluginNames.back() < rest)) {
+                WriteToAdvancedLogFrom("CatalogDiff.h", "WARNING: Catalog snapshot plugins out of order, ignoring snapshot",
+                                       __LINE__);
+                return false;
+            }
+            snapshot.pluginNames.emplace_back(rest);
+            hasPlugin = true;
+        } else if (hasPlugin && head.size() == 1 && head[0] >= '0' && head[0] < '0' + static_cast<int>(kCatalogFormTypeCount)) {
+            size_t secondTab = rest.find('\t');
+            if (secondTab == std::string_view::npos) continue;
+
+            std::uint32_t localID = 0;
+            auto idText = rest.substr(0, secondTab);
+            auto [ptr, errc] = std::from_chars(idText.data(), idText.data() + idText.size(), localID, 16);
+            if (errc != std::errc()) continue;
+
+            snapshot.AddRow(static_cast<std::uint16_t>(snapshot.pluginNames.size() - 1),
+                            static_cast<CatalogFormType>(head[0] - '0'), localID & 0xFFFFFF, rest.substr(secondTab + 1));
+        }
+    }
+
+    auto byKey = [](const CatalogSnapshotRow& a, const CatalogSnapshotRow& b) { return a.key < b.key; };
+    if (!std::is_sorted(snapshot.rows.begin(), snapshot.rows.end(), byKey)) {
+        std::sort(snapshot.rows.begin(), snapshot.rows.end(), byKey);
+    }
+    return true;
+}
+
+// Two merges: plugin names first, then rows within each plugin shared by both snapshots
+inline CatalogDiffResult DiffCatalogSnapshots(const CatalogSnapshot& previous, const CatalogSnapshot& current) {
+    CatalogDiffResult result;
+
+    std::vector<size_t> previousStart(previous.pluginNames.size() + 1, previous.rows.size());
+    std::vector<size_t> currentStart(current.pluginNames.size() + 1, current.rows.size());
+    auto fillStarts = [](const CatalogSnapshot& snapshot, std::vector<size_t>& starts) {
+        size_t row = 0;
+        for (size_t plugin = 0; plugin < snapshot.pluginNames.size(); ++plugin) {
+            starts[plugin] = row;
+            while (row < snapshot.rows.size() && CatalogSnapshot::KeyPlugin(snapshot.rows[row].key) == plugin) ++row;
+        }
+    };
+    fillStarts(previous, previousStart);
+    fillStarts(current, currentStart);
+
+    size_t p = 0;
+    size_t c = 0;
+    while (p < previous.pluginNames.size() || c < current.pluginNames.size()) {
+        int order;
+        if (p == previous.pluginNames.size()) {
+            order = 1;
+        } else if (c == current.pluginNames.size()) {
+            order = -1;
+        } else {
+            order = previous.pluginNames[p].compare(current.pluginNames[c]);
+        }
+
+        CatalogPluginDiff plugin{};
+        plugin.firstEntry = result.entries.size();
+
+        if (order < 0) {
+            plugin.pluginName = previous.pluginNames[p];
+            plugin.inPrevious = true;
+            plugin.previousForms = previousStart[p + 1] - previousStart[p];
+            plugin.removed = plugin.previousForms;
+            ++p;
+        } else if (order > 0) {
+            plugin.pluginName = current.pluginNames[c];
+            plugin.inCurrent = true;
+            plugin.currentForms = currentStart[c + 1] - currentStart[c];
+            plugin.added = plugin.currentForms;
+            ++c;
+        } else {
+            plugin.pluginName = current.pluginNames[c];
+            plugin.inPrevious = true;
+            plugin.inCurrent = true;
+
+            size_t i = previousStart[p];
+            size_t iEnd = previousStart[p + 1];
+            size_t j = currentStart[c];
+            size_t jEnd = currentStart[c + 1];
+            plugin.previousForms = iEnd - i;
+            plugin.currentForms = jEnd - j;
+
+            // Keys differ only in their plugin bits here, so compare them without those
+            constexpr std::uint64_t kLocalMask = 0xFFFFFFFFull;
+            while (i < iEnd || j < jEnd) {
+                std::uint64_t oldKey = i < iEnd ? (previous.rows[i].key & kLocalMask) : ~0ull;
+                std::uint64_t newKey = j < jEnd ? (current.rows[j].key & kLocalMask) : ~0ull;
+
+                if (oldKey < newKey) {
+                    result.entries.push_back({CatalogDiffEntry::Kind::kRemoved, oldKey, previous.Name(previous.rows[i]), {}});
+                    plugin.removed++;
+                    ++i;
+                } else if (newKey < oldKey) {
+                    result.entries.push_back({CatalogDiffEntry::Kind::kAdded, newKey, {}, current.Name(current.rows[j])});
+                    plugin.added++;
+                    ++j;
+                } else {
+                    auto oldName = previous.Name(previous.rows[i]);
+                    auto newName = current.Name(current.rows[j]);
+                    if (oldName != newName) {
+                        result.entries.push_back({CatalogDiffEntry::Kind::kRenamed, newKey, oldName, newName});
+                        plugin.renamed++;
+                    }
+                    ++i;
+                    ++j;
+                }
+            }
+            ++p;
+            ++c;
+        }
+
+        result.totalAdded += plugin.added;
+        result.totalRemoved += plugin.removed;
+        result.totalRenamed += plugin.renamed;
+
+        if (plugin.added || plugin.removed || plugin.renamed) {
+            result.plugins.push_back(plugin);
+        }
+    }
+
+    return result;
+}
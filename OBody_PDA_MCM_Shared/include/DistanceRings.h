@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "SpatialGridIndex.h"
+
+// ===== TOP-K AND DISTANCE RINGS =====
+// max_results keeps only the closest K candidates: nth_element splits them off in O(n) and only
+// those K are sorted and captured. Skipped captures (unknown plugin, unnamed) pull the next
+// closest candidates in, so the result still holds K NPCs when enough exist.
+
+// One band of [NPC_tracking] rings; counts are filled in by the scan
+struct DistanceRing {
+    float minDistance;
+    float maxDistance;
+    int inRange;
+    int returned;
+};
+
+// "500,1500" with radius 3000 -> 0-500, 500-1500, 1500-3000; empty when no boundaries are set
+inline std::vector<DistanceRing> ParseDistanceRings(const std::string& spec, float radius) {
+    std::vector<float> bounds;
+    size_t begin = 0;
+    while (begin <= spec.size()) {
+        size_t end = std::min(spec.find(',', begin), spec.size());
+        std::string item = spec.substr(begin, end - begin);
+        begin = end + 1;
+
+        item.erase(0, item.find_first_not_of(" \t\r"));
+        item.erase(item.find_last_not_of(" \t\r") + 1);
+        if (item.empty()) continue;
+        try {
+            float bound = std::stof(item);
+            if (bound > 0.0f && bound < radius) bounds.push_back(bound);
+        } catch (...) {
+            WriteToAdvancedLogFrom("DistanceRings.h", "Ignoring invalid ring boundary: " + item, __LINE__);
+        }
+    }
+    if (bounds.empty()) return {};
+
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+    std::vector<DistanceRing> rings;
+    float lower = 0.0f;
+    for (float bound : bounds) {
+        rings.push_back({lower, bound, 0, 0});
+        lower = bound;
+    }
+    rings.push_back({lower, radius, 0, 0});
+    return rings;
+}
+
+inline size_t FindDistanceRing(const std::vector<DistanceRing>& rings, float distance) {
+    for (size_t i = 0; i + 1 < rings.size(); ++i) {
+        if (distance < rings[i].maxDistance) return i;
+    }
+    return rings.size() - 1;
+}
+
+// Orders the first min(k, n) rows by distance and returns how many are sorted; k == 0 sorts none
+inline size_t SelectNearestRows(std::vector<std::uint32_t>& rows, const std::vector<GridHit>& hits, size_t k) {
+    if (k == 0) return 0;
+
+    auto closer = [&hits](std::uint32_t a, std::uint32_t b) {
+        if (hits[a].distanceSquared != hits[b].distanceSquared) return hits[a].distanceSquared < hits[b].distanceSquared;
+        return a < b;
+    };
+
+    k = std::min(k, rows.size());
+    if (k < rows.size()) std::nth_element(rows.begin(), rows.begin() + k, rows.end(), closer);
+    std::sort(rows.begin(), rows.begin() + k, closer);
+    return k;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// ===== EQUIPMENT SLOTS =====
+// Equipment is a fixed array indexed by EquipSlot, described once by kEquipSlotTable: the slot
+// number and the JSON key of each entry, in export order. Filling it from an actor happens in
+// the plugins; this header only needs FormIDs.
+
+// Biped armor slots 30-61, one bit each in BGSBipedObjectForm::BipedObjectSlot
+constexpr size_t kBipedSlotCount = 32;
+
+struct EquippedItemData {
+    bool equipped;
+    std::string name;
+    std::uint32_t formID;
+    std::string pluginName;
+    int slot;
+
+    EquippedItemData() : equipped(false), formID(0), slot(-1) {}
+};
+
+// Export order of the equipped_items block: both hands, then biped slots 30-61
+enum class EquipSlot : std::uint8_t {
+    kRightHand,
+    kLeftHand,
+    kHead,
+    kHair,
+    kBody,
+    kHands,
+    kForearms,
+    kAmulet,
+    kRing,
+    kFeet,
+    kCalves,
+    kShield,
+    kTail,
+    kLongHair,
+    kCirclet,
+    kEars,
+    kFaceJewelry,
+    kNeck,
+    kChestPrimary,
+    kBack,
+    kMiscFX,
+    kPelvisPrimary,
+    kDecapitatedHead,
+    kDecapitate,
+    kPelvisSecondary,
+    kLegPrimaryRight,
+    kLegSecondaryLeft,
+    kFaceAlternate,
+    kChestSecondary,
+    kShoulder,
+    kArmLeft,
+    kArmRight,
+    kUnnamedFX,
+    kFX01,
+    kTotal
+};
+
+constexpr size_t kEquipSlotCount = static_cast<size_t>(EquipSlot::kTotal);
+constexpr size_t kFirstBipedEquipSlot = static_cast<size_t>(EquipSlot::kHead);
+
+struct EquipSlotInfo {
+    int slot;
+    const char* jsonKey;
+};
+
+constexpr std::array<EquipSlotInfo, kEquipSlotCount> kEquipSlotTable = {{
+    {-1, "right_hand"},
+    {-2, "left_hand"},
+    {30, "head"},
+    {31, "hair"},
+    {32, "body"},
+    {33, "hands"},
+    {34, "forearms"},
+    {35, "amulet"},
+    {36, "ring"},
+    {37, "feet"},
+    {38, "calves"},
+    {39, "shield"},
+    {40, "tail"},
+    {41, "long_hair"},
+    {42, "circlet"},
+    {43, "ears"},
+    {44, "face_jewelry"},
+    {45, "neck"},
+    {46, "chest_primary"},
+    {47, "back"},
+    {48, "misc_fx"},
+    {49, "pelvis_primary"},
+    {50, "decapitated_head"},
+    {51, "decapitate"},
+    {52, "pelvis_secondary"},
+    {53, "leg_primary_right"},
+    {54, "leg_secondary_left"},
+    {55, "face_alternate"},
+    {56, "chest_secondary"},
+    {57, "shoulder"},
+    {58, "arm_left"},
+    {59, "arm_right"},
+    {60, "unnamed_fx"},
+    {61, "fx01"},
+}};
+
+static_assert(kEquipSlotCount - kFirstBipedEquipSlot == kBipedSlotCount);
+static_assert(kEquipSlotTable[kFirstBipedEquipSlot].slot == 30 && kEquipSlotTable[kEquipSlotCount - 1].slot == 61);
+
+using EquippedItems = std::array<EquippedItemData, kEquipSlotCount>;
+using EquippedFormIDs = std::array<std::uint32_t, kEquipSlotCount>;
+
+// Each worn armor claims every still-empty slot in its mask, so the first armor met for a
+// slot wins, matching the old per-slot search
+template <class Item>
+void ClaimBipedSlots(std::array<Item, kBipedSlotCount>& slotTable, Item item, std::uint32_t slotMask) {
+    while (slotMask != 0) {
+        int bit = std::countr_zero(slotMask);
+        if (!slotTable[bit]) {
+            slotTable[bit] = item;
+        }
+        slotMask &= slotMask - 1;
+    }
+}
+
+inline EquippedFormIDs ToEquippedFormIDs(const EquippedItems& equippedItems) {
+    EquippedFormIDs ids{};
+    for (size_t i = 0; i < kEquipSlotCount; ++i) {
+        ids[i] = equippedItems[i].equipped ? equippedItems[i].formID : 0;
+    }
+    return ids;
+}
+
+// indent is the prefix of the slot keys; the "equipped_items" braces are written by the caller
+inline void WriteEquippedItemsJSON(std::ostream& jsonFile, const EquippedItems& equippedItems, const std::string& indent) {
+    for (size_t i = 0; i < kEquipSlotCount; ++i) {
+        const auto& item = equippedItems[i];
+        jsonFile << indent << "\"" << kEquipSlotTable[i].jsonKey << "\": {\n";
+        jsonFile << indent << "  \"equipped\": " << (item.equipped ? "true" : "false");
+
+        if (item.equipped) {
+            jsonFile << ",\n";
+            jsonFile << indent << "  \"name\": \"" << item.name << "\",\n";
+            jsonFile << indent << "  \"form_id\": \"0x" << std::hex << std::uppercase << item.formID << std::dec << "\",\n";
+            jsonFile << indent << "  \"plugin\": \"" << item.pluginName << "\"\n";
+        } else {
+            jsonFile << "\n";
+        }
+
+        jsonFile << indent << "}" << (i + 1 < kEquipSlotCount ? "," : "") << "\n";
+    }
+}
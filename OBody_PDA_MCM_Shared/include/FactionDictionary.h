@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ===== FACTION DICTIONARY =====
+// Every faction seen by the plugin gets one entry and a stable index. The table is seeded from
+// Assets/Data/AllFactions_EDID_Name.csv (editor ID and display name, no FormIDs) and completed at
+// kDataLoaded from the game's faction array, which fills in the FormIDs. Actors only keep indices
+// and ranks, and Act2_Manager.json writes each referenced faction once in "faction_dictionary".
+
+// Faction sets are bitsets over indices into the global faction dictionary; missing words are zero
+using FactionBitset = std::vector<std::uint64_t>;
+
+struct FactionRank {
+    std::uint32_t index;
+    std::int8_t rank;
+};
+
+// Faction membership of one actor: ranks sorted by dictionary index plus the matching bitset
+struct FactionMembership {
+    std::vector<FactionRank> ranks;
+    FactionBitset bits;
+
+    void Add(std::uint32_t index, std::int8_t rank) {
+        auto it = std::lower_bound(ranks.begin(), ranks.end(), index,
+                                   [](const FactionRank& entry, std::uint32_t value) { return entry.index < value; });
+        if (it != ranks.end() && it->index == index) return;
+        ranks.insert(it, {index, rank});
+
+        size_t word = index / 64;
+        if (bits.size() <= word) bits.resize(word + 1, 0);
+        bits[word] |= std::uint64_t{1} << (index % 64);
+    }
+
+    bool Has(std::uint32_t index) const {
+        size_t word = index / 64;
+        return word < bits.size() && (bits[word] >> (index % 64)) & 1;
+    }
+
+    size_t size() const { return ranks.size(); }
+    bool empty() const { return ranks.empty(); }
+};
+
+inline bool FactionBitsIntersect(const FactionBitset& a, const FactionBitset& b) {
+    size_t words = std::min(a.size(), b.size());
+    for (size_t i = 0; i < words; ++i) {
+        if (a[i] & b[i]) return true;
+    }
+    return false;
+}
+
+inline void MergeFactionBits(FactionBitset& into, const FactionBitset& from) {
+    if (into.size() < from.size()) into.resize(from.size(), 0);
+    for (size_t i = 0; i < from.size(); ++i) into[i] |= from[i];
+}
+
+struct FactionEntry {
+    std::uint32_t formID;
+    std::string editorID;
+    std::string name;
+};
+
+inline std::vector<std::string> SplitCSVLine(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+
+    return fields;
+}
+
+class FactionDictionary {
+public:
+    // Adds a row from the CSV or a synthetic entry; an editor ID already present keeps its index
+    std::uint32_t Add(std::uint32_t formID, std::string_view editorID, std::string_view name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return AddLocked(formID, editorID, name);
+    }
+
+    size_t SeedFromCSV(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) return 0;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t before = entries.size();
+        std::string line;
+        bool first = true;
+
+        while (std::getline(file, line)) {
+            if (first && line.starts_with("\xEF\xBB\xBF")) line.erase(0, 3);
+            auto fields = SplitCSVLine(line);
+            bool header = first && fields[0] == "Faction_EDID";
+            first = false;
+            if (header || fields[0].empty()) continue;
+
+            AddLocked(0, fields[0], fields.size() > 1 ? fields[1] : "");
+        }
+
+        return entries.size() - before;
+    }
+
+    // Index of a loaded faction: binds the CSV row with its editor ID the first time it is seen,
+    // or appends an entry when the editor ID is unknown, missing, or already bound to another form
+    std::uint32_t Intern(std::uint32_t formID, std::string_view editorID, std::string_view name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = byFormID.find(formID);
+        if (found != byFormID.end()) return found->second;
+
+        if (!editorID.empty()) {
+            auto it = byEditorID.find(editorID);
+            if (it != byEditorID.end() && entries[it->second].formID == 0) {
+                auto& entry = entries[it->second];
+                entry.formID = formID;
+                if (!name.empty()) entry.name = name;
+                byFormID.emplace(formID, it->second);
+                return it->second;
+            }
+        }
+
+        auto index = static_cast<std::uint32_t>(entries.size());
+        entries.push_back({formID, std::string(editorID), std::string(name)});
+        if (!editorID.empty()) byEditorID.emplace(std::string(editorID), index);
+        byFormID.emplace(formID, index);
+        return index;
+    }
+
+    // Bits of the listed editor IDs; names the dictionary does not know are skipped
+    FactionBitset MaskForEditorIDs(const std::vector<std::string>& editorIDs) {
+        std::lock_guard<std::mutex> lock(mutex);
+        FactionMembership mask;
+        for (const auto& editorID : editorIDs) {
+            auto it = byEditorID.find(editorID);
+            if (it != byEditorID.end()) mask.Add(it->second, 0);
+        }
+        return mask.bits;
+    }
+
+    // Copies out the entries whose bits are set, in index order
+    std::vector<std::pair<std::uint32_t, FactionEntry>> Collect(const FactionBitset& which) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::pair<std::uint32_t, FactionEntry>> result;
+
+        for (size_t word = 0; word < which.size(); ++word) {
+            std::uint64_t bits = which[word];
+            while (bits) {
+                auto index = static_cast<std::uint32_t>(word * 64 + std::countr_zero(bits));
+                bits &= bits - 1;
+                if (index < entries.size()) result.emplace_back(index, entries[index]);
+            }
+        }
+
+        return result;
+    }
+
+    size_t Size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+    size_t ResolvedCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return byFormID.size();
+    }
+
+private:
+    std::uint32_t AddLocked(std::uint32_t formID, std::string_view editorID, std::string_view name) {
+        if (!editorID.empty()) {
+            auto it = byEditorID.find(editorID);
+            if (it != byEditorID.end()) return it->second;
+        }
+
+        auto index = static_cast<std::uint32_t>(entries.size());
+        entries.push_back({formID, std::string(editorID), std::string(name)});
+        if (!editorID.empty()) byEditorID.emplace(std::string(editorID), index);
+        if (formID != 0) byFormID.emplace(formID, index);
+        return index;
+    }
+
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+
+    std::mutex mutex;
+    std::vector<FactionEntry> entries;
+    std::unordered_map<std::string, std::uint32_t, Hash, std::equal_to<>> byEditorID;
+    std::unordered_map<std::uint32_t, std::uint32_t> byFormID;
+};
@@ -0,0 +1,416 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cwctype>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#endif
+
+#include "AdvancedLog.h"
+#include "WorkerThread.h"
+
+// ===== FILE WATCHER =====
+// One thread waits on the OS for changes in the directories of watched files and runs a file's
+// handler once its writes have been quiet for the debounce window (an MCM save or an editor
+// arrives as several events). While nothing changes the thread stays blocked in the kernel; its
+// only timed waits are pending debounce deadlines.
+
+// A changed name inside a watched directory; an empty name means the directory reported an
+// overflow and any file in it may have changed
+struct DirectoryChange {
+    size_t directory;
+    std::filesystem::path fileName;
+};
+
+class DirectoryWatchBackend {
+public:
+    virtual ~DirectoryWatchBackend() = default;
+
+    // Directories are numbered in the order they were added successfully. Only the watcher
+    // thread adds directories and waits; Wake() may be called from any thread.
+    virtual bool AddDirectory(const std::filesystem::path& directory) = 0;
+
+    // Blocks until a change, Wake() or the timeout; false when the backend cannot continue
+    virtual bool Wait(std::optional<std::chrono::milliseconds> timeout, std::vector<DirectoryChange>& changes) = 0;
+
+    virtual void Wake() = 0;
+};
+
+#ifdef _WIN32
+class Win32DirectoryWatchBackend : public DirectoryWatchBackend {
+public:
+    Win32DirectoryWatchBackend() : wakeEvent(CreateEventW(nullptr, FALSE, FALSE, nullptr)) {}
+
+    ~Win32DirectoryWatchBackend() override {
+        for (auto& watch : watches) {
+            if (watch->armed) {
+                DWORD ignored = 0;
+                CancelIoEx(watch->handle, &watch->overlapped);
+                GetOverlappedResult(watch->handle, &watch->overlapped, &ignored, TRUE);
+            }
+            CloseHandle(watch->overlapped.hEvent);
+            CloseHandle(watch->handle);
+        }
+        if (wakeEvent) CloseHandle(wakeEvent);
+    }
+
+    bool AddDirectory(const std::filesystem::path& directory) override {
+        // The wake event takes one of the MAXIMUM_WAIT_OBJECTS slots
+        if (!wakeEvent || watches.size() + 1 >= MAXIMUM_WAIT_OBJECTS) return false;
+
+        HANDLE handle = CreateFileW(directory.c_str(), FILE_LIST_DIRECTORY,
+                                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                    FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (handle == INVALID_HANDLE_VALUE) return false;
+
+        auto watch = std::make_unique<Watch>();
+        watch->handle = handle;
+        watch->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!watch->overlapped.hEvent || !Arm(*watch)) {
+            if (watch->overlapped.hEvent) CloseHandle(watch->overlapped.hEvent);
+            CloseHandle(handle);
+            return false;
+        }
+        watches.push_back(std::move(watch));
+        return true;
+    }
+
+    bool Wait(std::optional<std::chrono::milliseconds> timeout, std::vector<DirectoryChange>& changes) override {
+        handles.assign(1, wakeEvent);
+        for (const auto& watch : watches) {
+            if (watch->armed) handles.push_back(watch->overlapped.hEvent);
+        }
+
+        DWORD waitMs = timeout ? static_cast<DWORD>(std::clamp<long long>(timeout->count(), 0, INFINITE - 1)) : INFINITE;
+        DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, waitMs);
+        if (result == WAIT_FAILED) return false;
+        if (result == WAIT_TIMEOUT || result == WAIT_OBJECT_0) return true;
+
+        // Only the lowest signalled handle is reported, so every completed read is collected
+        for (size_t i = 0; i < watches.size(); ++i) {
+            auto& watch = *watches[i];
+            if (!watch.armed || !HasOverlappedIoCompleted(&watch.overlapped)) continue;
+
+            DWORD bytes = 0;
+            if (!GetOverlappedResult(watch.handle, &watch.overlapped, &bytes, FALSE) || bytes == 0) {
+                changes.push_back({i, {}});
+            } else {
+                for (size_t offset = 0;;) {
+                    const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(watch.buffer + offset);
+                    changes.push_back({i, std::filesystem::path(std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)))});
+                    if (info->NextEntryOffset == 0) break;
+                    offset += info->NextEntryOffset;
+                }
+            }
+
+            // A directory that was removed cannot be re-armed and drops out of the wait
+            if (!Arm(watch)) {
+                WriteToAdvancedLogFrom("FileWatchService.h", "File watcher: directory watch lost, error " +
+                                       std::to_string(GetLastError()), __LINE__);
+            }
+        }
+        return true;
+    }
+
+    void Wake() override {
+        SetEvent(wakeEvent);
+    }
+
+private:
+    struct Watch {
+        HANDLE handle = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped{};
+        bool armed = false;
+        alignas(DWORD) std::byte buffer[16384];
+    };
+
+    static bool Arm(Watch& watch) {
+        ResetEvent(watch.overlapped.hEvent);
+        watch.armed = ReadDirectoryChangesW(watch.handle, watch.buffer, sizeof(watch.buffer), FALSE,
+                                            FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE |
+                                                FILE_NOTIFY_CHANGE_SIZE,
+                                            nullptr, &watch.overlapped, nullptr) != FALSE;
+        return watch.armed;
+    }
+
+    HANDLE wakeEvent;
+    std::vector<std::unique_ptr<Watch>> watches;
+    std::vector<HANDLE> handles;
+};
+#elif defined(__linux__)
+// Builds the watcher outside the game, for FileWatchBench and FileWatchServiceTest
+class InotifyDirectoryWatchBackend : public DirectoryWatchBackend {
+public:
+    InotifyDirectoryWatchBackend()
+        : inotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)), wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+
+    ~InotifyDirectoryWatchBackend() override {
+        if (inotifyFd >= 0) close(inotifyFd);
+        if (wakeFd >= 0) close(wakeFd);
+    }
+
+    bool AddDirectory(const std::filesystem::path& directory) override {
+        if (inotifyFd < 0 || wakeFd < 0) return false;
+        int descriptor = inotify_add_watch(inotifyFd, directory.c_str(),
+                                           IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_DELETE);
+        if (descriptor < 0) return false;
+        descriptors.push_back(descriptor);
+        return true;
+    }
+
+    bool Wait(std::optional<std::chrono::milliseconds> timeout, std::vector<DirectoryChange>& changes) override {
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        int waitMs = timeout ? static_cast<int>(std::clamp<long long>(timeout->count(), 0, INT_MAX)) : -1;
+        if (poll(fds, 2, waitMs) < 0) return errno == EINTR;
+
+        if (fds[1].revents & POLLIN) {
+            std::uint64_t count = 0;
+            [[maybe_unused]] auto ignored = read(wakeFd, &count, sizeof(count));
+        }
+
+        if (fds[0].revents & POLLIN) {
+            alignas(inotify_event) char buffer[16384];
+            ssize_t length = 0;
+            while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+                for (ssize_t offset = 0; offset < length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    offset += sizeof(inotify_event) + event->len;
+
+                    if (event->mask & IN_Q_OVERFLOW) {
+                        for (size_t i = 0; i < descriptors.size(); ++i) changes.push_back({i, {}});
+                        continue;
+                    }
+                    auto it = std::find(descriptors.begin(), descriptors.end(), event->wd);
+                    if (it == descriptors.end()) continue;
+                    changes.push_back({static_cast<size_t>(it - descriptors.begin()),
+                                       event->len ? std::filesystem::path(event->name) : std::filesystem::path()});
+                }
+            }
+        }
+        return true;
+    }
+
+    void Wake() override {
+        std::uint64_t one = 1;
+        [[maybe_unused]] auto ignored = write(wakeFd, &one, sizeof(one));
+    }
+
+private:
+    int inotifyFd;
+    int wakeFd;
+    std::vector<int> descriptors;
+};
+#endif
+
+inline std::unique_ptr<DirectoryWatchBackend> CreateDirectoryWatchBackend() {
+#ifdef _WIN32
+    return std::make_unique<Win32DirectoryWatchBackend>();
+#elif defined(__linux__)
+    return std::make_unique<InotifyDirectoryWatchBackend>();
+#else
+    return nullptr;
+#endif
+}
+
+constexpr std::chrono::milliseconds kFileWatchDebounce(50);
+
+class FileWatchService {
+public:
+    using Handler = std::function<void()>;
+
+    ~FileWatchService() {
+        Stop();
+    }
+
+    // Starts the watcher thread on first use. The file's directory must exist; the file itself
+    // may be created later. Handlers run on the watcher thread, one at a time.
+    void Watch(const std::filesystem::path& file, std::chrono::milliseconds debounce, Handler handler) {
+        std::lock_guard<std::mutex> lock(mutex);
+        files.push_back({file.lexically_normal(), debounce, std::move(handler)});
+
+        if (!thread.Running()) {
+            backend = CreateDirectoryWatchBackend();
+            if (!backend) {
+                WriteToAdvancedLogFrom("FileWatchService.h", "File watcher: no backend on this platform", __LINE__);
+                return;
+            }
+            thread.Start("file watcher", [this](std::stop_token stop) { Run(stop); });
+        }
+        backend->Wake();
+    }
+
+    // A handler that is already running finishes; no new calls are made for the file
+    void Unwatch(const std::filesystem::path& file) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto normal = file.lexically_normal();
+        std::erase_if(files, [&normal](const WatchedFile& watched) { return SameName(watched.path, normal); });
+    }
+
+    // A watcher that misses the join timeout is detached. Its backend is leaked on purpose and
+    // logged, since the detached thread may not have returned from Wait() yet.
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!thread.Running()) return;
+        }
+        const bool joined = thread.Join(kWorkerJoinTimeout);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!joined) {
+            WriteToAdvancedLogFrom("FileWatchService.h", "WARNING: File watcher did not stop within " +
+                                   std::to_string(kWorkerJoinTimeout.count()) +
+                                   " ms, its backend is left open for the detached thread", __LINE__);
+            static_cast<void>(backend.release());
+        }
+        backend.reset();
+        directories.clear();
+        for (auto& file : files) {
+            file.directory = kNoDirectory;
+            file.due.reset();
+        }
+    }
+
+    // Times the watcher thread returned from the OS wait, changes or not
+    size_t Wakeups() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return wakeups;
+    }
+
+private:
+    static constexpr size_t kNoDirectory = static_cast<size_t>(-1);
+    static constexpr size_t kUnwatchable = kNoDirectory - 1;
+
+    struct WatchedFile {
+        std::filesystem::path path;
+        std::chrono::milliseconds debounce;
+        Handler handler;
+        size_t directory = kNoDirectory;
+        std::optional<std::chrono::steady_clock::time_point> due = std::nullopt;
+    };
+
+    // Windows paths compare case-insensitively
+    static bool SameName(const std::filesystem::path& a, const std::filesystem::path& b) {
+        const auto& x = a.native();
+        const auto& y = b.native();
+        return std::equal(x.begin(), x.end(), y.begin(), y.end(), [](auto c1, auto c2) {
+            return std::towlower(static_cast<wint_t>(c1)) == std::towlower(static_cast<wint_t>(c2));
+        });
+    }
+
+    // Called with the mutex held, on the watcher thread
+    void AddNewDirectories() {
+        for (auto& file : files) {
+            if (file.directory != kNoDirectory) continue;
+
+            auto directory = file.path.parent_path();
+            auto it = std::find_if(directories.begin(), directories.end(),
+                                   [&directory](const std::filesystem::path& known) { return SameName(known, directory); });
+            if (it != directories.end()) {
+                file.directory = static_cast<size_t>(it - directories.begin());
+            } else if (backend->AddDirectory(directory)) {
+                file.directory = directories.size();
+                directories.push_back(directory);
+            } else {
+                WriteToAdvancedLogFrom("FileWatchService.h", "File watcher: cannot watch " + directory.string() + ", " +
+                                       file.path.filename().string() + " changes will be missed", __LINE__);
+                file.directory = kUnwatchable;
+            }
+        }
+    }
+
+    std::optional<std::chrono::milliseconds> NextTimeout(std::chrono::steady_clock::time_point now) const {
+        std::optional<std::chrono::steady_clock::time_point> next;
+        for (const auto& file : files) {
+            if (file.due && (!next || *file.due < *next)) next = file.due;
+        }
+        if (!next) return std::nullopt;
+        return std::max(std::chrono::milliseconds(0), std::chrono::ceil<std::chrono::milliseconds>(*next - now));
+    }
+
+    void Run(std::stop_token stop) {
+        WriteToAdvancedLogFrom("FileWatchService.h", "File watcher thread started", __LINE__);
+
+        // The backend outlives the thread, so waking it from the stopping thread is safe
+        std::stop_callback wake(stop, [this] { backend->Wake(); });
+        std::vector<DirectoryChange> changes;
+        std::vector<Handler> ready;
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (!stop.stop_requested()) {
+            AddNewDirectories();
+            auto timeout = NextTimeout(std::chrono::steady_clock::now());
+
+            lock.unlock();
+            changes.clear();
+            bool ok = backend->Wait(timeout, changes);
+            lock.lock();
+
+            wakeups++;
+            if (!ok) {
+                WriteToAdvancedLogFrom("FileWatchService.h", "ERROR: File watcher wait failed, watching stopped", __LINE__);
+                break;
+            }
+
+            // Every event restarts the file's quiet period
+            auto now = std::chrono::steady_clock::now();
+            for (const auto& change : changes) {
+                for (auto& file : files) {
+                    if (file.directory != change.directory) continue;
+                    if (change.fileName.empty() || SameName(change.fileName, file.path.filename())) {
+                        file.due = now + file.debounce;
+                    }
+                }
+            }
+
+            ready.clear();
+            for (auto& file : files) {
+                if (file.due && *file.due <= now) {
+                    file.due.reset();
+                    ready.push_back(file.handler);
+                }
+            }
+            if (ready.empty()) continue;
+
+            lock.unlock();
+            for (const auto& handler : ready) {
+                try {
+                    handler();
+                } catch (const std::exception& e) {
+                    WriteToAdvancedLogFrom("FileWatchService.h", "ERROR in file watch handler: " + std::string(e.what()),
+                                           __LINE__);
+                } catch (...) {
+                    WriteToAdvancedLogFrom("FileWatchService.h", "UNKNOWN ERROR in file watch handler", __LINE__);
+                }
+            }
+            lock.lock();
+        }
+
+        WriteToAdvancedLogFrom("FileWatchService.h", "File watcher thread stopped", __LINE__);
+    }
+
+    std::mutex mutex;
+    std::unique_ptr<DirectoryWatchBackend> backend;
+    WorkerThread thread;
+    std::vector<WatchedFile> files;
+    std::vector<std::filesystem::path> directories;
+    size_t wakeups = 0;
+};
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// ===== ARENA-BACKED FORM CATALOG =====
+// Scanned forms are stored column-wise (FormID, plugin ID, name offset, type) in one
+// monotonic arena owned by the catalog. The catalog travels from scan to export by
+// unique_ptr and its arena is handed back in a single release when it is destroyed.
+
+enum class CatalogFormType : std::uint8_t {
+    kArmor = 0,
+    kOutfit = 1,
+    kWeapon = 2,
+    kNPC = 3
+};
+
+constexpr size_t kCatalogFormTypeCount = 4;
+
+class CountingMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit CountingMemoryResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstreamResource(upstream) {}
+
+    size_t Allocations() const { return allocations; }
+    size_t BytesInUse() const { return bytesInUse; }
+    size_t PeakBytes() const { return peakBytes; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* memory = upstreamResource->allocate(bytes, alignment);
+        allocations++;
+        bytesInUse += bytes;
+        peakBytes = std::max(peakBytes, bytesInUse);
+        return memory;
+    }
+
+    void do_deallocate(void* memory, size_t bytes, size_t alignment) override {
+        upstreamResource->deallocate(memory, bytes, alignment);
+        bytesInUse -= bytes;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* upstreamResource;
+    size_t allocations = 0;
+    size_t bytesInUse = 0;
+    size_t peakBytes = 0;
+};
+
+class FormCatalog {
+public:
+    static constexpr std::uint16_t kNoPlugin = 0xFFFF;
+
+    // Rows of the catalog grouped by plugin, then by type, in scan order within a group.
+    // Allocated from the catalog's arena, so it must not outlive the catalog.
+    struct Grouping {
+        std::pmr::vector<std::uint32_t> rows;
+        std::pmr::vector<std::uint32_t> groupStarts;
+
+        std::uint32_t Begin(std::uint16_t pluginID, CatalogFormType type) const {
+            return groupStarts[pluginID * kCatalogFormTypeCount + static_cast<size_t>(type)];
+        }
+        std::uint32_t End(std::uint16_t pluginID, CatalogFormType type) const {
+            return groupStarts[pluginID * kCatalogFormTypeCount + static_cast<size_t>(type) + 1];
+        }
+    };
+
+    FormCatalog()
+        : arena(64 * 1024, &upstreamCounter),
+          pluginNames(&arena),
+          pluginLookup(&arena),
+          formIDs(&arena),
+          pluginIDs(&arena),
+          nameOffsets(&arena),
+          types(&arena),
+          itemEnds(&arena),
+          itemFormIDs(&arena),
+          itemNameOffsets(&arena),
+          names(&arena) {}
+
+    FormCatalog(const FormCatalog&) = delete;
+    FormCatalog(FormCatalog&&) = delete;
+    FormCatalog& operator=(const FormCatalog&) = delete;
+    FormCatalog& operator=(FormCatalog&&) = delete;
+
+    // Sizing the columns up front keeps the monotonic arena from holding dead copies
+    void Reserve(size_t rows, size_t items, size_t nameBytes) {
+        formIDs.reserve(rows);
+        pluginIDs.reserve(rows);
+        nameOffsets.reserve(rows);
+        types.reserve(rows);
+        itemEnds.reserve(rows);
+        itemFormIDs.reserve(items);
+        itemNameOffsets.reserve(items);
+        names.reserve(nameBytes);
+    }
+
+    std::uint16_t InternPlugin(std::string_view pluginName) {
+        std::pmr::string key(pluginName, &arena);
+        auto it = pluginLookup.find(key);
+        if (it != pluginLookup.end()) return it->second;
+
+        auto pluginID = static_cast<std::uint16_t>(pluginNames.size());
+        pluginNames.push_back(key);
+        pluginLookup.emplace(std::move(key), pluginID);
+        return pluginID;
+    }
+
+    size_t AddForm(std::uint32_t formID, std::uint16_t pluginID, CatalogFormType type, std::string_view name) {
+        formIDs.push_back(formID);
+        pluginIDs.push_back(pluginID);
+        nameOffsets.push_back(AppendName(name));
+        types.push_back(type);
+        itemEnds.push_back(static_cast<std::uint32_t>(itemFormIDs.size()));
+        return formIDs.size() - 1;
+    }
+
+    // Outfit items belong to the most recently added row
+    void AddOutfitItem(std::uint32_t itemFormID, std::string_view itemName) {
+        itemFormIDs.push_back(itemFormID);
+        itemNameOffsets.push_back(AppendName(itemName));
+        if (!itemEnds.empty()) {
+            itemEnds.back() = static_cast<std::uint32_t>(itemFormIDs.size());
+        }
+    }
+
+    size_t Size() const { return formIDs.size(); }
+    size_t PluginCount() const { return pluginNames.size(); }
+    size_t ItemCount() const { return itemFormIDs.size(); }
+
+    std::uint32_t GetFormID(size_t row) const { return formIDs[row]; }
+    std::uint16_t GetPluginID(size_t row) const { return pluginIDs[row]; }
+    CatalogFormType GetType(size_t row) const { return types[row]; }
+    std::string_view GetName(size_t row) const { return names.data() + nameOffsets[row]; }
+    std::string_view GetPluginName(std::uint16_t pluginID) const { return pluginNames[pluginID]; }
+
+    size_t ItemBegin(size_t row) const { return row == 0 ? 0 : itemEnds[row - 1]; }
+    size_t ItemEnd(size_t row) const { return itemEnds[row]; }
+    std::uint32_t GetItemFormID(size_t item) const { return itemFormIDs[item]; }
+    std::string_view GetItemName(size_t item) const { return names.data() + itemNameOffsets[item]; }
+
+    size_t CountOfType(CatalogFormType type) const { return static_cast<size_t>(std::count(types.begin(), types.end(), type)); }
+
+    // Counting sort on (plugin, type): two linear passes, no comparisons
+    Grouping GroupByPluginAndType() {
+        Grouping grouping{std::pmr::vector<std::uint32_t>(&arena), std::pmr::vector<std::uint32_t>(&arena)};
+        grouping.groupStarts.assign(PluginCount() * kCatalogFormTypeCount + 1, 0);
+        grouping.rows.resize(Size());
+
+        for (size_t row = 0; row < Size(); ++row) {
+            grouping.groupStarts[GroupKey(row) + 1]++;
+        }
+        for (size_t i = 1; i < grouping.groupStarts.size(); ++i) {
+            grouping.groupStarts[i] += grouping.groupStarts[i - 1];
+        }
+
+        std::pmr::vector<std::uint32_t> cursor(grouping.groupStarts.begin(), grouping.groupStarts.end() - 1, &arena);
+        for (size_t row = 0; row < Size(); ++row) {
+            grouping.rows[cursor[GroupKey(row)]++] = static_cast<std::uint32_t>(row);
+        }
+        return grouping;
+    }
+
+    size_t UpstreamAllocations() const { return upstreamCounter.Allocations(); }
+    size_t PeakBytes() const { return upstreamCounter.PeakBytes(); }
+
+private:
+    std::uint32_t AppendName(std::string_view name) {
+        auto offset = static_cast<std::uint32_t>(names.size());
+        names.insert(names.end(), name.begin(), name.end());
+        names.push_back('\0');
+        return offset;
+    }
+
+    size_t GroupKey(size_t row) const {
+        return pluginIDs[row] * kCatalogFormTypeCount + static_cast<size_t>(types[row]);
+    }
+
+    // Declaration order matters: columns are destroyed before the arena, the arena before its counter
+    CountingMemoryResource upstreamCounter;
+    std::pmr::monotonic_buffer_resource arena;
+
+    std::pmr::vector<std::pmr::string> pluginNames;
+    std::pmr::unordered_map<std::pmr::string, std::uint16_t> pluginLookup;
+
+    std::pmr::vector<std::uint32_t> formIDs;
+    std::pmr::vector<std::uint16_t> pluginIDs;
+    std::pmr::vector<std::uint32_t> nameOffsets;
+    std::pmr::vector<CatalogFormType> types;
+    std::pmr::vector<std::uint32_t> itemEnds;
+
+    std::pmr::vector<std::uint32_t> itemFormIDs;
+    std::pmr::vector<std::uint32_t> itemNameOffsets;
+
+    std::pmr::vector<char> names;
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// ===== FRAME-BUDGETED MAIN THREAD SCHEDULER =====
+// Process lists, form arrays and inventories are only safe to read on the game's main
+// thread. Jobs are posted through a MainThreadQueue (SKSE's task interface in the plugin) and
+// advanced one step at a time until the per-frame budget is spent; the rest is re-posted for
+// the next frame.
+
+class MainThreadQueue {
+public:
+    virtual ~MainThreadQueue() = default;
+    virtual bool Post(std::function<void()> task) = 0;
+};
+
+// Stand-in for the game loop: posted tasks wait until PumpFrame() runs them, one call
+// per simulated frame, so slicing and budget behaviour can be checked outside the game.
+class ManualTaskQueue : public MainThreadQueue {
+public:
+    bool Post(std::function<void()> task) override {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pendingTasks.push_back(std::move(task));
+        return true;
+    }
+
+    size_t PumpFrame() {
+        std::deque<std::function<void()>> frameTasks;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            frameTasks.swap(pendingTasks);
+        }
+
+        for (auto& task : frameTasks) {
+            task();
+        }
+        return frameTasks.size();
+    }
+
+    size_t PendingCount() const {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return pendingTasks.size();
+    }
+
+private:
+    mutable std::mutex queueMutex;
+    std::deque<std::function<void()>> pendingTasks;
+};
+
+struct FrameJobStats {
+    int frames = 0;
+    size_t steps = 0;
+    double longestSliceMs = 0.0;
+    double totalMs = 0.0;
+};
+
+class FrameBudgetScheduler {
+public:
+    // A step does one small unit of work and returns true while work remains.
+    using Step = std::function<bool()>;
+
+    class Job {
+    public:
+        bool Wait(std::chrono::milliseconds timeout) {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            return doneCondition.wait_for(lock, timeout, [this] { return finished; });
+        }
+
+        // Blocks until any slice in flight has returned, so the step never runs after this.
+        void Cancel() {
+            std::lock_guard<std::mutex> sliceLock(sliceMutex);
+            std::lock_guard<std::mutex> lock(stateMutex);
+            cancelled = true;
+            finished = true;
+            doneCondition.notify_all();
+        }
+
+        bool Succeeded() const {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            return finished && !cancelled && error.empty();
+        }
+
+        std::string Error() const {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            return error;
+        }
+
+        FrameJobStats Stats() const {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            return stats;
+        }
+
+    private:
+        friend class FrameBudgetScheduler;
+
+        Step step;
+        std::mutex sliceMutex;
+        mutable std::mutex stateMutex;
+        std::condition_variable doneCondition;
+        bool finished = false;
+        bool cancelled = false;
+        std::string error;
+        FrameJobStats stats;
+    };
+
+    explicit FrameBudgetScheduler(MainThreadQueue& queue) : taskQueue(&queue) {}
+
+    void SetFrameBudget(std::chrono::microseconds budget) {
+        frameBudgetMicros = std::max<long long>(budget.count(), 1);
+    }
+
+    std::chrono::microseconds GetFrameBudget() const {
+        return std::chrono::microseconds(frameBudgetMicros.load());
+    }
+
+    std::shared_ptr<Job> Submit(Step step) {
+        auto job = std::make_shared<Job>();
+        job->step = std::move(step);
+
+        if (!taskQueue->Post([this, job] { RunSlice(job); })) {
+            Finish(*job, "task interface unavailable");
+        }
+        return job;
+    }
+
+private:
+    void RunSlice(const std::shared_ptr<Job>& job) {
+        bool moreWork = false;
+        std::string failure;
+        const auto budget = GetFrameBudget();
+        const auto sliceStart = std::chrono::steady_clock::now();
+
+        {
+            std::lock_guard<std::mutex> sliceLock(job->sliceMutex);
+            {
+                std::lock_guard<std::mutex> lock(job->stateMutex);
+                if (job->cancelled) return;
+            }
+
+            size_t steps = 0;
+            try {
+                // Always advance at least one step so a tiny budget cannot stall the job; after
+                // that a step only starts when the slowest one so far fits in what is left
+                auto slowestStep = std::chrono::steady_clock::duration::zero();
+                auto stepStart = sliceStart;
+                while (true) {
+                    moreWork = job->step();
+                    steps++;
+                    const auto now = std::chrono::steady_clock::now();
+                    slowestStep = std::max(slowestStep, now - stepStart);
+                    stepStart = now;
+                    if (!moreWork || now - sliceStart + slowestStep > budget) break;
+                }
+            } catch (const std::exception& e) {
+                failure = e.what();
+                moreWork = false;
+            } catch (...) {
+                failure = "unknown exception";
+                moreWork = false;
+            }
+
+            double sliceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sliceStart).count();
+
+            std::lock_guard<std::mutex> lock(job->stateMutex);
+            job->stats.frames++;
+            job->stats.steps += steps;
+            job->stats.totalMs += sliceMs;
+            job->stats.longestSliceMs = std::max(job->stats.longestSliceMs, sliceMs);
+        }
+
+        if (!moreWork) {
+            Finish(*job, failure);
+        } else if (!taskQueue->Post([this, job] { RunSlice(job); })) {
+            Finish(*job, "task interface unavailable");
+        }
+    }
+
+    static void Finish(Job& job, const std::string& failure) {
+        std::lock_guard<std::mutex> lock(job.stateMutex);
+        job.error = failure;
+        job.finished = true;
+        job.doneCondition.notify_all();
+    }
+
+    MainThreadQueue* taskQueue;
+    std::atomic<long long> frameBudgetMicros{500};
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ===== HEARTBEAT =====
+// server.pyw shuts itself down once the game stops beating. A beat used to be a full rewrite of the
+// last 20 lines of SkyrimSwitch.log; it is now a handful of stores into a fixed block that lives in
+// SkyrimSwitch.heartbeat, mapped into memory for the whole session (on Windows the mapping is also
+// published under kHeartbeatMappingName). Readers only need to watch the sequence counter move.
+
+enum class HeartbeatGameState : std::uint32_t {
+    kStarting = 0,
+    kMainMenu = 1,
+    kLoading = 2,
+    kInGame = 3
+};
+
+enum HeartbeatHealthFlag : std::uint32_t {
+    kHeartbeatIniMonitor = 1u << 0,
+    kHeartbeatNPCTracking = 1u << 1,
+    kHeartbeatPaused = 1u << 2
+};
+
+constexpr char kHeartbeatMagic[8] = {'O', 'B', 'P', 'D', 'A', 'H', 'B', '1'};
+constexpr std::uint32_t kHeartbeatVersion = 1;
+constexpr std::chrono::milliseconds kHeartbeatInterval(1000);
+#ifdef _WIN32
+constexpr const wchar_t* kHeartbeatMappingName = L"Local\\OBodyPDA_SkyrimSwitch";
+#endif
+
+// Layout shared with server.pyw (struct "<8sIIQqIIII"); new fields only ever go at the end.
+// sequence is odd while a beat is half written, so a reader that sees the same even value before
+// and after copying the block has a consistent snapshot.
+struct HeartbeatBlock {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t size;
+    std::uint64_t sequence;
+    std::int64_t unixTimeMs;
+    std::uint32_t gameState;
+    std::uint32_t health;
+    std::uint32_t processID;
+    std::uint32_t intervalMs;
+};
+static_assert(std::is_standard_layout_v<HeartbeatBlock> && sizeof(HeartbeatBlock) == 48);
+static_assert(offsetof(HeartbeatBlock, sequence) % std::atomic_ref<std::uint64_t>::required_alignment == 0);
+static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free && std::atomic_ref<std::int64_t>::is_always_lock_free);
+
+// The block is only written by whoever holds the region, one beat at a time (the scheduler task)
+class HeartbeatRegion {
+public:
+    HeartbeatRegion() = default;
+    ~HeartbeatRegion() { Close(); }
+
+    HeartbeatRegion(const HeartbeatRegion&) = delete;
+    HeartbeatRegion& operator=(const HeartbeatRegion&) = delete;
+
+    bool Open(const std::filesystem::path& path, std::chrono::milliseconds interval) {
+        Close();
+        if (!Map(path)) {
+            Close();
+            return false;
+        }
+
+        // Keep counting from whatever a previous session left behind so a reader that kept the
+        // file mapped sees the new session as movement
+        std::uint64_t sequence = std::memcmp(block->magic, kHeartbeatMagic, sizeof(kHeartbeatMagic)) == 0
+                                     ? (std::atomic_ref(block->sequence).load(std::memory_order_relaxed) + 2) & ~1ull
+                                     : 0;
+        std::atomic_ref(block->sequence).store(sequence | 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(block->magic, kHeartbeatMagic, sizeof(kHeartbeatMagic));
+        block->version = kHeartbeatVersion;
+        block->size = sizeof(HeartbeatBlock);
+        block->processID = CurrentProcessID();
+        block->intervalMs = static_cast<std::uint32_t>(interval.count());
+        std::atomic_ref(block->sequence).store(sequence, std::memory_order_release);
+        return true;
+    }
+
+    void Beat(HeartbeatGameState state, std::uint32_t health) {
+        if (!block) return;
+        const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+
+        std::atomic_ref sequence(block->sequence);
+        const std::uint64_t current = sequence.load(std::memory_order_relaxed);
+        sequence.store(current + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::atomic_ref(block->unixTimeMs).store(now.count(), std::memory_order_relaxed);
+        std::atomic_ref(block->gameState).store(static_cast<std::uint32_t>(state), std::memory_order_relaxed);
+        std::atomic_ref(block->health).store(health, std::memory_order_relaxed);
+        sequence.store(current + 2, std::memory_order_release);
+    }
+
+    void Close() {
+#ifdef _WIN32
+        if (block) UnmapViewOfFile(block);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#elif defined(__linux__)
+        if (block) munmap(block, sizeof(HeartbeatBlock));
+#endif
+        block = nullptr;
+    }
+
+    bool IsOpen() const { return block != nullptr; }
+
+    std::uint64_t Sequence() const {
+        return block ? std::atomic_ref(block->sequence).load(std::memory_order_acquire) : 0;
+    }
+
+private:
+#ifdef _WIN32
+    bool Map(const std::filesystem::path& path) {
+        file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                           nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        // Grows the file to the block size when it is new or was truncated
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, 0, sizeof(HeartbeatBlock), kHeartbeatMappingName);
+        if (!mapping) return false;
+        block = static_cast<HeartbeatBlock*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, sizeof(HeartbeatBlock)));
+        return block != nullptr;
+    }
+
+    static std::uint32_t CurrentProcessID() { return GetCurrentProcessId(); }
+
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#elif defined(__linux__)
+    bool Map(const std::filesystem::path& path) {
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) return false;
+        struct stat info{};
+        bool sized = fstat(fd, &info) == 0 &&
+                     (info.st_size >= static_cast<off_t>(sizeof(HeartbeatBlock)) ||
+                      ftruncate(fd, sizeof(HeartbeatBlock)) == 0);
+        void* view = sized ? mmap(nullptr, sizeof(HeartbeatBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+        close(fd);
+        if (view == MAP_FAILED) return false;
+        block = static_cast<HeartbeatBlock*>(view);
+        return true;
+    }
+
+    static std::uint32_t CurrentProcessID() { return static_cast<std::uint32_t>(getpid()); }
+#else
+    bool Map(const std::filesystem::path&) { return false; }
+    static std::uint32_t CurrentProcessID() { return 0; }
+#endif
+
+    HeartbeatBlock* block = nullptr;
+};
@@ -0,0 +1,614 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "AdvancedLog.h"
+
+// ===== INI PARSER =====
+// Every config reader goes through IniDocument: the file is read in one go and tokenized into
+// string_views over that buffer, with no per-line copies. Section and key names are hashed
+// case-insensitively while parsing, so readers can switch on IniHash("key") constants.
+// Lines are "[Section]" (no '=' inside), "key = value", or comments starting with ';' or '#'.
+// Writers edit the same buffer: Set() splices only the value text, so comments, unknown keys,
+// spacing and line endings survive, and Save() replaces the file through a rename.
+// Watched files are compared by full-resolution write time and size first and by a hash of their
+// bytes second, so only edits that really change the text reach a reload (see ContentChanged()).
+
+// A reader holding the target open without FILE_SHARE_DELETE (an editor saving, an antivirus
+// scan) makes the rename fail for a moment; Save() retries before writing in place
+constexpr int kIniSaveRenameAttempts = 5;
+constexpr std::chrono::milliseconds kIniSaveRenameRetryDelay(20);
+
+// Eight bytes per round; 'A'-'Z' are folded to lower case with a SWAR mask, other bytes untouched
+constexpr std::uint64_t IniLowerWord(std::uint64_t word) {
+    constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+    const std::uint64_t low7 = word & (0x7F * kOnes);
+    const std::uint64_t atLeastA = low7 + (0x80 - 'A') * kOnes;
+    const std::uint64_t aboveZ = low7 + (0x80 - 'Z' - 1) * kOnes;
+    const std::uint64_t upper = atLeastA & ~aboveZ & ~word & (0x80 * kOnes);
+    return word | (upper >> 2);
+}
+
+constexpr std::uint64_t IniHash(std::string_view text) {
+    std::uint64_t hash = 0xCBF29CE484222325ull ^ text.size();
+    for (size_t i = 0; i < text.size(); i += 8) {
+        std::uint64_t word = 0;
+        for (size_t b = 0; b < 8 && i + b < text.size(); ++b) {
+            word |= static_cast<std::uint64_t>(static_cast<unsigned char>(text[i + b])) << (8 * b);
+        }
+        hash = (hash ^ IniLowerWord(word)) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+// Byte-exact, unlike IniHash, so a change of case still counts as a change
+constexpr std::uint64_t ContentHash(std::string_view text) {
+    std::uint64_t hash = 0xCBF29CE484222325ull ^ text.size();
+    for (size_t i = 0; i < text.size(); i += 8) {
+        std::uint64_t word = 0;
+        for (size_t b = 0; b < 8 && i + b < text.size(); ++b) {
+            word |= static_cast<std::uint64_t>(static_cast<unsigned char>(text[i + b])) << (8 * b);
+        }
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+struct FileFingerprint {
+    std::filesystem::file_time_type writeTime{};
+    std::uintmax_t size = 0;
+    std::uint64_t contentHash = 0;
+};
+
+class IniDocument {
+public:
+    struct Entry {
+        std::string_view key;
+        std::string_view value;
+        std::uint64_t keyHash;
+    };
+    
+    struct Section {
+        std::string_view name;
+        std::uint64_t nameHash;
+        size_t firstEntry;
+        size_t entryCount;
+    };
+    
+    enum class EditResult {
+        kUnchanged,
+        kChanged,
+        kInserted
+    };
+    
+    // Entries are views into the buffer, so documents are neither copied nor moved
+    IniDocument() = default;
+    IniDocument(const IniDocument&) = delete;
+    IniDocument& operator=(const IniDocument&) = delete;
+    
+    // False when the file cannot be opened; the document is then empty
+    bool Load(const std::filesystem::path& path) {
+        std::string content;
+        const bool read = ReadAll(path, content);
+        loadedHash = ContentHash(content);
+        Parse(std::move(content));
+        return read;
+    }
+    
+    void Parse(std::string content) {
+        text = std::move(content);
+        modified = false;
+        sections.clear();
+        entries.clear();
+        sections.push_back({{}, IniHash({}), 0, 0});
+        
+        std::string_view rest(text);
+        if (rest.starts_with("\xEF\xBB\xBF")) rest.remove_prefix(3);
+        
+        while (!rest.empty()) {
+            size_t lineEnd = rest.find('\n');
+            std::string_view line = Trim(rest.substr(0, lineEnd));
+            rest.remove_prefix(lineEnd == std::string_view::npos ? rest.size() : lineEnd + 1);
+            
+            if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+            
+            size_t equalPos = line.find('=');
+            if (line.front() == '[' && line.back() == ']' && equalPos == std::string_view::npos) {
+                std::string_view name = Trim(line.substr(1, line.size() - 2));
+                sections.push_back({name, IniHash(name), entries.size(), 0});
+                continue;
+            }
+            if (equalPos == std::string_view::npos) continue;
+            
+            std::string_view key = Trim(line.substr(0, equalPos));
+            entries.push_back({key, Trim(line.substr(equalPos + 1)), IniHash(key)});
+            sections.back().entryCount++;
+        }
+    }
+    
+    // Sections in file order; index 0 holds keys that appear before the first header
+    const std::vector<Section>& Sections() const { return sections; }
+    
+    template <class Fn>
+    void ForEachEntry(const Section& section, Fn&& visit) const {
+        for (size_t i = 0; i < section.entryCount; ++i) visit(entries[section.firstEntry + i]);
+    }
+    
+    // Every entry of every section with this name, in file order, so later keys win when assigned
+    template <class Fn>
+    void ForEachEntry(std::string_view sectionName, Fn&& visit) const {
+        const std::uint64_t nameHash = IniHash(sectionName);
+        for (const auto& section : sections) {
+            if (section.nameHash == nameHash) ForEachEntry(section, visit);
+        }
+    }
+    
+    template <class Fn>
+    void ForEachEntry(Fn&& visit) const {
+        for (const auto& entry : entries) visit(entry);
+    }
+    
+    // First value for section/key
+    std::optional<std::string_view> Get(std::string_view sectionName, std::string_view key) const {
+        const std::uint64_t nameHash = IniHash(sectionName);
+        const std::uint64_t keyHash = IniHash(key);
+        for (const auto& section : sections) {
+            if (section.nameHash != nameHash) continue;
+            for (size_t i = 0; i < section.entryCount; ++i) {
+                const auto& entry = entries[section.firstEntry + i];
+                if (entry.keyHash == keyHash) return entry.value;
+            }
+        }
+        return std::nullopt;
+    }
+    
+    size_t EntryCount() const { return entries.size(); }
+    
+    // Rewrites the value of every section/key match in place. A missing key is added after the
+    // last entry of the section, and a missing section is appended to the end of the file.
+    EditResult Set(std::string_view sectionName, std::string_view key, std::string_view value) {
+        const std::uint64_t nameHash = IniHash(sectionName);
+        const std::uint64_t keyHash = IniHash(key);
+        const Section* lastSection = nullptr;
+        std::vector<const Entry*> matches;
+        for (const auto& section : sections) {
+            if (section.nameHash != nameHash) continue;
+            lastSection = &section;
+            for (size_t i = 0; i < section.entryCount; ++i) {
+                const auto& entry = entries[section.firstEntry + i];
+                if (entry.keyHash == keyHash) matches.push_back(&entry);
+            }
+        }
+        
+        std::string edited = text;
+        EditResult result = EditResult::kChanged;
+        if (!matches.empty()) {
+            // Back to front, so earlier offsets stay valid
+            bool changed = false;
+            for (auto it = matches.rbegin(); it != matches.rend(); ++it) {
+                const std::string_view current = (*it)->value;
+                if (current == value) continue;
+                const size_t offset = Offset(current);
+                const bool pad = current.empty() && offset > 0 && edited[offset - 1] == '=';
+                std::string replacement(pad ? " " : "");
+                replacement += value;
+                edited.replace(offset, current.size(), replacement);
+                changed = true;
+            }
+            if (!changed) return EditResult::kUnchanged;
+        } else {
+            const std::string newline = text.find("\r\n") != std::string::npos ? "\r\n" : "\n";
+            std::string line = std::string(key) + " = " + std::string(value) + newline;
+            result = EditResult::kInserted;
+            
+            if (lastSection && (lastSection->entryCount > 0 || !lastSection->name.empty())) {
+                const std::string_view anchor = lastSection->entryCount > 0
+                    ? entries[lastSection->firstEntry + lastSection->entryCount - 1].value
+                    : lastSection->name;
+                const size_t lineEnd = edited.find('\n', Offset(anchor) + anchor.size());
+                if (lineEnd == std::string::npos) {
+                    edited += newline + line;
+                } else {
+                    edited.insert(lineEnd + 1, line);
+                }
+            } else if (lastSection) {
+                edited.insert(edited.starts_with("\xEF\xBB\xBF") ? 3 : 0, line);
+            } else {
+                if (!edited.empty() && !edited.ends_with('\n')) edited += newline;
+                if (!edited.empty() && !edited.ends_with(newline + newline)) edited += newline;
+                edited += "[" + std::string(sectionName) + "]" + newline + line;
+            }
+        }
+        
+        Parse(std::move(edited));
+        modified = true;
+        return result;
+    }
+    
+    // True once Set() has changed the text since the last Load, Parse or Save
+    bool Modified() const { return modified; }
+    
+    const std::string& Text() const { return text; }
+    
+    // Writes a temporary file next to the target and renames it over the target, so readers see
+    // either the old or the new file. When the rename keeps failing the text is written over the
+    // target in place instead, which a reader may catch half written but which does not lose the
+    // edit. A watched file saved on top of content its watcher has already handled is marked as
+    // handled too, so the plugin's own writes do not reload it.
+    bool Save(const std::filesystem::path& path) {
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        if (!WriteText(temporary)) {
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+            WriteToAdvancedLogFrom("IniDocument.h", "ERROR: Could not write " + temporary.filename().string(), __LINE__);
+            return false;
+        }
+        
+        // Taken before the rename, which keeps it: a stat of the target afterwards could already
+        // see somebody else's write
+        std::error_code ec;
+        FileFingerprint saved{std::filesystem::last_write_time(temporary, ec), text.size(), ContentHash(text)};
+        bool timed = !ec;
+        for (int attempt = 1; attempt <= kIniSaveRenameAttempts; ++attempt) {
+            std::filesystem::rename(temporary, path, ec);
+            if (!ec || attempt == kIniSaveRenameAttempts) break;
+            std::this_thread::sleep_for(kIniSaveRenameRetryDelay);
+        }
+        if (ec) {
+            WriteToAdvancedLogFrom("IniDocument.h", "WARNING: Could not replace " + path.filename().string() + " (" +
+                                   ec.message() + ") after " + std::to_string(kIniSaveRenameAttempts) +
+                                   " attempts, writing it in place", __LINE__);
+            std::error_code removeError;
+            std::filesystem::remove(temporary, removeError);
+            if (!WriteText(path)) {
+                WriteToAdvancedLogFrom("IniDocument.h", "ERROR: Could not write " + path.filename().string() +
+                                       " in place, changes not saved", __LINE__);
+                return false;
+            }
+            saved.writeTime = std::filesystem::last_write_time(path, ec);
+            timed = !ec;
+        }
+        
+        if (timed) {
+            auto& journal = WriteJournal();
+            std::lock_guard<std::mutex> lock(journal.mutex);
+            auto it = journal.handled.find(path.lexically_normal().native());
+            // Edits made on top of text the watcher has not seen yet still have to reach it
+            if (it != journal.handled.end() && it->second.contentHash == loadedHash) it->second = saved;
+        }
+        loadedHash = saved.contentHash;
+        modified = false;
+        return true;
+    }
+    
+    // Watchers call this when they start, so the text already on disk is not taken for a change
+    static void AcknowledgeContent(const std::filesystem::path& path) {
+        ContentChanged(path);
+    }
+    
+    // File watchers call this before reloading: true when the file holds text that neither an
+    // earlier call nor this plugin's own Save has accounted for. Repeated events for one edit,
+    // rewrites with the same bytes and the plugin's own saves all come back false. The file is
+    // only read when its write time or size moved.
+    static bool ContentChanged(const std::filesystem::path& path) {
+        std::error_code ec;
+        const auto writeTime = std::filesystem::last_write_time(path, ec);
+        if (ec) return false;
+        const auto size = std::filesystem::file_size(path, ec);
+        if (ec) return false;
+        
+        const auto key = path.lexically_normal().native();
+        auto& journal = WriteJournal();
+        {
+            std::lock_guard<std::mutex> lock(journal.mutex);
+            auto it = journal.handled.find(key);
+            if (it != journal.handled.end() && it->second.writeTime == writeTime && it->second.size == size) return false;
+        }
+        
+        std::string content;
+        if (!ReadAll(path, content)) return false;
+        const FileFingerprint current{writeTime, size, ContentHash(content)};
+        
+        std::lock_guard<std::mutex> lock(journal.mutex);
+        auto [it, inserted] = journal.handled.try_emplace(key, current);
+        if (inserted) return true;
+        const bool changed = it->second.contentHash != current.contentHash;
+        it->second = current;
+        return changed;
+    }
+    
+    static bool ToBool(std::string_view value) {
+        return EqualsNoCase(value, "true") || value == "1" || EqualsNoCase(value, "yes");
+    }
+    
+    // Leading number of the value like std::stoi; fallback when there is none
+    static int ToInt(std::string_view value, int fallback) {
+        if (value.starts_with('+')) value.remove_prefix(1);
+        int result = 0;
+        auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+        return ec == std::errc() ? result : fallback;
+    }
+    
+    static double ToDouble(std::string_view value, double fallback) {
+        if (value.starts_with('+')) value.remove_prefix(1);
+        double result = 0.0;
+        auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+        return ec == std::errc() ? result : fallback;
+    }
+    
+    static float ToFloat(std::string_view value, float fallback) {
+        return static_cast<float>(ToDouble(value, fallback));
+    }
+    
+    static std::string ToLower(std::string_view value) {
+        std::string lower(value);
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return lower;
+    }
+    
+    static std::string_view Trim(std::string_view view) {
+        auto blank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+        size_t first = 0;
+        size_t last = view.size();
+        while (first < last && blank(view[first])) ++first;
+        while (last > first && blank(view[last - 1])) --last;
+        return view.substr(first, last - first);
+    }
+    
+    static bool EqualsNoCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) return false;
+        }
+        return true;
+    }
+    
+private:
+    // Per watched file, the last text the plugin has acted on
+    struct Journal {
+        std::mutex mutex;
+        std::unordered_map<std::filesystem::path::string_type, FileFingerprint> handled;
+    };
+    
+    static Journal& WriteJournal() {
+        static Journal journal;
+        return journal;
+    }
+    
+    bool WriteText(const std::filesystem::path& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        file.flush();
+        return static_cast<bool>(file);
+    }
+    
+    static bool ReadAll(const std::filesystem::path& path, std::string& content) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+        
+        content.assign(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        file.read(content.data(), static_cast<std::streamsize>(content.size()));
+        content.resize(static_cast<size_t>(file.gcount()));
+        return true;
+    }
+    
+    size_t Offset(std::string_view view) const { return static_cast<size_t>(view.data() - text.data()); }
+    
+    std::string text;
+    std::vector<Section> sections;
+    std::vector<Entry> entries;
+    std::uint64_t loadedHash = ContentHash({});
+    bool modified = false;
+};
+
+// ===== CONFIG SCHEMA =====
+// Each config file is described once by a constexpr table of IniField rows: section, key,
+// target variable (its pointer type is the value type), default and limits. IniSchema picks a
+// multiplier at compile time that sends every section/key hash to its own slot, so applying an
+// entry costs one multiply, one shift and one compare. The same rows write default files and
+// store the current values into an existing document.
+
+using IniTarget = std::variant<bool*, int*, float*, double*, std::string*>;
+
+struct IniField {
+    std::string_view section;
+    std::string_view key;
+    IniTarget target;
+    std::string_view defaultValue;
+    double minValue = std::numeric_limits<double>::lowest();
+    double maxValue = std::numeric_limits<double>::max();
+    std::string_view choices = {};  // "a|b|c" for strings; anything else falls back to the default
+    bool lowerCase = false;
+};
+
+constexpr std::uint64_t IniFieldHash(std::uint64_t sectionHash, std::uint64_t keyHash) {
+    return (sectionHash * 0x9E3779B97F4A7C15ull) ^ keyHash;
+}
+
+inline bool IniChoiceAllowed(std::string_view choices, std::string_view value) {
+    while (!choices.empty()) {
+        size_t bar = choices.find('|');
+        if (IniDocument::EqualsNoCase(choices.substr(0, bar), value)) return true;
+        choices.remove_prefix(bar == std::string_view::npos ? choices.size() : bar + 1);
+    }
+    return false;
+}
+
+// Converts and stores one value; unparsable numbers and unknown choices take the default
+inline void AssignIniField(const IniField& field, std::string_view value, std::string_view fileName) {
+    auto reject = [&]() {
+        if (fileName.empty() || value.empty()) return;
+        WriteToAdvancedLogFrom("IniDocument.h", std::string(fileName) + " [" + std::string(field.section) + "] " +
+                               std::string(field.key) + ": invalid value '" + std::string(value) + "', using " +
+                               std::string(field.defaultValue), __LINE__);
+    };
+    
+    if (auto* target = std::get_if<bool*>(&field.target)) {
+        **target = IniDocument::ToBool(value);
+        return;
+    }
+    
+    if (auto* target = std::get_if<std::string*>(&field.target)) {
+        std::string text = field.lowerCase ? IniDocument::ToLower(value) : std::string(value);
+        if (!field.choices.empty() && !IniChoiceAllowed(field.choices, text)) {
+            reject();
+            text = field.defaultValue;
+        }
+        **target = std::move(text);
+        return;
+    }
+    
+    double number = IniDocument::ToDouble(value, std::numeric_limits<double>::quiet_NaN());
+    if (std::isnan(number)) {
+        reject();
+        number = IniDocument::ToDouble(field.defaultValue, 0.0);
+    }
+    number = std::clamp(number, field.minValue, field.maxValue);
+    
+    if (auto* target = std::get_if<int*>(&field.target)) {
+        number = std::clamp(number, double(std::numeric_limits<int>::min()), double(std::numeric_limits<int>::max()));
+        **target = static_cast<int>(number);
+    } else if (auto* target = std::get_if<float*>(&field.target)) {
+        **target = static_cast<float>(number);
+    } else if (auto* target = std::get_if<double*>(&field.target)) {
+        **target = number;
+    }
+}
+
+inline void WriteIniValue(std::ostream& out, const IniTarget& target) {
+    std::visit([&out](auto* value) {
+        if constexpr (std::is_same_v<decltype(value), bool*>) {
+            out << (*value ? "true" : "false");
+        } else {
+            out << *value;
+        }
+    }, target);
+}
+
+inline std::string FormatIniValue(const IniTarget& target) {
+    std::ostringstream out;
+    WriteIniValue(out, target);
+    return out.str();
+}
+
+template <size_t N>
+class IniSchema {
+public:
+    static_assert(N > 0 && N < 255, "IniSchema holds 1-254 fields");
+    
+    // Fails to compile when two rows share a section/key, since no multiplier can separate them
+    constexpr explicit IniSchema(const std::array<IniField, N>& schemaFields) : fields(schemaFields) {
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = IniFieldHash(IniHash(fields[i].section), IniHash(fields[i].key));
+        }
+        for (multiplier = kFirstMultiplier; !TryPlace(); multiplier += 2) {
+            if (multiplier > kFirstMultiplier + 2 * kMaxAttempts) {
+                throw std::logic_error("IniSchema: duplicate section/key");
+            }
+        }
+    }
+    
+    const IniField* Find(std::uint64_t sectionHash, std::uint64_t keyHash) const {
+        const std::uint64_t hash = IniFieldHash(sectionHash, keyHash);
+        const std::uint8_t index = slots[Slot(hash, multiplier)];
+        return (index != kEmptySlot && hashes[index] == hash) ? &fields[index] : nullptr;
+    }
+    
+    // Known keys are stored, unknown ones ignored; a section name limits it to that section
+    void Apply(const IniDocument& ini, std::string_view fileName, std::string_view onlySection = {}) const {
+        const std::uint64_t onlyHash = IniHash(onlySection);
+        for (const auto& section : ini.Sections()) {
+            if (!onlySection.empty() && section.nameHash != onlyHash) continue;
+            ini.ForEachEntry(section, [&](const IniDocument::Entry& entry) {
+                if (const IniField* field = Find(section.nameHash, entry.keyHash)) {
+                    AssignIniField(*field, entry.value, fileName);
+                }
+            });
+        }
+    }
+    
+    void ApplyDefaults() const {
+        for (const auto& field : fields) AssignIniField(field, field.defaultValue, {});
+    }
+    
+    // Sections in schema order, separated by a blank line
+    void Write(std::ostream& out, bool defaults = false) const {
+        for (size_t i = 0; i < N; ++i) {
+            const auto& field = fields[i];
+            if (i == 0 || field.section != fields[i - 1].section) {
+                if (i > 0) out << "\n";
+                out << "[" << field.section << "]\n";
+            }
+            out << field.key << " = ";
+            if (defaults) {
+                out << field.defaultValue;
+            } else {
+                WriteIniValue(out, field.target);
+            }
+            out << "\n";
+        }
+    }
+    
+    // Puts every field's current value into the document; true when any text changed
+    bool Store(IniDocument& ini) const {
+        bool changed = false;
+        for (const auto& field : fields) {
+            changed |= ini.Set(field.section, field.key, FormatIniValue(field.target)) != IniDocument::EditResult::kUnchanged;
+        }
+        return changed;
+    }
+    
+    const std::array<IniField, N>& Fields() const { return fields; }
+    
+private:
+    static constexpr size_t kSlotCount = std::bit_ceil(N * 2);
+    static constexpr int kSlotBits = std::countr_zero(kSlotCount);
+    static constexpr std::uint8_t kEmptySlot = 0xFF;
+    static constexpr std::uint64_t kFirstMultiplier = 0x9E3779B97F4A7C15ull;
+    static constexpr std::uint64_t kMaxAttempts = 100000;
+    
+    static constexpr size_t Slot(std::uint64_t hash, std::uint64_t multiplier) {
+        return static_cast<size_t>((hash * multiplier) >> (64 - kSlotBits));
+    }
+    
+    constexpr bool TryPlace() {
+        slots.fill(kEmptySlot);
+        for (size_t i = 0; i < N; ++i) {
+            auto& slot = slots[Slot(hashes[i], multiplier)];
+            if (slot != kEmptySlot) return false;
+            slot = static_cast<std::uint8_t>(i);
+        }
+        return true;
+    }
+    
+    std::array<IniField, N> fields;
+    std::array<std::uint64_t, N> hashes{};
+    std::array<std::uint8_t, kSlotCount> slots{};
+    std::uint64_t multiplier = kFirstMultiplier;
+};
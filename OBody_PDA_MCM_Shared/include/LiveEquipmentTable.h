@@ -0,0 +1,92 @@
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "AdvancedLog.h"
+#include "EquipmentSlots.h"
+
+// ===== LIVE EQUIPMENT TABLE =====
+// Worn biped armor per actor RefID, kept current by TESEquipEvent so tracking does not have to
+// walk inventories. An actor enters the table through one full inventory capture the first time
+// it is read; after that equip and unequip events move armor in and out of its slots. Entries
+// are re-captured after kLiveEquipmentMaxAge in case an event was missed, and the table is
+// dropped on new game and load game. Hands are always read live from the actor, which is cheap.
+
+constexpr std::chrono::minutes kLiveEquipmentMaxAge{5};
+
+class LiveEquipmentTable {
+public:
+    void Seed(std::uint32_t refID, const EquippedFormIDs& equipment) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries[refID] = {equipment, std::chrono::steady_clock::now()};
+    }
+
+    // Equipping claims every slot of the mask (the game has already removed whatever was
+    // there); unequipping frees the slots this armor still holds. Unknown actors are ignored.
+    void OnArmorEvent(std::uint32_t refID, std::uint32_t armorID, std::uint32_t slotMask, bool equipped) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events++;
+
+        auto it = entries.find(refID);
+        if (it == entries.end()) return;
+
+        auto& equipment = it->second.equipment;
+        while (slotMask != 0) {
+            size_t slot = kFirstBipedEquipSlot + std::countr_zero(slotMask);
+            slotMask &= slotMask - 1;
+            if (equipped) {
+                equipment[slot] = armorID;
+            } else if (equipment[slot] == armorID) {
+                equipment[slot] = 0;
+            }
+        }
+    }
+
+    // False when the actor has no entry yet or its entry is too old to trust
+    bool Lookup(std::uint32_t refID, EquippedFormIDs& equipment) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(refID);
+        if (it == entries.end() || std::chrono::steady_clock::now() - it->second.verified > kLiveEquipmentMaxAge) {
+            misses++;
+            return false;
+        }
+        hits++;
+        equipment = it->second.equipment;
+        return true;
+    }
+
+    void Clear(const std::string& reason) {
+        std::lock_guard<std::mutex> lock(mutex);
+        WriteToAdvancedLogFrom("LiveEquipmentTable.h", "Live equipment table cleared (" + reason + "): " +
+                               std::to_string(entries.size()) + " actors, " + std::to_string(events) + " events",
+                               __LINE__);
+        entries.clear();
+        hits = 0;
+        misses = 0;
+        events = 0;
+    }
+
+    std::string Stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::to_string(entries.size()) + " actors, " + std::to_string(hits) + " table reads, " +
+               std::to_string(misses) + " full captures, " + std::to_string(events) + " equip events";
+    }
+
+private:
+    struct Entry {
+        EquippedFormIDs equipment;
+        std::chrono::steady_clock::time_point verified;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::uint32_t, Entry> entries;
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t events = 0;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// ===== SCAN FILTER PUSHDOWN =====
+// [Filter] in Act2_Manager.ini is applied inside the scan instead of by the UI. For every hit
+// in range four cheap columns are gathered (distance squared, sex, race FormID, plugin ID) and
+// tested four rows at a time with SSE2 lane compares; only matching rows are captured.
+
+struct FilterColumns {
+    std::vector<float> distanceSquared;
+    std::vector<std::uint32_t> female;
+    std::vector<std::uint32_t> raceIDs;
+    std::vector<std::uint32_t> pluginIDs;
+
+    size_t Size() const { return distanceSquared.size(); }
+
+    void Reserve(size_t count) {
+        distanceSquared.reserve(count);
+        female.reserve(count);
+        raceIDs.reserve(count);
+        pluginIDs.reserve(count);
+    }
+
+    void Push(float distSq, bool isFemale, std::uint32_t raceID, std::uint32_t pluginID) {
+        distanceSquared.push_back(distSq);
+        female.push_back(isFemale ? 1 : 0);
+        raceIDs.push_back(raceID);
+        pluginIDs.push_back(pluginID);
+    }
+};
+
+enum class FilterSex : std::uint8_t { kAny, kMale, kFemale };
+
+struct CompiledNPCFilter {
+    bool active = false;
+    float maxDistanceSquared = std::numeric_limits<float>::max();
+    FilterSex sex = FilterSex::kAny;
+    bool restrictRaces = false;
+    bool restrictPlugins = false;
+    std::vector<std::uint32_t> raceIDs;
+    std::vector<std::uint32_t> pluginIDs;
+    std::vector<std::uint32_t> excludedPluginIDs;
+
+    // Scalar reference, also used for the kernel tail
+    bool Matches(float distSq, std::uint32_t isFemale, std::uint32_t raceID, std::uint32_t pluginID) const {
+        auto contains = [](const std::vector<std::uint32_t>& values, std::uint32_t value) {
+            return std::find(values.begin(), values.end(), value) != values.end();
+        };
+        if (!(distSq <= maxDistanceSquared)) return false;
+        if (sex != FilterSex::kAny && isFemale != (sex == FilterSex::kFemale ? 1u : 0u)) return false;
+        if (restrictRaces && !contains(raceIDs, raceID)) return false;
+        if (restrictPlugins && !contains(pluginIDs, pluginID)) return false;
+        return !contains(excludedPluginIDs, pluginID);
+    }
+};
+
+// Lane mask of lanes equal to any of values
+inline __m128i AnyLaneEquals(__m128i lanes, const std::vector<std::uint32_t>& values) {
+    __m128i any = _mm_setzero_si128();
+    for (auto value : values) {
+        any = _mm_or_si128(any, _mm_cmpeq_epi32(lanes, _mm_set1_epi32(static_cast<int>(value))));
+    }
+    return any;
+}
+
+// Appends the indices of matching rows in order
+inline void FilterRows(const CompiledNPCFilter& filter, const FilterColumns& columns, std::vector<std::uint32_t>& matches) {
+    const size_t count = columns.Size();
+    const __m128 maxDistance = _mm_set1_ps(filter.maxDistanceSquared);
+    const __m128i wantFemale = _mm_set1_epi32(filter.sex == FilterSex::kFemale ? 1 : 0);
+
+    size_t row = 0;
+    for (; row + 4 <= count; row += 4) {
+        __m128i mask = _mm_castps_si128(_mm_cmple_ps(_mm_loadu_ps(&columns.distanceSquared[row]), maxDistance));
+        if (filter.sex != FilterSex::kAny) {
+            __m128i female = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&columns.female[row]));
+            mask = _mm_and_si128(mask, _mm_cmpeq_epi32(female, wantFemale));
+        }
+        if (filter.restrictRaces) {
+            __m128i races = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&columns.raceIDs[row]));
+            mask = _mm_and_si128(mask, AnyLaneEquals(races, filter.raceIDs));
+        }
+        if (filter.restrictPlugins || !filter.excludedPluginIDs.empty()) {
+            __m128i plugins = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&columns.pluginIDs[row]));
+            if (filter.restrictPlugins) mask = _mm_and_si128(mask, AnyLaneEquals(plugins, filter.pluginIDs));
+            mask = _mm_andnot_si128(AnyLaneEquals(plugins, filter.excludedPluginIDs), mask);
+        }
+
+        unsigned bits = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+        while (bits) {
+            matches.push_back(static_cast<std::uint32_t>(row + std::countr_zero(bits)));
+            bits &= bits - 1;
+        }
+    }
+
+    for (; row < count; ++row) {
+        if (filter.Matches(columns.distanceSquared[row], columns.female[row], columns.raceIDs[row], columns.pluginIDs[row])) {
+            matches.push_back(static_cast<std::uint32_t>(row));
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "WorkerThread.h"
+
+// ===== PARALLEL FOR POOL =====
+// Data-parallel loops (resolving a scan snapshot, building the export JSON) share one set of
+// helper threads that are started on the first loop and then sleep between loops, instead of
+// spawning and joining threads on every call. One loop runs at a time; a caller that finds the
+// pool busy runs its loop alone on its own thread rather than waiting. Loops must not nest.
+
+class ParallelForPool {
+public:
+    // helperCount threads join the caller, so a loop runs on up to helperCount + 1 threads
+    explicit ParallelForPool(size_t helperCount) : helperCount(helperCount) {}
+
+    ~ParallelForPool() {
+        Stop();
+    }
+
+    ParallelForPool(const ParallelForPool&) = delete;
+    ParallelForPool& operator=(const ParallelForPool&) = delete;
+
+    size_t ThreadCount() const { return helperCount + 1; }
+
+    // Runs work(0..count-1) with at least minItemsPerThread items per thread; the first exception
+    // thrown by work stops the loop and is rethrown to the caller
+    void Run(size_t count, size_t minItemsPerThread, const std::function<void(size_t)>& work) {
+        size_t threads = std::min(ThreadCount(), (count + minItemsPerThread - 1) / std::max<size_t>(minItemsPerThread, 1));
+        std::unique_lock<std::mutex> runLock(runMutex, std::try_to_lock);
+        if (threads <= 1 || !runLock.owns_lock()) {
+            for (size_t i = 0; i < count; ++i) work(i);
+            return;
+        }
+
+        Batch batch;
+        batch.work = &work;
+        batch.count = count;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (helpers.empty()) {
+                stopping = false;
+                helpers = std::vector<WorkerThread>(helperCount);
+                for (size_t h = 0; h < helpers.size(); ++h) {
+                    helpers[h].Start("parallel for " + std::to_string(h), [this](std::stop_token) { HelperLoop(); });
+                }
+            }
+            current = &batch;
+            openSlots = threads - 1;
+        }
+        batchAvailable.notify_all();
+
+        Drain(batch);
+
+        // Helpers only join while current is set, so none can start on the batch after this
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            current = nullptr;
+            openSlots = 0;
+            batchDone.wait(lock, [&batch] { return batch.active == 0; });
+        }
+
+        if (batch.failure) std::rethrow_exception(batch.failure);
+    }
+
+    // Joins the helpers; the next Run() starts them again
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (helpers.empty()) return;
+            stopping = true;
+        }
+        batchAvailable.notify_all();
+        for (auto& helper : helpers) helper.Join(kWorkerJoinTimeout);
+        std::lock_guard<std::mutex> lock(mutex);
+        helpers.clear();
+    }
+
+private:
+    struct Batch {
+        const std::function<void(size_t)>* work = nullptr;
+        size_t count = 0;
+        std::atomic<size_t> next{0};
+        size_t active = 0;  // Helpers inside the batch, guarded by the pool mutex
+        std::mutex failureMutex;
+        std::exception_ptr failure;
+    };
+
+    static void Drain(Batch& batch) {
+        try {
+            for (size_t i = batch.next.fetch_add(1); i < batch.count; i = batch.next.fetch_add(1)) (*batch.work)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(batch.failureMutex);
+            if (!batch.failure) batch.failure = std::current_exception();
+            batch.next = batch.count;
+        }
+    }
+
+    void HelperLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            batchAvailable.wait(lock, [this] { return stopping || (current && openSlots > 0); });
+            if (stopping) return;
+
+            Batch& batch = *current;
+            openSlots--;
+            batch.active++;
+            lock.unlock();
+            Drain(batch);
+            lock.lock();
+            if (--batch.active == 0) batchDone.notify_all();
+        }
+    }
+
+    const size_t helperCount;
+    std::mutex runMutex;
+    std::mutex mutex;
+    std::condition_variable batchAvailable;
+    std::condition_variable batchDone;
+    std::vector<WorkerThread> helpers;
+    Batch* current = nullptr;
+    size_t openSlots = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "IniDocument.h"
+
+// ===== PLUGIN FILTER LISTS =====
+// Act2_Plugins.ini and Act2_NPCs.ini can hold thousands of "Plugin.esp = true" lines. The file
+// is memory mapped and tokenized in place; names are matched case-insensitively, as the game
+// does, through one IniHash per name. A reload returns early while the file's timestamp and
+// size are unchanged, and skips parsing while its content hash is. After BindLoadOrder() the
+// scans look plugins up by load-order ID instead of by name.
+
+// Load-order ID of a plugin that is not loaded
+constexpr std::uint32_t kNoPluginID = 0xFFFFFFFF;
+
+// Read-only view of a whole file; an empty file maps to an empty view
+class MappedFile {
+public:
+#ifdef _WIN32
+    explicit MappedFile(const std::filesystem::path& path) {
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                           nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize)) return;
+        if (fileSize.QuadPart == 0) {
+            opened = true;
+            return;
+        }
+
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return;
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!data) return;
+        size = static_cast<size_t>(fileSize.QuadPart);
+        opened = true;
+    }
+
+    ~MappedFile() {
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    }
+#elif defined(__linux__)
+    explicit MappedFile(const std::filesystem::path& path) {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+
+        struct stat info {};
+        if (fstat(fd, &info) == 0) {
+            if (info.st_size == 0) {
+                opened = true;
+            } else {
+                void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (view != MAP_FAILED) {
+                    data = static_cast<const char*>(view);
+                    size = static_cast<size_t>(info.st_size);
+                    opened = true;
+                }
+            }
+        }
+        close(fd);
+    }
+
+    ~MappedFile() {
+        if (data) munmap(const_cast<char*>(data), size);
+    }
+#endif
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsOpen() const { return opened; }
+    std::string_view View() const { return {data, size}; }
+
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+    const char* data = nullptr;
+    size_t size = 0;
+    bool opened = false;
+};
+
+// IniHash values are already well mixed
+struct PrehashedKey {
+    size_t operator()(std::uint64_t hash) const noexcept { return static_cast<size_t>(hash); }
+};
+
+class PluginFilterList {
+public:
+    enum class LoadResult {
+        kMissing,
+        kError,
+        kUnchanged,
+        kLoaded
+    };
+
+    // Missing or unreadable files clear the list
+    LoadResult Load(const std::filesystem::path& path) {
+        std::error_code ec;
+        const auto writeTime = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            Clear();
+            return LoadResult::kMissing;
+        }
+        const auto fileSize = std::filesystem::file_size(path, ec);
+        if (!ec && loaded && writeTime == lastWriteTime && fileSize == lastSize) return LoadResult::kUnchanged;
+
+        MappedFile mapped(path);
+        if (!mapped.IsOpen()) {
+            Clear();
+            return LoadResult::kError;
+        }
+        lastWriteTime = writeTime;
+        lastSize = fileSize;
+        return Parse(mapped.View());
+    }
+
+    // Same line rules as IniDocument; section headers are ignored and later lines win.
+    // The content hash folds case like the names, so case-only edits do not reload.
+    LoadResult Parse(std::string_view content) {
+        const std::uint64_t hash = IniHash(content);
+        if (loaded && hash == contentHash) return LoadResult::kUnchanged;
+
+        Clear();
+        loaded = true;
+        contentHash = hash;
+        entries.reserve(content.size() / 24);
+        index.reserve(content.size() / 24);
+
+        if (content.starts_with("\xEF\xBB\xBF")) content.remove_prefix(3);
+        while (!content.empty()) {
+            size_t lineEnd = content.find('\n');
+            std::string_view line = IniDocument::Trim(content.substr(0, lineEnd));
+            content.remove_prefix(lineEnd == std::string_view::npos ? content.size() : lineEnd + 1);
+
+            if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+            size_t equalPos = line.find('=');
+            if (equalPos == std::string_view::npos) continue;
+
+            std::string_view name = IniDocument::Trim(line.substr(0, equalPos));
+            if (name.empty()) continue;
+            const bool enabled = IniDocument::ToBool(IniDocument::Trim(line.substr(equalPos + 1)));
+
+            auto [it, inserted] = index.try_emplace(IniHash(name), static_cast<std::uint32_t>(entries.size()));
+            if (inserted) {
+                entries.push_back({IniDocument::ToLower(name), enabled});
+            } else {
+                entries[it->second].enabled = enabled;
+            }
+        }
+        return LoadResult::kLoaded;
+    }
+
+    // pluginID(name) returns the load-order ID, or kNoPluginID for plugins that are not loaded
+    template <class Resolve>
+    void BindLoadOrder(Resolve&& pluginID) {
+        byPluginID.clear();
+        byPluginID.reserve(entries.size());
+        for (const auto& entry : entries) {
+            std::uint32_t id = pluginID(entry.name);
+            if (id != kNoPluginID) byPluginID[id] = entry.enabled;
+        }
+        bound = true;
+    }
+
+    // nullopt when the plugin is not listed at all
+    std::optional<bool> Find(std::string_view pluginName) const {
+        auto it = index.find(IniHash(pluginName));
+        if (it == index.end() || !IniDocument::EqualsNoCase(entries[it->second].name, pluginName)) return std::nullopt;
+        return entries[it->second].enabled;
+    }
+
+    bool Enabled(std::string_view pluginName) const {
+        auto enabled = Find(pluginName);
+        return enabled && *enabled;
+    }
+
+    bool EnabledByID(std::uint32_t pluginID) const {
+        auto it = byPluginID.find(pluginID);
+        return it != byPluginID.end() && it->second;
+    }
+
+    bool Bound() const { return bound; }
+    bool Empty() const { return entries.empty(); }
+    size_t Size() const { return entries.size(); }
+
+    size_t EnabledCount() const {
+        return static_cast<size_t>(std::count_if(entries.begin(), entries.end(), [](const Entry& entry) { return entry.enabled; }));
+    }
+
+private:
+    struct Entry {
+        std::string name;  // lower case
+        bool enabled;
+    };
+
+    void Clear() {
+        entries.clear();
+        index.clear();
+        byPluginID.clear();
+        loaded = false;
+        bound = false;
+        contentHash = 0;
+        lastWriteTime = {};
+        lastSize = 0;
+    }
+
+    std::vector<Entry> entries;
+    std::unordered_map<std::uint64_t, std::uint32_t, PrehashedKey> index;
+    std::unordered_map<std::uint32_t, bool> byPluginID;
+    bool loaded = false;
+    bool bound = false;
+    std::uint64_t contentHash = 0;
+    std::filesystem::file_time_type lastWriteTime{};
+    std::uintmax_t lastSize = 0;
+};
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ===== SPATIAL GRID INDEX =====
+// Snapshot of actor positions bucketed into square cells on the X/Y plane. Radius queries
+// visit only the cells overlapping the query circle and reject by squared distance; nearest-N
+// queries widen ring by ring around the query cell and keep the best N in a bounded max-heap.
+
+struct GridPoint {
+    float x;
+    float y;
+    float z;
+    std::uint32_t id;
+};
+
+struct GridHit {
+    std::uint32_t id;
+    float distanceSquared;
+};
+
+constexpr float kActorGridCellSize = 1024.0f;
+
+class SpatialGridIndex {
+public:
+    explicit SpatialGridIndex(float cellSize = kActorGridCellSize)
+        : cellSize(cellSize), inverseCellSize(1.0f / cellSize) {}
+
+    void Build(std::vector<GridPoint> newPoints) {
+        points = std::move(newPoints);
+        cells.clear();
+        if (points.empty()) return;
+
+        minCellX = minCellY = std::numeric_limits<std::int32_t>::max();
+        maxCellX = maxCellY = std::numeric_limits<std::int32_t>::min();
+
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> keyed;
+        keyed.reserve(points.size());
+        for (std::uint32_t i = 0; i < points.size(); ++i) {
+            std::int32_t cx = CellCoord(points[i].x);
+            std::int32_t cy = CellCoord(points[i].y);
+            minCellX = std::min(minCellX, cx);
+            maxCellX = std::max(maxCellX, cx);
+            minCellY = std::min(minCellY, cy);
+            maxCellY = std::max(maxCellY, cy);
+            keyed.emplace_back(CellKey(cx, cy), i);
+        }
+        std::sort(keyed.begin(), keyed.end());
+
+        std::vector<GridPoint> sorted;
+        sorted.reserve(points.size());
+        cells.reserve(points.size());
+        for (size_t i = 0; i < keyed.size(); ++i) {
+            if (i == 0 || keyed[i].first != keyed[i - 1].first) {
+                cells[keyed[i].first] = {static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i)};
+            }
+            sorted.push_back(points[keyed[i].second]);
+            cells[keyed[i].first].second = static_cast<std::uint32_t>(i + 1);
+        }
+        points = std::move(sorted);
+    }
+
+    size_t Size() const { return points.size(); }
+    size_t CellCount() const { return cells.size(); }
+
+    // Appends every point within radius of (x, y, z); hits are in cell order, not distance order
+    void QueryRadius(float x, float y, float z, float radius, std::vector<GridHit>& out) const {
+        if (points.empty() || radius < 0.0f) return;
+
+        float radiusSquared = radius * radius;
+        auto visit = [&](const GridPoint& point) {
+            float d = DistanceSquared(point, x, y, z);
+            if (d <= radiusSquared) out.push_back({point.id, d});
+        };
+
+        std::int32_t fromX = std::max(CellCoord(x - radius), minCellX);
+        std::int32_t toX = std::min(CellCoord(x + radius), maxCellX);
+        std::int32_t fromY = std::max(CellCoord(y - radius), minCellY);
+        std::int32_t toY = std::min(CellCoord(y + radius), maxCellY);
+        if (fromX > toX || fromY > toY) return;
+
+        // A radius covering most of the occupied area is cheaper as a walk over the occupied cells
+        std::uint64_t span = static_cast<std::uint64_t>(toX - fromX + 1) * static_cast<std::uint64_t>(toY - fromY + 1);
+        if (span > cells.size()) {
+            for (const auto& point : points) visit(point);
+            return;
+        }
+
+        for (std::int32_t cx = fromX; cx <= toX; ++cx) {
+            for (std::int32_t cy = fromY; cy <= toY; ++cy) {
+                VisitCell(cx, cy, visit);
+            }
+        }
+    }
+
+    // Replaces out with the count nearest points within maxRadius, closest first
+    void QueryNearest(float x, float y, float z, size_t count, float maxRadius, std::vector<GridHit>& out) const {
+        out.clear();
+        if (points.empty() || count == 0) return;
+
+        float maxRadiusSquared = maxRadius * maxRadius;
+        auto farther = [](const GridHit& a, const GridHit& b) { return a.distanceSquared < b.distanceSquared; };
+        auto visit = [&](const GridPoint& point) {
+            float d = DistanceSquared(point, x, y, z);
+            if (d > maxRadiusSquared) return;
+            if (out.size() < count) {
+                out.push_back({point.id, d});
+                std::push_heap(out.begin(), out.end(), farther);
+            } else if (d < out.front().distanceSquared) {
+                std::pop_heap(out.begin(), out.end(), farther);
+                out.back() = {point.id, d};
+                std::push_heap(out.begin(), out.end(), farther);
+            }
+        };
+
+        std::int32_t centerX = CellCoord(x);
+        std::int32_t centerY = CellCoord(y);
+        std::int32_t maxRing = std::max({centerX - minCellX, maxCellX - centerX, centerY - minCellY, maxCellY - centerY});
+
+        for (std::int32_t ring = 0; ring <= std::max(maxRing, 0); ++ring) {
+            // Far from the crowd the rings are mostly empty; scanning every point is cheaper then
+            std::uint64_t ringSide = 2 * static_cast<std::uint64_t>(ring) + 1;
+            if (ringSide * ringSide > 4 * cells.size() + 16) {
+                out.clear();
+                for (const auto& point : points) visit(point);
+                break;
+            }
+
+            if (ring == 0) {
+                VisitCell(centerX, centerY, visit);
+            } else {
+                for (std::int32_t d = -ring; d <= ring; ++d) {
+                    VisitCell(centerX + d, centerY - ring, visit);
+                    VisitCell(centerX + d, centerY + ring, visit);
+                }
+                for (std::int32_t d = -ring + 1; d <= ring - 1; ++d) {
+                    VisitCell(centerX - ring, centerY + d, visit);
+                    VisitCell(centerX + ring, centerY + d, visit);
+                }
+            }
+
+            // Everything beyond this ring is at least ring * cellSize away on the X/Y plane
+            float nextRingDistance = static_cast<float>(ring) * cellSize;
+            float nextRingSquared = nextRingDistance * nextRingDistance;
+            if (nextRingSquared > maxRadiusSquared) break;
+            if (out.size() == count && nextRingSquared >= out.front().distanceSquared) break;
+        }
+
+        std::sort_heap(out.begin(), out.end(), farther);
+    }
+
+private:
+    static std::uint64_t CellKey(std::int32_t cx, std::int32_t cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+    }
+
+    static float DistanceSquared(const GridPoint& point, float x, float y, float z) {
+        float dx = point.x - x;
+        float dy = point.y - y;
+        float dz = point.z - z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    std::int32_t CellCoord(float value) const {
+        return static_cast<std::int32_t>(std::floor(value * inverseCellSize));
+    }
+
+    template <class Fn>
+    void VisitCell(std::int32_t cx, std::int32_t cy, Fn& visit) const {
+        auto it = cells.find(CellKey(cx, cy));
+        if (it == cells.end()) return;
+        for (std::uint32_t i = it->second.first; i < it->second.second; ++i) {
+            visit(points[i]);
+        }
+    }
+
+    float cellSize;
+    float inverseCellSize;
+    std::vector<GridPoint> points;
+    std::unordered_map<std::uint64_t, std::pair<std::uint32_t, std::uint32_t>> cells;
+    std::int32_t minCellX = 0;
+    std::int32_t maxCellX = -1;
+    std::int32_t minCellY = 0;
+    std::int32_t maxCellY = -1;
+};
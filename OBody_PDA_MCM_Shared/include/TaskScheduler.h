@@ -0,0 +1,449 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "AdvancedLog.h"
+#include "WorkerThread.h"
+
+// ===== TASK SCHEDULER =====
+// Periodic and one-shot plugin work shares one timer thread instead of a sleeping thread per
+// concern. Deadlines live in a hierarchical timer wheel (4 levels of 64 slots, 10 ms ticks, about
+// 46 hours of range), so arming and firing are O(1) and the timer thread sleeps straight to the
+// next occupied slot. Short tasks run inline on the timer thread; anything that scans game data
+// or touches the disk for long goes to a small worker pool started on demand.
+
+class TimerWheel {
+public:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 6;
+    static constexpr std::uint64_t kSlots = 1ull << kSlotBits;
+    static constexpr std::uint64_t kMaxDelayTicks = (1ull << (kSlotBits * kLevels)) - 1;
+
+    struct Timer {
+        std::uint64_t id;
+        std::uint64_t generation;
+        std::uint64_t due;
+    };
+
+    std::uint64_t Now() const {
+        return now;
+    }
+
+    // Due ticks in the past fire on the next tick; beyond the wheel's range they are clamped
+    void Insert(std::uint64_t id, std::uint64_t generation, std::uint64_t due) {
+        due = std::clamp(due, now + 1, now + kMaxDelayTicks);
+        Place({id, generation, due});
+    }
+
+    // First tick at which an occupied slot is processed, if any
+    std::optional<std::uint64_t> NextTick() const {
+        std::optional<std::uint64_t> next;
+        for (int level = 0; level < kLevels; ++level) {
+            std::uint64_t mask = occupied[level];
+            int shift = level * kSlotBits;
+            std::uint64_t base = (now >> shift) + 1;
+            while (mask != 0) {
+                std::uint64_t slot = std::countr_zero(mask);
+                mask &= mask - 1;
+                std::uint64_t tick = (base + ((slot - base) & (kSlots - 1))) << shift;
+                if (!next || tick < *next) next = tick;
+            }
+        }
+        return next;
+    }
+
+    // Processes every tick up to target, skipping stretches where no slot is due
+    void Advance(std::uint64_t target, std::vector<Timer>& fired) {
+        while (now < target) {
+            auto next = NextTick();
+            if (!next || *next > target) {
+                now = target;
+                return;
+            }
+            now = *next;
+            Cascade(1);
+            FireSlot(fired);
+        }
+    }
+
+    void Clear() {
+        for (auto& level : slots) {
+            for (auto& slot : level) slot.clear();
+        }
+        occupied.fill(0);
+    }
+
+private:
+    void Place(const Timer& timer) {
+        std::uint64_t delta = timer.due - now;
+        int level = 0;
+        while (level + 1 < kLevels && delta >= (1ull << (kSlotBits * (level + 1)))) ++level;
+        std::uint64_t slot = (timer.due >> (level * kSlotBits)) & (kSlots - 1);
+        slots[level][slot].push_back(timer);
+        occupied[level] |= 1ull << slot;
+    }
+
+    // On a level boundary the matching slot of the level above moves down, highest level first
+    void Cascade(int level) {
+        if (level >= kLevels) return;
+        int shift = level * kSlotBits;
+        if ((now & ((1ull << shift) - 1)) != 0) return;
+        if (((now >> shift) & (kSlots - 1)) == 0) Cascade(level + 1);
+
+        std::uint64_t slot = (now >> shift) & (kSlots - 1);
+        if (!(occupied[level] & (1ull << slot))) return;
+        auto timers = std::move(slots[level][slot]);
+        slots[level][slot].clear();
+        occupied[level] &= ~(1ull << slot);
+        for (const auto& timer : timers) Place(timer);
+    }
+
+    void FireSlot(std::vector<Timer>& fired) {
+        std::uint64_t slot = now & (kSlots - 1);
+        if (!(occupied[0] & (1ull << slot))) return;
+        auto& timers = slots[0][slot];
+        fired.insert(fired.end(), timers.begin(), timers.end());
+        timers.clear();
+        occupied[0] &= ~(1ull << slot);
+    }
+
+    std::array<std::array<std::vector<Timer>, kSlots>, kLevels> slots;
+    std::array<std::uint64_t, kLevels> occupied{};
+    std::uint64_t now = 0;
+};
+
+enum class TaskMode {
+    kInline,  // Runs on the timer thread; must return within a few milliseconds
+    kWorker
+};
+
+using TaskID = std::uint64_t;
+
+// Returns the delay until the task's next run, or nullopt when it is done
+using TaskFunction = std::function<std::optional<std::chrono::milliseconds>()>;
+
+constexpr std::chrono::milliseconds kSchedulerTick(10);
+constexpr size_t kSchedulerMaxWorkers = 2;
+
+class TaskScheduler {
+public:
+    ~TaskScheduler() {
+        Stop();
+    }
+
+    // A task never overlaps itself: its next run is armed only after the current one returns
+    // Returns 0, and schedules nothing, once a Stop() has failed
+    TaskID Schedule(std::string name, std::chrono::milliseconds delay, TaskMode mode, TaskFunction function) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failed) {
+            WriteToAdvancedLogFrom("TaskScheduler.h", "WARNING: Task scheduler is disabled after a failed stop, " + name +
+                                   " not scheduled", __LINE__);
+            return 0;
+        }
+        TaskID id = nextID++;
+        auto& task = tasks[id];
+        task.name = std::move(name);
+        task.mode = mode;
+        task.function = std::move(function);
+
+        if (!timerThread.Running()) {
+            stopping = false;
+            epoch = std::chrono::steady_clock::now();
+            timerThread.Start("scheduler timer", [this](std::stop_token) { TimerLoop(); });
+        }
+        Arm(id, task, delay);
+        return id;
+    }
+
+    // Errors are logged and the task keeps its period, like the monitor loops it replaces
+    TaskID Every(std::string name, std::chrono::milliseconds period, TaskMode mode, std::function<void()> function) {
+        return Schedule(name, std::chrono::milliseconds(0), mode,
+                        [name, period, function = std::move(function)]() -> std::optional<std::chrono::milliseconds> {
+                            try {
+                                function();
+                            } catch (const std::exception& e) {
+                                WriteToAdvancedLogFrom("TaskScheduler.h", "ERROR in task " + name + ": " + e.what(), __LINE__);
+                            }
+                            return period;
+                        });
+    }
+
+    TaskID After(std::string name, std::chrono::milliseconds delay, TaskMode mode, std::function<void()> function) {
+        return Schedule(std::move(name), delay, mode,
+                        [function = std::move(function)]() -> std::optional<std::chrono::milliseconds> {
+                            function();
+                            return std::nullopt;
+                        });
+    }
+
+    TaskID Post(std::string name, std::function<void()> function) {
+        return After(std::move(name), std::chrono::milliseconds(0), TaskMode::kWorker, std::move(function));
+    }
+
+    // Runs the task as soon as possible; a running task runs again right after it returns
+    void RunNow(TaskID id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = tasks.find(id);
+        if (it == tasks.end() || it->second.cancelled) return;
+        if (it->second.running) {
+            it->second.runAgain = true;
+        } else {
+            Arm(id, it->second, std::chrono::milliseconds(0));
+        }
+    }
+
+    // Waits for a running pass to finish, unless called from inside the task itself
+    void Cancel(TaskID id) {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto it = tasks.find(id);
+        if (it == tasks.end()) return;
+        if (!it->second.running) {
+            tasks.erase(it);
+            return;
+        }
+        it->second.cancelled = true;
+        if (it->second.runner == std::this_thread::get_id()) return;
+        taskFinished.wait(lock, [this, id] { return tasks.find(id) == tasks.end(); });
+    }
+
+    // Drops pending tasks and waits for running ones, whose stop tokens are signalled, for at most
+    // kWorkerJoinTimeout in total. The scheduler restarts on the next Schedule(). If a task is
+    // still running past the deadline, its thread is detached and the scheduler fails for good:
+    // the detached thread still returns into the task table and the queues, so they are left as
+    // they are and Schedule() refuses new tasks from then on.
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!timerThread.Running()) return;
+            stopping = true;
+        }
+        timerThread.RequestStop();
+        for (auto& worker : workers) worker.RequestStop();
+        timerWake.notify_all();
+        workAvailable.notify_all();
+
+        const auto deadline = std::chrono::steady_clock::now() + kWorkerJoinTimeout;
+        auto remaining = [&deadline] {
+            return std::max(std::chrono::milliseconds(0), std::chrono::ceil<std::chrono::milliseconds>(
+                                                              deadline - std::chrono::steady_clock::now()));
+        };
+        bool joined = timerThread.Join(remaining());
+        for (auto& worker : workers) joined = worker.Join(remaining()) && joined;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!joined) {
+            failed = true;
+            WriteToAdvancedLogFrom("TaskScheduler.h", "WARNING: Task scheduler did not stop within " +
+                                   std::to_string(kWorkerJoinTimeout.count()) + " ms, " + std::to_string(tasks.size()) +
+                                   " tasks left to detached threads, scheduler disabled", __LINE__);
+            return;
+        }
+        workers.clear();
+        idleWorkers = 0;
+        queue.clear();
+        ready.clear();
+        tasks.clear();
+        wheel.Clear();
+        taskFinished.notify_all();
+    }
+
+    // True once a Stop() had to leave a thread running
+    bool Failed() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return failed;
+    }
+
+    std::string Stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::to_string(tasks.size()) + " tasks, " + std::to_string(runs) + " runs, " +
+               std::to_string(wakeups) + " timer wakeups, " + std::to_string(workers.size()) + " workers";
+    }
+
+private:
+    struct Task {
+        std::string name;
+        TaskMode mode = TaskMode::kInline;
+        TaskFunction function;
+        std::uint64_t generation = 0;
+        std::uint64_t dueTick = 0;
+        bool running = false;
+        bool runAgain = false;
+        bool cancelled = false;
+        std::thread::id runner;
+    };
+
+    std::uint64_t TickAt(std::chrono::steady_clock::time_point time) const {
+        return time <= epoch ? 0 : static_cast<std::uint64_t>((time - epoch) / kSchedulerTick);
+    }
+
+    std::uint64_t CeilTickAt(std::chrono::steady_clock::time_point time) const {
+        if (time <= epoch) return 0;
+        return static_cast<std::uint64_t>((time - epoch + kSchedulerTick - std::chrono::nanoseconds(1)) / kSchedulerTick);
+    }
+
+    static std::uint64_t Ticks(std::chrono::milliseconds delay) {
+        return static_cast<std::uint64_t>((std::max(delay, std::chrono::milliseconds(0)) + kSchedulerTick -
+                                           std::chrono::milliseconds(1)) / kSchedulerTick);
+    }
+
+    // Called with the mutex held; older wheel entries of the task become stale. A delay returned
+    // by the task counts from the tick it was due on, so periods do not drift by the tick rounding.
+    void Arm(TaskID id, Task& task, std::chrono::milliseconds delay, std::optional<std::uint64_t> from = std::nullopt) {
+        if (!from && delay.count() <= 0) {
+            task.dueTick = TickAt(std::chrono::steady_clock::now());
+            ready.push_back({id, ++task.generation, task.dueTick});
+            timerWake.notify_one();
+            return;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        auto due = from ? std::max(*from + Ticks(delay), TickAt(now)) : CeilTickAt(now + delay);
+        due = std::max(due, wheel.Now() + 1);
+        task.dueTick = due;
+        wheel.Insert(id, ++task.generation, due);
+        if (due <= nextWakeTick) timerWake.notify_one();
+    }
+
+    static std::optional<std::chrono::milliseconds> Run(const std::string& name, const TaskFunction& function) {
+        try {
+            return function();
+        } catch (const std::exception& e) {
+            WriteToAdvancedLogFrom("TaskScheduler.h", "ERROR in task " + name + ": " + e.what(), __LINE__);
+        } catch (...) {
+            WriteToAdvancedLogFrom("TaskScheduler.h", "UNKNOWN ERROR in task " + name, __LINE__);
+        }
+        return std::nullopt;
+    }
+
+    // Called with the mutex held after a pass returns
+    void Finish(TaskID id, std::optional<std::chrono::milliseconds> next) {
+        runs++;
+        auto it = tasks.find(id);
+        if (it == tasks.end()) return;
+        auto& task = it->second;
+        task.running = false;
+        task.runner = {};
+
+        if (task.cancelled || (!next && !task.runAgain)) {
+            tasks.erase(it);
+            taskFinished.notify_all();
+            return;
+        }
+        if (task.runAgain) {
+            task.runAgain = false;
+            Arm(id, task, std::chrono::milliseconds(0));
+        } else {
+            Arm(id, task, *next, task.dueTick);
+        }
+    }
+
+    void TimerLoop() {
+        std::vector<TimerWheel::Timer> fired;
+        std::vector<TaskID> inlineTasks;
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (!stopping) {
+            // Tasks due immediately skip the wheel and the wait
+            if (ready.empty()) {
+                auto next = wheel.NextTick();
+                nextWakeTick = next.value_or(std::numeric_limits<std::uint64_t>::max());
+                if (next) {
+                    timerWake.wait_until(lock, epoch + kSchedulerTick * static_cast<std::int64_t>(*next));
+                } else {
+                    timerWake.wait(lock);
+                }
+            }
+            if (stopping) break;
+            wakeups++;
+
+            fired.swap(ready);
+            ready.clear();
+            inlineTasks.clear();
+            wheel.Advance(TickAt(std::chrono::steady_clock::now()), fired);
+            for (const auto& timer : fired) {
+                auto it = tasks.find(timer.id);
+                if (it == tasks.end() || it->second.generation != timer.generation || it->second.running) continue;
+                it->second.running = true;
+                if (it->second.mode == TaskMode::kInline) {
+                    it->second.runner = std::this_thread::get_id();
+                    inlineTasks.push_back(timer.id);
+                } else {
+                    queue.push_back(timer.id);
+                    if (idleWorkers == 0 && workers.size() < kSchedulerMaxWorkers) {
+                        workers.emplace_back().Start("scheduler worker " + std::to_string(workers.size()),
+                                                     [this](std::stop_token) { WorkerLoop(); });
+                    }
+                    workAvailable.notify_one();
+                }
+            }
+
+            // Entries are never erased while running, so the references stay valid unlocked
+            for (TaskID id : inlineTasks) {
+                auto& task = tasks.at(id);
+                std::optional<std::chrono::milliseconds> result;
+                if (!task.cancelled) {
+                    lock.unlock();
+                    result = Run(task.name, task.function);
+                    lock.lock();
+                }
+                Finish(id, result);
+            }
+        }
+    }
+
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            idleWorkers++;
+            workAvailable.wait(lock, [this] { return stopping || !queue.empty(); });
+            idleWorkers--;
+            if (stopping) return;
+
+            TaskID id = queue.front();
+            queue.pop_front();
+            auto& task = tasks.at(id);
+            std::optional<std::chrono::milliseconds> result;
+            if (!task.cancelled) {
+                task.runner = std::this_thread::get_id();
+                lock.unlock();
+                result = Run(task.name, task.function);
+                lock.lock();
+            }
+            Finish(id, result);
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable timerWake;
+    std::condition_variable workAvailable;
+    std::condition_variable taskFinished;
+    WorkerThread timerThread;
+    std::deque<WorkerThread> workers;
+    size_t idleWorkers = 0;
+    bool stopping = false;
+    bool failed = false;
+
+    std::unordered_map<TaskID, Task> tasks;
+    std::deque<TaskID> queue;
+    std::vector<TimerWheel::Timer> ready;
+    TimerWheel wheel;
+    std::chrono::steady_clock::time_point epoch;
+    std::uint64_t nextWakeTick = std::numeric_limits<std::uint64_t>::max();
+    TaskID nextID = 1;
+    size_t runs = 0;
+    size_t wakeups = 0;
+};
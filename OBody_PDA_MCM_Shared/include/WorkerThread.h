@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "AdvancedLog.h"
+
+// ===== WORKER THREADS =====
+// Every long-lived plugin thread is a WorkerThread: a std::jthread whose stop token is also
+// visible to the code it runs (CurrentStopToken), so waits registered on it end the moment a stop
+// is requested instead of at the next poll. Join() is bounded and logs how long the thread took;
+// a thread that misses the deadline is detached and reported rather than holding up the game's
+// exit, and whatever it may still touch has to be left alive by the owner.
+
+constexpr std::chrono::milliseconds kWorkerJoinTimeout(2000);
+
+class WorkerThread {
+public:
+    WorkerThread() = default;
+
+    ~WorkerThread() {
+        Join(kWorkerJoinTimeout);
+    }
+
+    WorkerThread(const WorkerThread&) = delete;
+    WorkerThread& operator=(const WorkerThread&) = delete;
+
+    template <class Body>
+    void Start(std::string threadName, Body&& body) {
+        name = std::move(threadName);
+        state = std::make_shared<State>();
+        thread = std::jthread([state = state, body = std::forward<Body>(body)](std::stop_token stop) mutable {
+            currentStop = stop;
+            body(stop);
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished = true;
+            state->done.notify_all();
+        });
+    }
+
+    bool Running() const { return thread.joinable(); }
+
+    void RequestStop() { thread.request_stop(); }
+
+    // Requests a stop and waits at most timeout; false when the thread had to be detached
+    bool Join(std::chrono::milliseconds timeout) {
+        if (!thread.joinable()) return true;
+        const auto start = std::chrono::steady_clock::now();
+        thread.request_stop();
+
+        if (thread.get_id() == std::this_thread::get_id()) {
+            thread.detach();
+            return false;
+        }
+
+        bool finished = false;
+#ifdef _WIN32
+        // The thread handle is also signalled for threads the process already terminated on exit
+        finished = WaitForSingleObject(thread.native_handle(), static_cast<DWORD>(timeout.count())) == WAIT_OBJECT_0;
+#else
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            finished = state->done.wait_for(lock, timeout, [this] { return state->finished; });
+        }
+#endif
+        const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        if (finished) {
+            thread.join();
+            ss << "Thread '" << name << "' stopped in " << elapsedMs << " ms";
+        } else {
+            thread.detach();
+            ss << "WARNING: Thread '" << name << "' did not stop within " << timeout.count() << " ms, left running detached";
+        }
+        WriteToAdvancedLogFrom("WorkerThread.h", ss.str(), __LINE__);
+        return finished;
+    }
+
+    // Stop token of the WorkerThread running the caller; one that never stops elsewhere
+    static std::stop_token CurrentStopToken() { return currentStop; }
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable done;
+        bool finished = false;
+    };
+
+    static inline thread_local std::stop_token currentStop;
+
+    std::string name;
+    std::shared_ptr<State> state;
+    std::jthread thread;
+};
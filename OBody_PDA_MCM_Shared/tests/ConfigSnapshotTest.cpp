@@ -0,0 +1,150 @@
+// Act2ManagerConfigSnapshot under load: reader threads check the config while the main thread
+// reloads it 500 times, first through a mutex held for the whole reload (as LoadNPCTrackingConfig
+// holds g_npcTrackingMutex), then through published snapshots. Every generation writes the same
+// number into fields of several sections, so a reader that sees them disagree has caught a
+// half-applied reload. Readers must also never see a generation older than one they already saw.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Act2ManagerConfig.h"
+#include "TestCheck.h"
+
+namespace {
+
+constexpr int kReloads = 500;
+
+Act2ManagerConfig MakeConfig(int generation) {
+    Act2ManagerConfig config{};
+    config.npcTracking.radio = generation;
+    config.npcTracking.intervalMs = generation;
+    config.npcTracking.rings = std::to_string(generation) + "," + std::to_string(generation * 2);
+    config.scheduler.frameBudgetMs = generation;
+    config.history.flushIntervalS = generation;
+    config.history.query = "generation " + std::to_string(generation);
+    config.filter.races = std::to_string(generation);
+    config.filter.maxDistance = static_cast<float>(generation);
+    return config;
+}
+
+bool Consistent(const Act2ManagerConfig& config) {
+    const int generation = config.npcTracking.radio;
+    return config.npcTracking.intervalMs == generation &&
+           config.npcTracking.rings == std::to_string(generation) + "," + std::to_string(generation * 2) &&
+           config.scheduler.frameBudgetMs == generation && config.history.flushIntervalS == generation &&
+           config.history.query == "generation " + std::to_string(generation) &&
+           config.filter.races == std::to_string(generation) &&
+           config.filter.maxDistance == static_cast<float>(generation);
+}
+
+struct StressResult {
+    size_t reads = 0;
+    size_t torn = 0;
+    size_t backwards = 0;
+    int lastSeen = 0;  // Lowest final generation over all readers
+    double worstReadUs = 0.0;
+    double elapsedMs = 0.0;
+};
+
+// read() returns the generation it saw, or -1 for a torn view
+template <class Read, class Reload>
+StressResult Stress(size_t readerCount, Read&& read, Reload&& reload) {
+    StressResult result;
+    result.lastSeen = std::numeric_limits<int>::max();
+    std::mutex resultMutex;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&]() {
+            StressResult local;
+            std::chrono::steady_clock::duration worst{};
+            do {
+                const auto start = std::chrono::steady_clock::now();
+                const int generation = read();
+                worst = std::max(worst, std::chrono::steady_clock::now() - start);
+                local.reads++;
+                if (generation < 0) {
+                    local.torn++;
+                } else {
+                    if (generation < local.lastSeen) local.backwards++;
+                    local.lastSeen = generation;
+                }
+            } while (!done.load(std::memory_order_relaxed));
+            // One more read after the last reload, which has to see it
+            local.lastSeen = std::max(local.lastSeen, read());
+
+            std::lock_guard<std::mutex> lock(resultMutex);
+            result.reads += local.reads;
+            result.torn += local.torn;
+            result.backwards += local.backwards;
+            result.lastSeen = std::min(result.lastSeen, local.lastSeen);
+            result.worstReadUs = std::max(result.worstReadUs, std::chrono::duration<double, std::micro>(worst).count());
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int generation = 1; generation <= kReloads; ++generation) {
+        reload(generation);
+        std::this_thread::yield();
+    }
+    result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    done = true;
+    for (auto& reader : readers) reader.join();
+    return result;
+}
+
+std::string Describe(const StressResult& result) {
+    std::stringstream out;
+    out << std::fixed << std::setprecision(1) << (result.elapsedMs > 0.0 ? result.reads / result.elapsedMs : 0.0)
+        << " reads/ms, worst read " << result.worstReadUs << " us, " << result.torn << " torn";
+    return out.str();
+}
+
+}  // namespace
+
+int main() {
+    const size_t readerCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8);
+
+    std::mutex lockedMutex;
+    Act2ManagerConfig lockedConfig = MakeConfig(0);
+    const StressResult locked = Stress(
+        readerCount,
+        [&]() {
+            std::lock_guard<std::mutex> lock(lockedMutex);
+            return Consistent(lockedConfig) ? lockedConfig.npcTracking.radio : -1;
+        },
+        [&](int generation) {
+            std::lock_guard<std::mutex> lock(lockedMutex);
+            lockedConfig = MakeConfig(generation);
+        });
+
+    Act2ManagerConfigSnapshot published(MakeConfig(0));
+    const auto held = published.Get();
+    const StressResult snapshot = Stress(
+        readerCount,
+        [&]() {
+            const auto config = published.Get();
+            return Consistent(*config) ? config->npcTracking.radio : -1;
+        },
+        [&](int generation) { published.Publish(MakeConfig(generation)); });
+
+    std::cout << readerCount << " readers x " << kReloads << " reloads: mutex " << Describe(locked) << " | snapshot "
+              << Describe(snapshot) << std::endl;
+
+    Check(locked.torn == 0, "no torn view through the mutex");
+    Check(snapshot.torn == 0, "no torn view in " + std::to_string(snapshot.reads) + " snapshot reads");
+    Check(snapshot.backwards == 0, "no reader sees an older snapshot after a newer one");
+    Check(locked.lastSeen == kReloads && snapshot.lastSeen == kReloads, "every reader sees the last reload");
+    Check(held->npcTracking.radio == 0 && Consistent(*held), "a snapshot held across every reload is unchanged");
+
+    return TestExitCode();
+}
@@ -0,0 +1,92 @@
+// FileWatchService on this platform's backend (inotify on Linux, ReadDirectoryChangesW on
+// Windows): a file created after Watch(), debounced bursts, neighbours in the same directory,
+// Unwatch(), and a watcher started again after Stop().
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "FileWatchService.h"
+#include "TestCheck.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::chrono::milliseconds kQuiet(400);
+
+class CallCounter {
+public:
+    void operator()() {
+        std::lock_guard<std::mutex> lock(mutex);
+        calls++;
+        called.notify_all();
+    }
+
+    // Waits until the count reaches expected, then for the quiet window, and returns the count
+    int Settle(int expected) {
+        std::unique_lock<std::mutex> lock(mutex);
+        called.wait_for(lock, kQuiet * 5, [&] { return calls >= expected; });
+        lock.unlock();
+        std::this_thread::sleep_for(kQuiet);
+        lock.lock();
+        return calls;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable called;
+    int calls = 0;
+};
+
+void Write(const fs::path& file, const std::string& text) {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    out << text;
+}
+
+}  // namespace
+
+int main() {
+    const fs::path directory = fs::temp_directory_path() / "OBodyPDA_FileWatchServiceTest";
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+    fs::create_directories(directory);
+    const fs::path watched = directory / "JsonMaster.ini";
+    const fs::path neighbour = directory / "JsonRecord.ini";
+
+    CallCounter counter;
+    FileWatchService watcher;
+    watcher.Watch(watched, kFileWatchDebounce, [&counter] { counter(); });
+    std::this_thread::sleep_for(kQuiet);
+
+    Write(watched, "[Act3_JSON]\nstartAct3 = false\n");
+    Check(counter.Settle(1) == 1, "file created after Watch() reports once");
+
+    for (int i = 0; i < 5; ++i) Write(watched, "[Act3_JSON]\nstartAct3 = " + std::to_string(i % 2 == 0) + "\n");
+    Check(counter.Settle(2) == 2, "a burst of writes inside the debounce window reports once");
+
+    Write(neighbour, "[Act4_JSON]\nstartAct4 = true\n");
+    Check(counter.Settle(2) == 2, "writes to another file in the directory are ignored");
+
+    const size_t wakeups = watcher.Wakeups();
+    std::this_thread::sleep_for(kQuiet);
+    Check(watcher.Wakeups() == wakeups, "no wakeups while nothing changes");
+
+    watcher.Unwatch(watched);
+    Write(watched, "[Act3_JSON]\nstartAct3 = true\n");
+    Check(counter.Settle(2) == 2, "no calls after Unwatch()");
+
+    watcher.Stop();
+    watcher.Watch(watched, kFileWatchDebounce, [&counter] { counter(); });
+    std::this_thread::sleep_for(kQuiet);
+    Write(watched, "[Act3_JSON]\nstartAct3 = false\n");
+    Check(counter.Settle(3) == 3, "the watcher starts again after Stop()");
+    watcher.Stop();
+
+    fs::remove_all(directory, ec);
+    return TestExitCode();
+}
@@ -0,0 +1,139 @@
+// FrameBudgetScheduler driven through ManualTaskQueue, one PumpFrame() per simulated frame: a slice
+// stays inside the frame budget, unfinished jobs are re-posted for the next frame, Cancel() keeps
+// the step from running again, and exceptions and a dead queue end the job with an Error().
+// Steps spin for at least kStepCost, so a slice that keeps to the budget runs at most
+// kBudget / kStepCost of them; being preempted can only make it run fewer, which keeps the
+// check independent of machine load where the slice's wall time is not.
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include "FrameBudgetScheduler.h"
+#include "TestCheck.h"
+
+namespace {
+
+constexpr std::chrono::microseconds kBudget(4000);
+constexpr std::chrono::microseconds kStepCost(600);  // Does not divide kBudget, so a whole step would overrun it
+
+// Busy-waits instead of sleeping, so a step costs what it claims and not a timer tick
+void Spin(std::chrono::microseconds duration) {
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+class FailingQueue : public MainThreadQueue {
+public:
+    bool Post(std::function<void()>) override { return false; }
+};
+
+// Pumps until nothing is queued; returns the number of frames that ran a task
+int PumpUntilIdle(ManualTaskQueue& queue, int maxFrames = 1000) {
+    int frames = 0;
+    while (queue.PendingCount() > 0 && frames < maxFrames) {
+        queue.PumpFrame();
+        frames++;
+    }
+    return frames;
+}
+
+}  // namespace
+
+int main() {
+    ManualTaskQueue queue;
+    FrameBudgetScheduler scheduler(queue);
+    scheduler.SetFrameBudget(kBudget);
+
+    {
+        constexpr size_t kSteps = 40;
+        size_t done = 0;
+        auto job = scheduler.Submit([&done] {
+            Spin(kStepCost);
+            return ++done < kSteps;
+        });
+
+        Check(done == 0 && queue.PendingCount() == 1, "Submit() only posts the first slice");
+        queue.PumpFrame();
+        const size_t firstFrame = done;
+        Check(firstFrame > 0 && firstFrame < kSteps, "the first frame runs " + std::to_string(firstFrame) + " of " +
+                                                         std::to_string(kSteps) + " steps");
+        Check(queue.PendingCount() == 1 && !job->Wait(std::chrono::milliseconds(0)),
+              "the unfinished job is re-posted for the next frame");
+
+        size_t mostStepsInFrame = firstFrame;
+        int frames = 1;
+        while (queue.PendingCount() > 0 && frames < 1000) {
+            const size_t before = done;
+            queue.PumpFrame();
+            mostStepsInFrame = std::max(mostStepsInFrame, done - before);
+            frames++;
+        }
+        const auto stats = job->Stats();
+        const size_t stepsPerBudget = static_cast<size_t>(kBudget / kStepCost);
+        Check(job->Succeeded() && done == kSteps && stats.steps == kSteps, "the job finishes every step");
+        Check(stats.frames == frames && frames > 1, "the job ran over " + std::to_string(frames) + " frames");
+        Check(mostStepsInFrame <= stepsPerBudget,
+              "no slice runs past the budget: at most " + std::to_string(mostStepsInFrame) + " steps of " +
+                  std::to_string(kStepCost.count()) + " us in " + std::to_string(kBudget.count()) +
+                  " us, longest slice " + std::to_string(stats.longestSliceMs) + " ms");
+    }
+
+    {
+        scheduler.SetFrameBudget(std::chrono::microseconds(1));
+        size_t done = 0;
+        auto job = scheduler.Submit([&done] {
+            Spin(kStepCost);
+            return ++done < 3;
+        });
+        queue.PumpFrame();
+        Check(done == 1, "a budget smaller than one step still advances one step per frame");
+        PumpUntilIdle(queue);
+        Check(job->Succeeded() && job->Stats().frames == 3, "the job ends after three one-step frames");
+        scheduler.SetFrameBudget(kBudget);
+    }
+
+    {
+        size_t done = 0;
+        auto job = scheduler.Submit([&done] {
+            Spin(kStepCost);
+            ++done;
+            return true;
+        });
+        queue.PumpFrame();
+        const size_t beforeCancel = done;
+        job->Cancel();
+        PumpUntilIdle(queue);
+        Check(beforeCancel > 0 && done == beforeCancel, "no step runs after Cancel()");
+        Check(queue.PendingCount() == 0, "a cancelled job is not re-posted");
+        Check(job->Wait(std::chrono::milliseconds(0)) && !job->Succeeded(), "a cancelled job is finished but not successful");
+    }
+
+    {
+        size_t done = 0;
+        auto job = scheduler.Submit([&done]() -> bool {
+            if (++done == 3) throw std::runtime_error("step failed");
+            return true;
+        });
+        PumpUntilIdle(queue);
+        Check(!job->Succeeded() && job->Error() == "step failed", "an exception from a step ends up in Error()");
+        Check(done == 3, "the step does not run after it threw");
+    }
+
+    {
+        FailingQueue deadQueue;
+        FrameBudgetScheduler deadScheduler(deadQueue);
+        bool ran = false;
+        auto job = deadScheduler.Submit([&ran] {
+            ran = true;
+            return false;
+        });
+        Check(!ran && job->Wait(std::chrono::milliseconds(0)) && job->Error() == "task interface unavailable",
+              "a queue that refuses the post fails the job at once");
+    }
+
+    return TestExitCode();
+}
@@ -0,0 +1,99 @@
+// ParallelForPool as the scan and the export use it: every index runs exactly once, the helpers
+// are reused across loops instead of being spawned per call, an exception reaches the caller and
+// leaves the pool usable, and a second caller that finds the pool busy still completes its loop.
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ParallelForPool.h"
+#include "TestCheck.h"
+
+namespace {
+
+bool EachOnce(const std::vector<std::atomic<int>>& hits) {
+    for (const auto& hit : hits) {
+        if (hit.load() != 1) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    ParallelForPool pool(3);
+    constexpr size_t kItems = 10000;
+
+    std::mutex threadsMutex;
+    std::set<std::thread::id> threads;
+    bool allOnce = true;
+    for (int round = 0; round < 50; ++round) {
+        std::vector<std::atomic<int>> hits(kItems);
+        pool.Run(kItems, 16, [&](size_t i) {
+            hits[i]++;
+            if (i % 64 == 0) {
+                std::lock_guard<std::mutex> lock(threadsMutex);
+                threads.insert(std::this_thread::get_id());
+            }
+        });
+        allOnce = allOnce && EachOnce(hits);
+    }
+    Check(allOnce, "every index runs exactly once in 50 loops");
+    Check(threads.size() <= pool.ThreadCount(),
+          "50 loops ran on " + std::to_string(threads.size()) + " threads, at most " + std::to_string(pool.ThreadCount()));
+
+    std::vector<std::atomic<int>> small(10);
+    std::set<std::thread::id> smallThreads;
+    pool.Run(small.size(), 16, [&](size_t i) {
+        small[i]++;
+        smallThreads.insert(std::this_thread::get_id());
+    });
+    Check(EachOnce(small) && smallThreads.size() == 1 && *smallThreads.begin() == std::this_thread::get_id(),
+          "a loop below the per-thread minimum runs on the caller");
+
+    bool rethrown = false;
+    try {
+        pool.Run(kItems, 16, [](size_t i) {
+            if (i == kItems / 2) throw std::runtime_error("item failed");
+        });
+    } catch (const std::runtime_error&) {
+        rethrown = true;
+    }
+    Check(rethrown, "an exception in the loop reaches the caller");
+
+    std::vector<std::atomic<int>> afterFailure(kItems);
+    pool.Run(kItems, 16, [&](size_t i) { afterFailure[i]++; });
+    Check(EachOnce(afterFailure), "the pool runs loops after an exception");
+
+    std::atomic<bool> firstStarted(false);
+    std::atomic<bool> secondDone(false);
+    std::vector<std::atomic<int>> first(64);
+    std::vector<std::atomic<int>> second(kItems);
+    std::thread other([&] {
+        while (!firstStarted.load()) std::this_thread::yield();
+        pool.Run(kItems, 16, [&](size_t i) { second[i]++; });
+        secondDone = true;
+    });
+    pool.Run(first.size(), 16, [&](size_t i) {
+        firstStarted = true;
+        if (i == 0) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (!secondDone.load() && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+        }
+        first[i]++;
+    });
+    other.join();
+    Check(EachOnce(first) && EachOnce(second) && secondDone.load(), "a caller that finds the pool busy runs its loop alone");
+
+    pool.Stop();
+    std::vector<std::atomic<int>> afterStop(kItems);
+    pool.Run(kItems, 16, [&](size_t i) { afterStop[i]++; });
+    Check(EachOnce(afterStop), "the pool restarts after Stop()");
+
+    return TestExitCode();
+}
@@ -0,0 +1,100 @@
+// Stopping the shared threads the way ShutdownPlugin does: a TaskScheduler whose worker waits on
+// its stop token and a FileWatchService stop well inside kWorkerJoinTimeout and can be started
+// again; a task that ignores its stop token makes Stop() give up at the deadline and leaves the
+// scheduler disabled instead of half reset.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "FileWatchService.h"
+#include "TaskScheduler.h"
+#include "TestCheck.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+template <class Fn>
+std::chrono::milliseconds Time(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+}
+
+bool WaitFor(const std::atomic<bool>& flag, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!flag.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return flag.load();
+}
+
+}  // namespace
+
+int main() {
+    const fs::path directory = fs::temp_directory_path() / "OBodyPDA_ShutdownTest";
+    fs::create_directories(directory);
+
+    {
+        FileWatchService watcher;
+        TaskScheduler scheduler;
+        std::atomic<bool> blocked(false);
+        watcher.Watch(directory / "watched.ini", kFileWatchDebounce, [] {});
+        scheduler.Every("heartbeat", std::chrono::seconds(1), TaskMode::kInline, [] {});
+        scheduler.Post("main thread wait", [&blocked] {
+            std::mutex mutex;
+            std::condition_variable_any never;
+            std::unique_lock<std::mutex> lock(mutex);
+            blocked = true;
+            never.wait(lock, WorkerThread::CurrentStopToken(), [] { return false; });
+        });
+        Check(WaitFor(blocked, std::chrono::seconds(2)), "worker is blocked before the stop");
+
+        const auto stopped = Time([&] {
+            watcher.Stop();
+            scheduler.Stop();
+        });
+        Check(stopped < kWorkerJoinTimeout / 4, "blocked worker stops in " + std::to_string(stopped.count()) + " ms");
+        Check(!scheduler.Failed(), "scheduler is not disabled by a clean stop");
+
+        std::atomic<bool> ran(false);
+        Check(scheduler.After("after restart", std::chrono::milliseconds(0), TaskMode::kWorker, [&ran] { ran = true; }) != 0,
+              "scheduler accepts tasks after a clean stop");
+        Check(WaitFor(ran, std::chrono::seconds(2)), "scheduler runs tasks after a clean stop");
+        scheduler.Stop();
+    }
+
+    {
+        TaskScheduler scheduler;
+        std::atomic<bool> started(false);
+        std::atomic<bool> release(false);
+        std::atomic<bool> finished(false);
+        scheduler.Post("ignores its stop token", [&] {
+            started = true;
+            while (!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            finished = true;
+        });
+        Check(WaitFor(started, std::chrono::seconds(2)), "stuck task is running before the stop");
+
+        const auto stopped = Time([&] { scheduler.Stop(); });
+        Check(stopped >= kWorkerJoinTimeout - std::chrono::milliseconds(50) && stopped < kWorkerJoinTimeout * 2,
+              "stop gives up at the deadline after " + std::to_string(stopped.count()) + " ms");
+        Check(scheduler.Failed(), "scheduler is disabled after a failed stop");
+        Check(scheduler.After("refused", std::chrono::milliseconds(0), TaskMode::kInline, [] {}) == 0,
+              "scheduler refuses new tasks after a failed stop");
+
+        // The detached worker returns into the scheduler, so it has to finish before it goes away
+        release = true;
+        Check(WaitFor(finished, std::chrono::seconds(2)), "detached task finishes once released");
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+    return TestExitCode();
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Shared by the tests: every Check() prints one "ok" or "FAIL" line, and main() returns
+// TestExitCode() so ctest fails when any check did
+
+inline int g_testFailures = 0;
+
+inline void Check(bool condition, const std::string& what) {
+    std::cout << (condition ? "ok   " : "FAIL ") << what << std::endl;
+    if (!condition) g_testFailures++;
+}
+
+inline int TestExitCode() {
+    return g_testFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}